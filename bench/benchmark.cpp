@@ -0,0 +1,191 @@
+#include "benchmark.h"
+#include "../include/simd.h"
+#include <new>
+#include <ctime>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+struct Registration {
+    const char* name;
+    Benchmark::Function function;
+};
+
+// Replacement allocation functions: every global operator new is counted and forwarded to malloc. The array and
+// nothrow forms of the standard library forward to these, aligned ones keep the original pointer in front of the block.
+static std::atomic<size_t> heapAllocations{0};
+
+static void* CountedAllocate(size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size > 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+static void* CountedAllocateAligned(size_t size, std::align_val_t alignment) {
+    const size_t a = static_cast<size_t>(alignment) > sizeof(void*) ? static_cast<size_t>(alignment) : sizeof(void*);
+    unsigned char* raw = static_cast<unsigned char*>(CountedAllocate(size + a + sizeof(void*)));
+    const uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw + sizeof(void*)) + a - 1) & ~(uintptr_t(a) - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+static void FreeAligned(void* p) {
+    if (p != nullptr) std::free(static_cast<void**>(p)[-1]);
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+
+size_t Benchmark::HeapAllocations() {
+    return heapAllocations.load(std::memory_order_relaxed);
+}
+
+static std::vector<Registration>& Registry() {
+    static std::vector<Registration> registry;
+    return registry;
+}
+
+int Benchmark::Register(const char* name, Function function) {
+    Registry().push_back({ name, function });
+    return 0;
+}
+
+Benchmark::Result Benchmark::Run(const char* name, Function function, double minTime) {
+    size_t iterations = 1;
+    while (true) {
+        State state(iterations);
+        function(state);
+        const double seconds = state.Seconds();
+
+        if (seconds >= minTime || iterations >= (size_t(1) << 40)) {
+            const double perIteration = seconds / iterations;
+            return Result{
+                name,
+                iterations,
+                perIteration * 1e9,
+                state.itemsPerIteration / perIteration,
+                state.bytesPerIteration / perIteration,
+                state.counters
+            };
+        }
+
+        // Same growth policy as Google Benchmark: aim 40% past the target, grow at most 10x per step.
+        const double multiplier = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+        iterations = static_cast<size_t>(iterations * (multiplier < 10.0 ? multiplier : 10.0)) + 1;
+    }
+}
+
+static void WriteJson(std::ostream& out, const std::vector<Benchmark::Result>& results) {
+    const std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"simd\": \"" << SIMD::LevelToString(SIMD::Current()) << "\"\n";
+    out << "  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Benchmark::Result& r = results[i];
+        out << "    {\n";
+        out << "      \"name\": \"" << r.name << "\",\n";
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << std::setprecision(6) << std::fixed;
+        out << "      \"real_time\": " << r.nanosecondsPerIteration << ",\n";
+        out << "      \"time_unit\": \"ns\",\n";
+        out << "      \"items_per_second\": " << r.itemsPerSecond << ",\n";
+        out << "      \"bytes_per_second\": " << r.bytesPerSecond;
+        for (const auto& counter : r.counters) {
+            out << ",\n      \"" << counter.first << "\": " << counter.second;
+        }
+        out << "\n";
+        out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+static bool ParseLevel(const std::string& name, SIMD::Level& level) {
+    const SIMD::Level levels[] = { SIMD::Level::Scalar, SIMD::Level::SSE2, SIMD::Level::AVX2, SIMD::Level::FMA, SIMD::Level::AVX512 };
+    for (SIMD::Level candidate : levels) {
+        if (name == SIMD::LevelToString(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+int Benchmark::Main(int argc, char** argv) {
+    std::string filter, json;
+    double minTime = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--min_time=", 0) == 0) {
+            minTime = std::stod(arg.substr(11));
+        } else if (arg.rfind("--json=", 0) == 0) {
+            json = arg.substr(7);
+        } else if (arg.rfind("--simd=", 0) == 0) {
+            SIMD::Level level;
+            if (!ParseLevel(arg.substr(7), level)) {
+                std::cerr << "Invalid SIMD level: " << arg.substr(7) << ".\nValid options are: Scalar, SSE2, AVX2, FMA, AVX512." << std::endl;
+                return 1;
+            }
+            SIMD::SetLevel(level);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter=substring] [--min_time=seconds] [--simd=level] [--json=file]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "SIMD: " << SIMD::LevelToString(SIMD::Current()) << "\n" << std::endl;
+    std::cout << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(14) << "ns/op"
+              << std::setw(16) << "ops/s" << std::setw(16) << "MB/s" << std::setw(14) << "Iterations" << std::endl;
+
+    std::vector<Result> results;
+    for (const Registration& registration : Registry()) {
+        if (!filter.empty() && std::strstr(registration.name, filter.c_str()) == nullptr) continue;
+
+        const Result r = Run(registration.name, registration.function, minTime);
+        results.push_back(r);
+        std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(14) << r.nanosecondsPerIteration
+                  << std::setprecision(0) << std::setw(16) << r.itemsPerSecond
+                  << std::setprecision(1) << std::setw(16) << r.bytesPerSecond * 1e-6
+                  << std::setw(14) << r.iterations;
+        for (const auto& counter : r.counters) {
+            std::cout << "  " << counter.first << "=" << std::setprecision(3) << counter.second;
+        }
+        std::cout << std::endl;
+    }
+
+    if (!json.empty()) {
+        std::ofstream file(json);
+        if (!file) {
+            std::cerr << "Cannot open " << json << " for writing." << std::endl;
+            return 1;
+        }
+        WriteJson(file, results);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    return Benchmark::Main(argc, argv);
+}
@@ -0,0 +1,129 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Minimal Google-Benchmark style harness: no external dependency, same loop idiom and JSON layout.
+class Benchmark {
+public:
+    class State {
+    public:
+        // Loop variable of `for (auto _ : state)`, the attribute keeps unused-variable warnings away from it.
+        struct [[maybe_unused]] Value {};
+
+        struct Iterator {
+            State* state;
+            size_t remaining;
+            bool operator!=(const Iterator&) {
+                if (remaining != 0) return true;
+                if (state != nullptr) state->Finish();
+                return false;
+            }
+            void operator++() { remaining--; }
+            Value operator*() const { return Value{}; }
+        };
+
+    public:
+        explicit State(size_t iterations): iterations(iterations) {}
+
+        // Only the loop is timed, the setup before it and the counters after it are not.
+        Iterator begin() {
+            heapAllocations = Benchmark::HeapAllocations();
+            start = std::chrono::steady_clock::now();
+            return Iterator{ this, iterations };
+        }
+
+        Iterator end() const { return Iterator{ nullptr, 0 }; }
+
+        size_t Iterations() const { return iterations; }
+
+        // Global operator new calls made by all iterations of the loop, valid after the loop.
+        size_t HeapAllocations() const { return heapAllocations; }
+
+        // Wall time of all iterations of the loop, valid after the loop.
+        double Seconds() const { return seconds; }
+
+        void SetBytesPerIteration(size_t bytes) { bytesPerIteration = bytes; }
+
+        void SetItemsPerIteration(size_t items) { itemsPerIteration = items; }
+
+    public:
+        size_t iterations;
+        size_t bytesPerIteration = 0;
+        size_t itemsPerIteration = 1;
+        // User counters such as cache miss ratios, printed after the timings and stored as fields in the JSON output.
+        std::map<std::string, double> counters;
+
+    private:
+        void Finish() {
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            heapAllocations = Benchmark::HeapAllocations() - heapAllocations;
+        }
+
+    private:
+        size_t heapAllocations = 0;
+        std::chrono::steady_clock::time_point start;
+        double seconds = 0.0;
+    };
+
+    using Function = void (*)(State&);
+
+    struct Result {
+        std::string name;
+        size_t iterations;
+        double nanosecondsPerIteration;
+        double itemsPerSecond;
+        double bytesPerSecond;
+        std::map<std::string, double> counters;
+    };
+
+public:
+    /**
+     * @brief Adds benchmark to the global list. Used through the BENCHMARK macro.
+    */
+    static int Register(const char* name, Function function);
+
+public:
+    /**
+     * @brief Parses --filter=, --min_time=, --simd=, --json= options and runs the matching benchmarks.
+     *
+     * @return Process exit code.
+    */
+    static int Main(int argc, char** argv);
+
+public:
+    /**
+     * @brief Amount of global operator new calls since program start, from all threads. The benchmark executable
+     * replaces the global allocation functions to count them.
+    */
+    static size_t HeapAllocations();
+
+public:
+    /**
+     * @brief Prevents the compiler from discarding value or assuming it is unchanged.
+    */
+    template <class T>
+    static inline void DoNotOptimize(T& value) {
+#if defined(__GNUC__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        volatile char sink = *reinterpret_cast<volatile const char*>(&value);
+        (void)sink;
+#endif
+    }
+
+private:
+    static Result Run(const char* name, Function function, double minTime);
+};
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+#define BENCHMARK(function) \
+    static int BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = Benchmark::Register(#function, function)
+
+#endif
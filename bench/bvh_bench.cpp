@@ -0,0 +1,113 @@
+#include "benchmark.h"
+#include "../include/bvh.h"
+#include "../include/vector4.h"
+#include "../include/threadpool.h"
+#include "../include/vector4stream.h"
+#include <vector>
+#include <cmath>
+
+// Rolling terrain of 1024 x 512 quads (about one million triangles), rays are cast down onto it like picking from above.
+struct Terrain {
+    std::vector<Vector3> vertices;
+    std::vector<uint32_t> indices;
+    size_t triangleCount;
+
+    Terrain(size_t width = 1024, size_t depth = 512) {
+        for (size_t z = 0; z <= depth; z++) {
+            for (size_t x = 0; x <= width; x++) {
+                vertices.push_back(Vector3(float(x), 4 * std::sin(0.05f * x) * std::cos(0.07f * z), float(z)));
+            }
+        }
+        for (size_t z = 0; z < depth; z++) {
+            for (size_t x = 0; x < width; x++) {
+                const uint32_t i = static_cast<uint32_t>(z * (width + 1) + x), j = i + static_cast<uint32_t>(width + 1);
+                indices.insert(indices.end(), { i, j, i + 1, i + 1, j, j + 1 });
+            }
+        }
+        triangleCount = indices.size() / 3;
+    }
+};
+
+static ThreadPool& Pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+static const size_t rayCount = 65536;
+
+static void FillRays(Vector4Stream& origins, Vector4Stream& directions) {
+    uint32_t seed = 7;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+    for (size_t i = 0; i < origins.count; i++) {
+        origins.Set(i, Vector4(1024 * next(), 20, 512 * next(), std::numeric_limits<float>::infinity()));
+        directions.Set(i, Vector4(next() - 0.5f, -1, next() - 0.5f, 0));
+    }
+}
+
+static void BM_BVH_Build(Benchmark::State& state) {
+    const Terrain terrain;
+    BVH bvh(Pool());
+    for (auto _ : state) {
+        bvh.Build(terrain.vertices.data(), terrain.vertices.size(), terrain.indices.data(), terrain.triangleCount);
+        Benchmark::DoNotOptimize(bvh);
+    }
+    state.SetItemsPerIteration(terrain.triangleCount);
+    state.SetBytesPerIteration(terrain.triangleCount * 3 * (sizeof(Vector3) + sizeof(uint32_t)));
+}
+BENCHMARK(BM_BVH_Build);
+
+static void BM_BVH_Intersect(Benchmark::State& state) {
+    const Terrain terrain;
+    BVH bvh(Pool());
+    bvh.Build(terrain.vertices.data(), terrain.vertices.size(), terrain.indices.data(), terrain.triangleCount);
+    Vector4Stream origins(rayCount), directions(rayCount);
+    FillRays(origins, directions);
+    size_t hits = 0;
+    for (auto _ : state) {
+        hits = 0;
+        BVH::Hit hit;
+        for (size_t i = 0; i < rayCount; i++) {
+            hits += bvh.Intersect(Vector3(origins.x[i], origins.y[i], origins.z[i]),
+                                  Vector3(directions.x[i], directions.y[i], directions.z[i]), hit);
+        }
+        Benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsPerIteration(rayCount);
+}
+BENCHMARK(BM_BVH_Intersect);
+
+static void BM_BVH_Occluded(Benchmark::State& state) {
+    const Terrain terrain;
+    BVH bvh(Pool());
+    bvh.Build(terrain.vertices.data(), terrain.vertices.size(), terrain.indices.data(), terrain.triangleCount);
+    Vector4Stream origins(rayCount), directions(rayCount);
+    FillRays(origins, directions);
+    size_t occluded = 0;
+    for (auto _ : state) {
+        occluded = 0;
+        for (size_t i = 0; i < rayCount; i++) {
+            occluded += bvh.Occluded(Vector3(origins.x[i], origins.y[i], origins.z[i]),
+                                     Vector3(directions.x[i], directions.y[i], directions.z[i]));
+        }
+        Benchmark::DoNotOptimize(occluded);
+    }
+    state.SetItemsPerIteration(rayCount);
+}
+BENCHMARK(BM_BVH_Occluded);
+
+static void BM_BVH_IntersectStream(Benchmark::State& state) {
+    const Terrain terrain;
+    BVH bvh(Pool());
+    bvh.Build(terrain.vertices.data(), terrain.vertices.size(), terrain.indices.data(), terrain.triangleCount);
+    Vector4Stream origins(rayCount), directions(rayCount);
+    FillRays(origins, directions);
+    std::vector<BVH::Hit> hits(rayCount);
+    size_t count = 0;
+    for (auto _ : state) {
+        count = bvh.IntersectStream(origins, directions, hits.data());
+        Benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsPerIteration(rayCount);
+    state.SetBytesPerIteration(rayCount * (2 * sizeof(Vector4) + sizeof(BVH::Hit)));
+}
+BENCHMARK(BM_BVH_IntersectStream);
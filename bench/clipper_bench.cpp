@@ -0,0 +1,72 @@
+#include "benchmark.h"
+#include "../include/clipper.h"
+#include "../include/matrix4.h"
+#include "../include/vector4.h"
+#include "../include/projection.h"
+#include "../include/vector4stream.h"
+#include <vector>
+#include <cmath>
+
+// Camera standing in the middle of a 256 x 256 quad terrain (131072 triangles) and looking along it: triangles behind
+// and beyond the far plane are rejected, the ones around the feet of the camera cross the near plane.
+struct ClipScene {
+    static constexpr int width = 1280, height = 720;
+
+    Vector4Stream clip;
+    std::vector<uint32_t> indices;
+    size_t triangleCount;
+
+    ClipScene(size_t size = 256) {
+        const Matrix4 projection = Projection::Perspective(1.0f, float(width) / height, 0.5f, 100.0f);
+        const Matrix4 view(
+            1, 0, 0, -0.5f * size,
+            0, 1, 0, -1.5f,
+            0, 0, 1, -0.5f * size,
+            0, 0, 0, 1
+        );
+        const Matrix4 viewProjection = projection.MultiplyMatrix(view);
+        clip = Vector4Stream((size + 1) * (size + 1));
+        for (size_t z = 0; z <= size; z++) {
+            for (size_t x = 0; x <= size; x++) {
+                const Vector4 v(float(x), std::sin(0.3f * x) * std::cos(0.2f * z), float(z), 1.0f);
+                clip.Set(z * (size + 1) + x, viewProjection.MultiplyVector(v));
+            }
+        }
+        for (size_t z = 0; z < size; z++) {
+            for (size_t x = 0; x < size; x++) {
+                const uint32_t i = static_cast<uint32_t>(z * (size + 1) + x), j = i + static_cast<uint32_t>(size + 1);
+                indices.insert(indices.end(), { i, j, i + 1, i + 1, j, j + 1 });
+            }
+        }
+        triangleCount = indices.size() / 3;
+    }
+};
+
+static void BM_Clipper_Process(Benchmark::State& state) {
+    const ClipScene scene;
+    Clipper clipper(0, 0, ClipScene::width, ClipScene::height);
+    size_t emitted = 0;
+    for (auto _ : state) {
+        emitted = clipper.Process(scene.clip, scene.indices.data(), scene.triangleCount);
+        Benchmark::DoNotOptimize(emitted);
+    }
+    state.SetItemsPerIteration(scene.triangleCount);
+    state.SetBytesPerIteration(scene.clip.count * (sizeof(Vector4) + sizeof(Vector4)) + scene.indices.size() * sizeof(uint32_t));
+}
+BENCHMARK(BM_Clipper_Process);
+
+// Per-vertex divide and viewport mapping without outcodes, the floor of Process.
+static void BM_Clipper_Map(Benchmark::State& state) {
+    const ClipScene scene;
+    const Clipper clipper(0, 0, ClipScene::width, ClipScene::height);
+    std::vector<Vector4> screen(scene.clip.count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < scene.clip.count; i++) {
+            screen[i] = clipper.Map(Vector4(scene.clip.x[i], scene.clip.y[i], scene.clip.z[i], scene.clip.w[i]));
+        }
+        Benchmark::DoNotOptimize(screen);
+    }
+    state.SetItemsPerIteration(scene.clip.count);
+    state.SetBytesPerIteration(scene.clip.count * 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Clipper_Map);
@@ -0,0 +1,76 @@
+#include "benchmark.h"
+#include "../include/vector4.h"
+#include "../include/matrix4.h"
+#include "../include/frustum.h"
+#include "../include/vector4stream.h"
+#include <vector>
+
+// 90 degree perspective looking down -z, volumes scattered around it so that about half are visible.
+static Frustum SampleFrustum() {
+    const float near = 1.0f, far = 100.0f;
+    return Frustum(Matrix4(
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, -(far + near) / (far - near), -2 * far * near / (far - near),
+        0, 0, -1, 0
+    ));
+}
+
+static const size_t volumeCount = 100000;
+
+static void FillVolumes(Vector4Stream& centers, Vector4Stream& extents) {
+    uint32_t seed = 12345;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+    for (size_t i = 0; i < centers.count; i++) {
+        centers.Set(i, Vector4(120 * next() - 60, 120 * next() - 60, 120 * next() - 110, 3 * next()));
+        extents.Set(i, Vector4(3 * next(), 3 * next(), 3 * next()));
+    }
+}
+
+static void BM_Frustum_CullSpheres(Benchmark::State& state) {
+    const Frustum frustum = SampleFrustum();
+    Vector4Stream spheres(volumeCount), extents(volumeCount);
+    FillVolumes(spheres, extents);
+    std::vector<uint32_t> visible(volumeCount);
+    size_t count = 0;
+    for (auto _ : state) {
+        count = frustum.CullSpheres(spheres, visible.data());
+        Benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsPerIteration(volumeCount);
+    state.SetBytesPerIteration(volumeCount * sizeof(Vector4) + count * sizeof(uint32_t));
+}
+BENCHMARK(BM_Frustum_CullSpheres);
+
+static void BM_Frustum_CullBoxes(Benchmark::State& state) {
+    const Frustum frustum = SampleFrustum();
+    Vector4Stream centers(volumeCount), extents(volumeCount);
+    FillVolumes(centers, extents);
+    std::vector<uint32_t> visible(volumeCount);
+    size_t count = 0;
+    for (auto _ : state) {
+        count = frustum.CullBoxes(centers, extents, visible.data());
+        Benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsPerIteration(volumeCount);
+    state.SetBytesPerIteration(volumeCount * 2 * sizeof(Vector4) + count * sizeof(uint32_t));
+}
+BENCHMARK(BM_Frustum_CullBoxes);
+
+static void BM_Frustum_TestBox(Benchmark::State& state) {
+    const Frustum frustum = SampleFrustum();
+    Vector4Stream centers(volumeCount), extents(volumeCount);
+    FillVolumes(centers, extents);
+    size_t count = 0;
+    for (auto _ : state) {
+        count = 0;
+        for (size_t i = 0; i < volumeCount; i++) {
+            uint8_t planeMask = Frustum::allPlanes;
+            count += frustum.TestBox(centers.Get(i), extents.Get(i), planeMask) != Frustum::Result::Outside;
+        }
+        Benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsPerIteration(volumeCount);
+    state.SetBytesPerIteration(volumeCount * 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Frustum_TestBox);
@@ -0,0 +1,49 @@
+#include "benchmark.h"
+#include "../include/transformhierarchy.h"
+
+// 500k nodes, branching factor 4, a few percent of them move every frame.
+static TransformHierarchy& SampleHierarchy() {
+    static TransformHierarchy hierarchy;
+    if (hierarchy.Size() == 0) {
+        hierarchy.AddNode();
+        for (uint32_t i = 1; i < 500000; i++) {
+            hierarchy.AddNode((i - 1) / 4, Vector4(0.1f, 0.0f, 0.0f), Quaternion::FromAngleAxis(0.01f, Vector4(0.0f, 0.0f, 1.0f)));
+        }
+        hierarchy.Update();
+    }
+    return hierarchy;
+}
+
+static void RunHierarchyUpdate(Benchmark::State& state, uint32_t stride) {
+    TransformHierarchy& hierarchy = SampleHierarchy();
+    const uint32_t nodes = static_cast<uint32_t>(hierarchy.Size());
+    float offset = 0.0f;
+    size_t updated = 0;
+    for (auto _ : state) {
+        offset += 0.001f;
+        // Leaves and near-leaf nodes, the typical moving set.
+        for (uint32_t node = nodes / 2; node < nodes; node += stride) {
+            hierarchy.SetTranslation(node, Vector4(offset, 0.0f, 0.0f));
+        }
+        updated = hierarchy.Update();
+        Benchmark::DoNotOptimize(updated);
+    }
+    state.SetItemsPerIteration(updated);
+    state.SetBytesPerIteration(updated * sizeof(Matrix4));
+}
+
+static void BM_TransformHierarchy_Update_2Percent(Benchmark::State& state) { RunHierarchyUpdate(state, 25); }
+BENCHMARK(BM_TransformHierarchy_Update_2Percent);
+
+static void BM_TransformHierarchy_Update_All(Benchmark::State& state) {
+    TransformHierarchy& hierarchy = SampleHierarchy();
+    size_t updated = 0;
+    for (auto _ : state) {
+        hierarchy.SetTranslation(0, Vector4());
+        updated = hierarchy.Update();
+        Benchmark::DoNotOptimize(updated);
+    }
+    state.SetItemsPerIteration(updated);
+    state.SetBytesPerIteration(updated * sizeof(Matrix4));
+}
+BENCHMARK(BM_TransformHierarchy_Update_All);
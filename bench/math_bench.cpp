@@ -0,0 +1,555 @@
+#include "benchmark.h"
+#include "../include/euler.h"
+#include "../include/eulerangles.h"
+#include "../include/vector3.h"
+#include "../include/vector4.h"
+#include "../include/vector4stream.h"
+#include "../include/matrix4.h"
+#include "../include/quaternion.h"
+#include "../include/quaternionstream.h"
+#include "../include/affine3x4.h"
+#include "../include/interpolation.h"
+#include "../include/framearena.h"
+#include "../include/mat.h"
+#include "../include/fixed.h"
+#include <vector>
+#include <cmath>
+
+static Matrix4 SampleMatrix() {
+    return Matrix4(
+        0.36f, 0.48f,-0.80f, 1.5f,
+       -0.80f, 0.60f, 0.00f,-2.0f,
+        0.48f, 0.64f, 0.60f, 0.5f,
+        0.00f, 0.00f, 0.00f, 1.0f
+    );
+}
+
+static void BM_Matrix4_MultiplyMatrix(Benchmark::State& state) {
+    Matrix4 a = SampleMatrix(), b = SampleMatrix().Transpose();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(a);
+        Matrix4 r = a.MultiplyMatrix(b);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(Matrix4));
+}
+BENCHMARK(BM_Matrix4_MultiplyMatrix);
+
+template <typename T>
+static void RunMatMultiplyMatrix(Benchmark::State& state) {
+    const Matrix4 sample = SampleMatrix();
+    const float* elements = &sample.m11;
+    Mat<T, 4, 4> a = Mat<float, 4, 4>::Generate([&](size_t r, size_t c) { return elements[4 * r + c]; }).template Cast<T>();
+    Mat<T, 4, 4> b = a.Transpose();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(a);
+        Mat<T, 4, 4> r = a.MultiplyMatrix(b);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(Mat<T, 4, 4>));
+}
+
+static void BM_Mat4f_MultiplyMatrix(Benchmark::State& state) { RunMatMultiplyMatrix<float>(state); }
+BENCHMARK(BM_Mat4f_MultiplyMatrix);
+static void BM_Mat4d_MultiplyMatrix(Benchmark::State& state) { RunMatMultiplyMatrix<double>(state); }
+BENCHMARK(BM_Mat4d_MultiplyMatrix);
+static void BM_Mat4Fixed16_MultiplyMatrix(Benchmark::State& state) { RunMatMultiplyMatrix<Fixed16>(state); }
+BENCHMARK(BM_Mat4Fixed16_MultiplyMatrix);
+
+static void BM_Matrix4_MultiplyVector(Benchmark::State& state) {
+    Matrix4 m = SampleMatrix();
+    Vector4 v(1.0f, 2.0f, 3.0f, 1.0f);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(v);
+        Vector4 r = m.MultiplyVector(v);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(sizeof(Matrix4) + 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Matrix4_MultiplyVector);
+
+static void BM_Matrix4_Inverse(Benchmark::State& state) {
+    Matrix4 m = SampleMatrix();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        std::optional<Matrix4> r = m.Inverse();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(2 * sizeof(Matrix4));
+}
+BENCHMARK(BM_Matrix4_Inverse);
+
+static void BM_Matrix4_Determinant(Benchmark::State& state) {
+    Matrix4 m = SampleMatrix();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        float r = m.Determinant();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(sizeof(Matrix4) + sizeof(float));
+}
+BENCHMARK(BM_Matrix4_Determinant);
+
+static void RunMatrix4Degree(Benchmark::State& state, const Matrix4& sample, int degree) {
+    Matrix4 m = sample;
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        Matrix4 r = m.Degree(degree);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(2 * sizeof(Matrix4));
+}
+
+static void BM_Matrix4_Degree_8(Benchmark::State& state) { RunMatrix4Degree(state, SampleMatrix(), 8); }
+BENCHMARK(BM_Matrix4_Degree_8);
+
+static void BM_Matrix4_Degree_1000(Benchmark::State& state) { RunMatrix4Degree(state, SampleMatrix(), 1000); }
+BENCHMARK(BM_Matrix4_Degree_1000);
+
+static void BM_Matrix4_Degree_1000_NonRigid(Benchmark::State& state) { RunMatrix4Degree(state, SampleMatrix().Scale(0.5f), 1000); }
+BENCHMARK(BM_Matrix4_Degree_1000_NonRigid);
+
+static void BM_Quaternion_Multiply(Benchmark::State& state) {
+    Quaternion a = Quaternion(0.5f, 0.5f, 0.5f, 0.5f), b = Quaternion(0.8f, 0.0f, 0.6f, 0.0f);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(a);
+        Quaternion r = a.Multiply(b);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(Quaternion));
+}
+BENCHMARK(BM_Quaternion_Multiply);
+
+static void BM_Quaternion_Slerp(Benchmark::State& state) {
+    Quaternion a = Quaternion(0.5f, 0.5f, 0.5f, 0.5f);
+    const Quaternion b = Quaternion(0.8f, 0.0f, 0.6f, 0.0f);
+    float t = 0.3f;
+    for (auto _ : state) {
+        Quaternion q = b;
+        Benchmark::DoNotOptimize(a);
+        Benchmark::DoNotOptimize(t);
+        Quaternion r = a.Slerp(q, t);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(Quaternion) + sizeof(float));
+}
+BENCHMARK(BM_Quaternion_Slerp);
+
+static const size_t quaternionStreamSize = 4096;
+
+static void FillQuaternionStream(QuaternionStream& stream, float seed) {
+    for (size_t i = 0; i < stream.count; i++) {
+        const float angle = seed + 0.001f * i;
+        stream.Set(i, Quaternion(std::cos(angle), std::sin(angle) * 0.6f, std::sin(angle) * 0.8f, 0.0f));
+    }
+}
+
+static void BM_Quaternion_SlerpLoop(Benchmark::State& state) {
+    QuaternionStream a(quaternionStreamSize), b(quaternionStreamSize), out(quaternionStreamSize);
+    FillQuaternionStream(a, 0.1f);
+    FillQuaternionStream(b, 2.0f);
+    std::vector<float> t(quaternionStreamSize, 0.3f);
+    for (auto _ : state) {
+        for (size_t i = 0; i < quaternionStreamSize; i++) {
+            out.Set(i, a.Get(i).Slerp(b.Get(i), t[i]));
+        }
+        Benchmark::DoNotOptimize(out.w);
+    }
+    state.SetItemsPerIteration(quaternionStreamSize);
+    state.SetBytesPerIteration(quaternionStreamSize * (12 * sizeof(float) + sizeof(float)));
+}
+BENCHMARK(BM_Quaternion_SlerpLoop);
+
+static void RunQuaternionStream(Benchmark::State& state, int mode) {
+    QuaternionStream a(quaternionStreamSize), b(quaternionStreamSize), out(quaternionStreamSize);
+    FillQuaternionStream(a, 0.1f);
+    FillQuaternionStream(b, 2.0f);
+    std::vector<float> t(quaternionStreamSize, 0.3f);
+    for (auto _ : state) {
+        if (mode == 0) Quaternion::SlerpStream(a, b, t.data(), out, quaternionStreamSize, Quaternion::Precision::Exact);
+        if (mode == 1) Quaternion::SlerpStream(a, b, t.data(), out, quaternionStreamSize, Quaternion::Precision::Polynomial);
+        if (mode == 2) Quaternion::NlerpStream(a, b, t.data(), out, quaternionStreamSize);
+        Benchmark::DoNotOptimize(out.w);
+    }
+    state.SetItemsPerIteration(quaternionStreamSize);
+    state.SetBytesPerIteration(quaternionStreamSize * (12 * sizeof(float) + sizeof(float)));
+}
+
+static void BM_Quaternion_SlerpStream_Exact(Benchmark::State& state) { RunQuaternionStream(state, 0); }
+BENCHMARK(BM_Quaternion_SlerpStream_Exact);
+static void BM_Quaternion_SlerpStream_Polynomial(Benchmark::State& state) { RunQuaternionStream(state, 1); }
+BENCHMARK(BM_Quaternion_SlerpStream_Polynomial);
+static void BM_Quaternion_NlerpStream(Benchmark::State& state) { RunQuaternionStream(state, 2); }
+BENCHMARK(BM_Quaternion_NlerpStream);
+
+static void BM_Quaternion_ApplyToVector(Benchmark::State& state) {
+    Quaternion q = Quaternion(0.5f, 0.5f, 0.5f, 0.5f);
+    Vector4 v(1.0f, 2.0f, 3.0f, 0.0f);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(v);
+        Vector4 r = q.ApplyToVector(v);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(sizeof(Quaternion) + 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Quaternion_ApplyToVector);
+
+static void BM_Quaternion_RotateVector(Benchmark::State& state) {
+    Quaternion q = Quaternion(0.5f, 0.5f, 0.5f, 0.5f);
+    Vector4 v(1.0f, 2.0f, 3.0f, 0.0f);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(v);
+        Vector4 r = q.RotateVector(v);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(sizeof(Quaternion) + 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Quaternion_RotateVector);
+
+static const size_t rotateCount = 4096;
+
+static void BM_Quaternion_RotateVectors_Vector4(Benchmark::State& state) {
+    const Quaternion q = Quaternion(0.8f, 0.0f, 0.6f, 0.0f);
+    std::vector<Vector4> in(rotateCount, Vector4(1.0f, 2.0f, 3.0f, 1.0f)), out(rotateCount);
+    for (auto _ : state) {
+        q.RotateVectors(in.data(), out.data(), rotateCount);
+        Benchmark::DoNotOptimize(out[0]);
+    }
+    state.SetItemsPerIteration(rotateCount);
+    state.SetBytesPerIteration(rotateCount * 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Quaternion_RotateVectors_Vector4);
+
+static void BM_Quaternion_RotateVectors_Vector3(Benchmark::State& state) {
+    const Quaternion q = Quaternion(0.8f, 0.0f, 0.6f, 0.0f);
+    std::vector<Vector3> in(rotateCount, Vector3(1.0f, 2.0f, 3.0f)), out(rotateCount);
+    for (auto _ : state) {
+        q.RotateVectors(in.data(), out.data(), rotateCount);
+        Benchmark::DoNotOptimize(out[0]);
+    }
+    state.SetItemsPerIteration(rotateCount);
+    state.SetBytesPerIteration(rotateCount * 2 * sizeof(Vector3));
+}
+BENCHMARK(BM_Quaternion_RotateVectors_Vector3);
+
+static void BM_Quaternion_RotateStream(Benchmark::State& state) {
+    const Quaternion q = Quaternion(0.8f, 0.0f, 0.6f, 0.0f);
+    Vector4Stream in(rotateCount), out(rotateCount);
+    for (size_t i = 0; i < rotateCount; i++) in.Set(i, Vector4(1.0f, 2.0f, 3.0f, 1.0f));
+    for (auto _ : state) {
+        q.RotateStream(in, out, rotateCount);
+        Benchmark::DoNotOptimize(out.x);
+    }
+    state.SetItemsPerIteration(rotateCount);
+    state.SetBytesPerIteration(rotateCount * 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_Quaternion_RotateStream);
+
+static void RunEulerRotateXYZ(Benchmark::State& state, const std::string& order) {
+    Euler euler = Euler(0.3f, -0.7f, 1.1f, order);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(euler);
+        Matrix4 r = euler.RotateXYZ();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(float) + sizeof(Matrix4));
+}
+
+static void BM_Euler_RotateXYZ_XYZ(Benchmark::State& state) { RunEulerRotateXYZ(state, "XYZ"); }
+BENCHMARK(BM_Euler_RotateXYZ_XYZ);
+
+static void BM_Euler_RotateXYZ_XZY(Benchmark::State& state) { RunEulerRotateXYZ(state, "XZY"); }
+BENCHMARK(BM_Euler_RotateXYZ_XZY);
+
+static void BM_Euler_RotateXYZ_YXZ(Benchmark::State& state) { RunEulerRotateXYZ(state, "YXZ"); }
+BENCHMARK(BM_Euler_RotateXYZ_YXZ);
+
+static void BM_Euler_RotateXYZ_YZX(Benchmark::State& state) { RunEulerRotateXYZ(state, "YZX"); }
+BENCHMARK(BM_Euler_RotateXYZ_YZX);
+
+static void BM_Euler_RotateXYZ_ZXY(Benchmark::State& state) { RunEulerRotateXYZ(state, "ZXY"); }
+BENCHMARK(BM_Euler_RotateXYZ_ZXY);
+
+static void BM_Euler_RotateXYZ_ZYX(Benchmark::State& state) { RunEulerRotateXYZ(state, "ZYX"); }
+BENCHMARK(BM_Euler_RotateXYZ_ZYX);
+
+static void BM_EulerAngles_ToMatrix_ZXY(Benchmark::State& state) {
+    EulerZXY euler(0.3f, -0.7f, 1.1f);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(euler);
+        Matrix4 r = euler.ToMatrix();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(float) + sizeof(Matrix4));
+}
+BENCHMARK(BM_EulerAngles_ToMatrix_ZXY);
+
+static void BM_Euler_Decompose_ZXY(Benchmark::State& state) {
+    Matrix4 m = Euler(0.3f, -0.7f, 1.1f, Euler::Order::ZXY).RotateXYZ();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        Euler e = Euler::Decompose(m, Euler::Order::ZXY);
+        Benchmark::DoNotOptimize(e);
+    }
+    state.SetBytesPerIteration(sizeof(Matrix4) + 3 * sizeof(float));
+}
+BENCHMARK(BM_Euler_Decompose_ZXY);
+
+static void BM_EulerAngles_FromMatrix_ZXY(Benchmark::State& state) {
+    Matrix4 m = EulerZXY(0.3f, -0.7f, 1.1f).ToMatrix();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        EulerZXY e = EulerZXY::FromMatrix(m);
+        Benchmark::DoNotOptimize(e);
+    }
+    state.SetBytesPerIteration(sizeof(Matrix4) + 3 * sizeof(float));
+}
+BENCHMARK(BM_EulerAngles_FromMatrix_ZXY);
+
+static void BM_Euler_ToQuaternion(Benchmark::State& state) {
+    Euler euler(0.3f, -0.7f, 1.1f, Euler::Order::ZXY);
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(euler);
+        Quaternion q = euler.ToQuaternion();
+        Benchmark::DoNotOptimize(q);
+    }
+    state.SetBytesPerIteration(3 * sizeof(float) + sizeof(Quaternion));
+}
+BENCHMARK(BM_Euler_ToQuaternion);
+
+static void BM_Euler_FromQuaternion(Benchmark::State& state) {
+    Quaternion q = Euler(0.3f, -0.7f, 1.1f, Euler::Order::ZXY).ToQuaternion();
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(q);
+        Euler e = Euler::FromQuaternion(q, Euler::Order::ZXY);
+        Benchmark::DoNotOptimize(e);
+    }
+    state.SetBytesPerIteration(sizeof(Quaternion) + 3 * sizeof(float));
+}
+BENCHMARK(BM_Euler_FromQuaternion);
+
+// Animation track of Euler keys in SoA arrays, converted per key (RotateXYZ) and per batch.
+static const size_t eulerTrackSize = 4096;
+
+static void FillEulerTrack(std::vector<float>& alpha, std::vector<float>& beta, std::vector<float>& gamma) {
+    for (size_t i = 0; i < eulerTrackSize; i++) {
+        alpha[i] = 0.001f * i;
+        beta[i] = -0.7f + 0.0005f * i;
+        gamma[i] = 1.1f - 0.002f * i;
+    }
+}
+
+static void BM_Euler_RotateXYZ_Track(Benchmark::State& state) {
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    FillEulerTrack(alpha, beta, gamma);
+    std::vector<Matrix4> out(eulerTrackSize);
+    for (auto _ : state) {
+        for (size_t i = 0; i < eulerTrackSize; i++) {
+            out[i] = Euler(alpha[i], beta[i], gamma[i], "ZXY").RotateXYZ();
+        }
+        Benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (3 * sizeof(float) + sizeof(Matrix4)));
+}
+BENCHMARK(BM_Euler_RotateXYZ_Track);
+
+static void BM_Euler_ToMatrices(Benchmark::State& state) {
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    FillEulerTrack(alpha, beta, gamma);
+    std::vector<Matrix4> out(eulerTrackSize);
+    for (auto _ : state) {
+        Euler::ToMatrices(alpha.data(), beta.data(), gamma.data(), Euler::Order::ZXY, out.data(), eulerTrackSize);
+        Benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (3 * sizeof(float) + sizeof(Matrix4)));
+}
+BENCHMARK(BM_Euler_ToMatrices);
+
+static void BM_Euler_ToQuaternions(Benchmark::State& state) {
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    FillEulerTrack(alpha, beta, gamma);
+    std::vector<Quaternion> out(eulerTrackSize);
+    for (auto _ : state) {
+        Euler::ToQuaternions(alpha.data(), beta.data(), gamma.data(), Euler::Order::ZXY, out.data(), eulerTrackSize);
+        Benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (3 * sizeof(float) + sizeof(Quaternion)));
+}
+BENCHMARK(BM_Euler_ToQuaternions);
+
+static void BM_Euler_ToQuaternions_Stream(Benchmark::State& state) {
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    FillEulerTrack(alpha, beta, gamma);
+    QuaternionStream out(eulerTrackSize);
+    for (auto _ : state) {
+        Euler::ToQuaternions(alpha.data(), beta.data(), gamma.data(), Euler::Order::ZXY, out, eulerTrackSize);
+        Benchmark::DoNotOptimize(out.w);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (3 * sizeof(float) + sizeof(Quaternion)));
+}
+BENCHMARK(BM_Euler_ToQuaternions_Stream);
+
+static void FillQuaternionTrack(std::vector<Quaternion>& q) {
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    FillEulerTrack(alpha, beta, gamma);
+    Euler::ToQuaternions(alpha.data(), beta.data(), gamma.data(), Euler::Order::ZXY, q.data(), eulerTrackSize);
+}
+
+static void BM_Euler_FromQuaternion_Track(Benchmark::State& state) {
+    std::vector<Quaternion> q(eulerTrackSize);
+    FillQuaternionTrack(q);
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    for (auto _ : state) {
+        for (size_t i = 0; i < eulerTrackSize; i++) {
+            const Euler e = Euler::FromQuaternion(q[i], Euler::Order::ZXY);
+            alpha[i] = e.alpha, beta[i] = e.beta, gamma[i] = e.gamma;
+        }
+        Benchmark::DoNotOptimize(alpha);
+        Benchmark::DoNotOptimize(beta);
+        Benchmark::DoNotOptimize(gamma);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (sizeof(Quaternion) + 3 * sizeof(float)));
+}
+BENCHMARK(BM_Euler_FromQuaternion_Track);
+
+static void BM_Euler_FromQuaternions(Benchmark::State& state) {
+    std::vector<Quaternion> q(eulerTrackSize);
+    FillQuaternionTrack(q);
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    for (auto _ : state) {
+        Euler::FromQuaternions(q.data(), Euler::Order::ZXY, alpha.data(), beta.data(), gamma.data(), eulerTrackSize);
+        Benchmark::DoNotOptimize(alpha);
+        Benchmark::DoNotOptimize(beta);
+        Benchmark::DoNotOptimize(gamma);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (sizeof(Quaternion) + 3 * sizeof(float)));
+}
+BENCHMARK(BM_Euler_FromQuaternions);
+
+static void BM_Euler_FromQuaternions_Stream(Benchmark::State& state) {
+    std::vector<Quaternion> q(eulerTrackSize);
+    FillQuaternionTrack(q);
+    QuaternionStream stream(eulerTrackSize);
+    for (size_t i = 0; i < eulerTrackSize; i++) {
+        stream.w[i] = q[i].w, stream.x[i] = q[i].x, stream.y[i] = q[i].y, stream.z[i] = q[i].z;
+    }
+    std::vector<float> alpha(eulerTrackSize), beta(eulerTrackSize), gamma(eulerTrackSize);
+    for (auto _ : state) {
+        Euler::FromQuaternions(stream, Euler::Order::ZXY, alpha.data(), beta.data(), gamma.data(), eulerTrackSize);
+        Benchmark::DoNotOptimize(alpha);
+        Benchmark::DoNotOptimize(beta);
+        Benchmark::DoNotOptimize(gamma);
+    }
+    state.SetItemsPerIteration(eulerTrackSize);
+    state.SetBytesPerIteration(eulerTrackSize * (sizeof(Quaternion) + 3 * sizeof(float)));
+}
+BENCHMARK(BM_Euler_FromQuaternions_Stream);
+
+static void BM_Interpolation_Linear(Benchmark::State& state) {
+    float xB = 256.0f;
+    size_t produced = 0;
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(xB);
+        std::vector<float> r = Interpolation::Linear(0.0f, 10.0f, xB, 90.0f, 1.0f);
+        produced = r.size();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(produced * sizeof(float));
+}
+BENCHMARK(BM_Interpolation_Linear);
+
+static void BM_Interpolation_LinearBuffer(Benchmark::State& state) {
+    float xB = 256.0f;
+    float buffer[512];
+    size_t produced = 0;
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(xB);
+        produced = Interpolation::Linear(0.0f, 10.0f, xB, 90.0f, 1.0f, buffer, 512);
+        Benchmark::DoNotOptimize(buffer);
+    }
+    state.SetBytesPerIteration(produced * sizeof(float));
+}
+BENCHMARK(BM_Interpolation_LinearBuffer);
+
+static void BM_Interpolation_LinearFixed(Benchmark::State& state) {
+    float xB = 256.0f;
+    int32_t buffer[512];
+    size_t produced = 0;
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(xB);
+        produced = Interpolation::LinearFixed(0.0f, 10.0f, xB, 90.0f, 1.0f, buffer, 512);
+        Benchmark::DoNotOptimize(buffer);
+    }
+    state.SetBytesPerIteration(produced * sizeof(int32_t));
+}
+BENCHMARK(BM_Interpolation_LinearFixed);
+
+static void BM_Interpolation_Edge(Benchmark::State& state) {
+    float yC = 256.0f;
+    size_t produced = 0;
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(yC);
+        std::vector<std::vector<float>> r = Interpolation::Edge(10.0f, 0.0f, 200.0f, 100.0f, 50.0f, yC, 1.0f);
+        produced = r[0].size() + r[1].size();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.counters["heap_allocations"] = double(state.HeapAllocations()) / state.Iterations();
+    state.SetBytesPerIteration(produced * sizeof(float));
+}
+BENCHMARK(BM_Interpolation_Edge);
+
+// Every iteration is a frame with one edge pair: the arena is reset after it.
+static void BM_Interpolation_EdgeArena(Benchmark::State& state) {
+    FrameArena& arena = FrameArena::ForThread();
+    float yC = 256.0f;
+    size_t produced = 0;
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(yC);
+        Interpolation::EdgeValues r = Interpolation::Edge(10.0f, 0.0f, 200.0f, 100.0f, 50.0f, yC, 1.0f, arena);
+        produced = r.acCount + r.abcCount;
+        Benchmark::DoNotOptimize(r);
+        arena.Reset();
+    }
+    state.counters["heap_allocations"] = double(state.HeapAllocations()) / state.Iterations();
+    state.SetBytesPerIteration(produced * sizeof(float));
+}
+BENCHMARK(BM_Interpolation_EdgeArena);
+
+static void BM_Affine3x4_MultiplyAffine(Benchmark::State& state) {
+    Affine3x4 a = Affine3x4::FromMatrix4(SampleMatrix()), b = Affine3x4::FromMatrix4(SampleMatrix().Transpose());
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(a);
+        Affine3x4 r = a.MultiplyAffine(b);
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(3 * sizeof(Affine3x4));
+}
+BENCHMARK(BM_Affine3x4_MultiplyAffine);
+
+static void BM_Affine3x4_Inverse(Benchmark::State& state) {
+    Affine3x4 m = Affine3x4::FromMatrix4(SampleMatrix());
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        std::optional<Affine3x4> r = m.Inverse();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(2 * sizeof(Affine3x4));
+}
+BENCHMARK(BM_Affine3x4_Inverse);
+
+static void BM_Affine3x4_InverseRigid(Benchmark::State& state) {
+    Affine3x4 m = Affine3x4::FromMatrix4(SampleMatrix());
+    for (auto _ : state) {
+        Benchmark::DoNotOptimize(m);
+        Affine3x4 r = m.InverseRigid();
+        Benchmark::DoNotOptimize(r);
+    }
+    state.SetBytesPerIteration(2 * sizeof(Affine3x4));
+}
+BENCHMARK(BM_Affine3x4_InverseRigid);
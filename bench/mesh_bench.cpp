@@ -0,0 +1,123 @@
+#include "benchmark.h"
+#include "../include/mesh.h"
+#include "../include/matrix4.h"
+#include "../include/vector4.h"
+#include "../include/framearena.h"
+#include <vector>
+#include <utility>
+
+// 256 x 256 quad grid (131072 triangles, every vertex shared by up to 6 of them) with the triangles shuffled, like
+// the order of an exporter that does not care about the cache.
+static Mesh ShuffledGrid(size_t size = 256) {
+    std::vector<Vector4> vertices;
+    for (size_t z = 0; z <= size; z++) {
+        for (size_t x = 0; x <= size; x++) vertices.push_back(Vector4(float(x), 0.0f, float(z), 1.0f));
+    }
+    std::vector<uint32_t> indices;
+    for (size_t z = 0; z < size; z++) {
+        for (size_t x = 0; x < size; x++) {
+            const uint32_t i = static_cast<uint32_t>(z * (size + 1) + x), j = i + static_cast<uint32_t>(size + 1);
+            indices.insert(indices.end(), { i, j, i + 1, i + 1, j, j + 1 });
+        }
+    }
+    uint32_t seed = 99;
+    for (size_t t = indices.size() / 3 - 1; t > 0; t--) {
+        seed = seed * 1664525u + 1013904223u;
+        const size_t u = seed % (t + 1);
+        for (int k = 0; k < 3; k++) std::swap(indices[3 * t + k], indices[3 * u + k]);
+    }
+    return Mesh(vertices.data(), vertices.size(), indices.data(), indices.size() / 3);
+}
+
+static Mesh OptimizedGrid() {
+    Mesh mesh = ShuffledGrid();
+    mesh.OptimizeVertexCache();
+    return mesh;
+}
+
+static const Matrix4 meshTransform(
+    0.8f, 0.0f, 0.6f, 1.0f,
+    0.0f, 1.0f, 0.0f, 2.0f,
+    -0.6f, 0.0f, 0.8f, 3.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+);
+
+static void SetCacheCounters(Benchmark::State& state, const Mesh::CacheStats& stats) {
+    state.counters["ACMR"] = stats.ACMR();
+    state.counters["ATVR"] = stats.ATVR();
+    state.counters["transforms"] = double(stats.transforms);
+}
+
+// Every corner transformed on its own, the cost without any cache.
+static void BM_Mesh_TransformCorners(Benchmark::State& state) {
+    const Mesh mesh = ShuffledGrid();
+    const std::vector<Vector4>& vertices = mesh.Vertices();
+    const std::vector<uint32_t>& indices = mesh.Indices();
+    std::vector<Vector4> out(indices.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < indices.size(); i++) out[i] = meshTransform.MultiplyVector(vertices[indices[i]]);
+        Benchmark::DoNotOptimize(out);
+    }
+    Mesh::CacheStats stats;
+    stats.triangles = mesh.TriangleCount();
+    stats.vertices = vertices.size();
+    stats.transforms = indices.size();
+    SetCacheCounters(state, stats);
+    state.SetItemsPerIteration(mesh.TriangleCount());
+    state.SetBytesPerIteration(indices.size() * (sizeof(uint32_t) + sizeof(Vector4)));
+}
+BENCHMARK(BM_Mesh_TransformCorners);
+
+static void RunMeshTransform(Benchmark::State& state, const Mesh& mesh, Mesh::CachePolicy policy) {
+    std::vector<Vector4> out(mesh.Indices().size());
+    Mesh::CacheStats stats;
+    for (auto _ : state) {
+        stats = mesh.Transform(meshTransform, out.data(), 32, policy);
+        Benchmark::DoNotOptimize(out);
+    }
+    SetCacheCounters(state, stats);
+    state.counters["heap_allocations"] = double(state.HeapAllocations()) / state.Iterations();
+    state.SetItemsPerIteration(mesh.TriangleCount());
+    state.SetBytesPerIteration(mesh.Indices().size() * (sizeof(uint32_t) + sizeof(Vector4)));
+}
+
+static void BM_Mesh_Transform_FIFO32_Shuffled(Benchmark::State& state) { RunMeshTransform(state, ShuffledGrid(), Mesh::CachePolicy::FIFO); }
+BENCHMARK(BM_Mesh_Transform_FIFO32_Shuffled);
+
+static void BM_Mesh_Transform_FIFO32_Optimized(Benchmark::State& state) { RunMeshTransform(state, OptimizedGrid(), Mesh::CachePolicy::FIFO); }
+BENCHMARK(BM_Mesh_Transform_FIFO32_Optimized);
+
+static void BM_Mesh_Transform_LRU32_Optimized(Benchmark::State& state) { RunMeshTransform(state, OptimizedGrid(), Mesh::CachePolicy::LRU); }
+BENCHMARK(BM_Mesh_Transform_LRU32_Optimized);
+
+// Cache state taken from the thread arena, which is reset after every frame.
+static void BM_Mesh_Transform_FIFO32_Arena(Benchmark::State& state) {
+    const Mesh mesh = OptimizedGrid();
+    FrameArena& arena = FrameArena::ForThread();
+    std::vector<Vector4> out(mesh.Indices().size());
+    Mesh::CacheStats stats;
+    for (auto _ : state) {
+        stats = mesh.Transform(meshTransform, out.data(), 32, Mesh::CachePolicy::FIFO, arena);
+        Benchmark::DoNotOptimize(out);
+        arena.Reset();
+    }
+    SetCacheCounters(state, stats);
+    state.counters["heap_allocations"] = double(state.HeapAllocations()) / state.Iterations();
+    state.SetItemsPerIteration(mesh.TriangleCount());
+    state.SetBytesPerIteration(mesh.Indices().size() * (sizeof(uint32_t) + sizeof(Vector4)));
+}
+BENCHMARK(BM_Mesh_Transform_FIFO32_Arena);
+
+static void BM_Mesh_OptimizeVertexCache(Benchmark::State& state) {
+    const Mesh shuffled = ShuffledGrid();
+    Mesh mesh = shuffled;
+    for (auto _ : state) {
+        mesh = shuffled;
+        mesh.OptimizeVertexCache();
+        Benchmark::DoNotOptimize(mesh);
+    }
+    SetCacheCounters(state, mesh.SimulateCache(32));
+    state.SetItemsPerIteration(mesh.TriangleCount());
+    state.SetBytesPerIteration(mesh.Indices().size() * sizeof(uint32_t));
+}
+BENCHMARK(BM_Mesh_OptimizeVertexCache);
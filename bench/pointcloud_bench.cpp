@@ -0,0 +1,75 @@
+#include "benchmark.h"
+#include "../include/pointcloudstreamer.h"
+#include "../include/projection.h"
+#include "../include/quaternion.h"
+#include "../include/vector4.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+
+// Four million points in a 256 m cube around the origin written into the temporary directory, 48 MB.
+struct PointCloudFixture {
+    static constexpr size_t pointCount = 1 << 22;
+
+    std::string input;
+    std::string output;
+
+    PointCloudFixture() {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        input = (directory / "w_engine_bench_in.xyz").string();
+        output = (directory / "w_engine_bench_out.xyz").string();
+        std::vector<float> points(3 * pointCount);
+        uint32_t seed = 7;
+        for (float& v : points) {
+            seed = seed * 1664525u + 1013904223u;
+            v = float(seed >> 8) / 65536.0f - 128.0f;
+        }
+        std::ofstream file(input, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(points.data()), points.size() * sizeof(float));
+    }
+
+    ~PointCloudFixture() {
+        std::remove(input.c_str());
+        std::remove(output.c_str());
+    }
+};
+
+// Shares of the wall time: above 1 in total means the reads, the transform and the writes overlapped.
+static void SetStreamCounters(Benchmark::State& state, const PointCloudStreamer::Stats& stats) {
+    state.counters["read"] = stats.readSeconds / stats.seconds;
+    state.counters["process"] = stats.processSeconds / stats.seconds;
+    state.counters["write"] = stats.writeSeconds / stats.seconds;
+    state.counters["wait"] = stats.waitSeconds / stats.seconds;
+    state.counters["written"] = double(stats.pointsWritten);
+}
+
+static void RunPointCloudStream(Benchmark::State& state, bool cull) {
+    const PointCloudFixture fixture;
+    PointCloudStreamer streamer;
+    streamer.SetTransform(Quaternion::FromAngleAxis(0.5f, Vector4(0.0f, 1.0f, 0.0f)), Vector4(10.0f, 0.0f, -20.0f));
+    if (cull) {
+        const Matrix4 view(
+            1, 0, 0, 0,
+            0, 1, 0, -2,
+            0, 0, 1, 0,
+            0, 0, 0, 1
+        );
+        streamer.SetCulling(Frustum(Projection::Perspective(1.0f, 16.0f / 9.0f, 0.5f, 100.0f).MultiplyMatrix(view)));
+    }
+    PointCloudStreamer::Stats stats;
+    for (auto _ : state) {
+        stats = streamer.Process(fixture.input, fixture.output);
+        Benchmark::DoNotOptimize(stats);
+    }
+    SetStreamCounters(state, stats);
+    state.SetItemsPerIteration(PointCloudFixture::pointCount);
+    state.SetBytesPerIteration((PointCloudFixture::pointCount + stats.pointsWritten) * 3 * sizeof(float));
+}
+
+static void BM_PointCloudStreamer_Transform(Benchmark::State& state) { RunPointCloudStream(state, false); }
+BENCHMARK(BM_PointCloudStreamer_Transform);
+
+static void BM_PointCloudStreamer_TransformCull(Benchmark::State& state) { RunPointCloudStream(state, true); }
+BENCHMARK(BM_PointCloudStreamer_TransformCull);
@@ -0,0 +1,51 @@
+#include "benchmark.h"
+#include "../include/vector4.h"
+#include "../include/framebuffer.h"
+#include "../include/rasterizer.h"
+#include "../include/threadpool.h"
+#include "../include/tiledrasterizer.h"
+#include <vector>
+
+static void RunDrawTriangles(Benchmark::State& state, float size, bool tiled) {
+    const int width = 1024, height = 1024;
+    std::vector<uint32_t> color(width * height);
+    std::vector<float> depth(width * height);
+    Framebuffer framebuffer(color.data(), depth.data(), width, height);
+    framebuffer.Clear(0, 1.0f);
+
+    const size_t triangles = 4096;
+    std::vector<Vector4> vertices;
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < triangles; i++) {
+        const float x = static_cast<float>((i * 37) % (width - 64)), y = static_cast<float>((i * 91) % (height - 64));
+        const float z = static_cast<float>(i % 97) / 97.0f;
+        vertices.push_back(Vector4(x, y, z, 1.0f));
+        vertices.push_back(Vector4(x + size, y + 0.3f * size, z, 1.0f));
+        vertices.push_back(Vector4(x + 0.4f * size, y + size, z, 1.0f));
+        indices.push_back(3 * i), indices.push_back(3 * i + 1), indices.push_back(3 * i + 2);
+    }
+
+    static ThreadPool pool;
+    TiledRasterizer tiledRasterizer(pool);
+    size_t written = 0;
+    for (auto _ : state) {
+        written = tiled
+            ? tiledRasterizer.DrawTriangles(framebuffer, vertices.data(), indices.data(), triangles, 0xFFFFFFFFu)
+            : Rasterizer::DrawTriangles(framebuffer, vertices.data(), indices.data(), triangles, 0xFFFFFFFFu);
+        Benchmark::DoNotOptimize(written);
+    }
+    state.SetItemsPerIteration(triangles);
+    state.SetBytesPerIteration(triangles * (3 * sizeof(Vector4) + 3 * sizeof(uint32_t)));
+}
+
+static void BM_Rasterizer_DrawTriangles_4px(Benchmark::State& state) { RunDrawTriangles(state, 4.0f, false); }
+BENCHMARK(BM_Rasterizer_DrawTriangles_4px);
+
+static void BM_Rasterizer_DrawTriangles_32px(Benchmark::State& state) { RunDrawTriangles(state, 32.0f, false); }
+BENCHMARK(BM_Rasterizer_DrawTriangles_32px);
+
+static void BM_TiledRasterizer_DrawTriangles_4px(Benchmark::State& state) { RunDrawTriangles(state, 4.0f, true); }
+BENCHMARK(BM_TiledRasterizer_DrawTriangles_4px);
+
+static void BM_TiledRasterizer_DrawTriangles_32px(Benchmark::State& state) { RunDrawTriangles(state, 32.0f, true); }
+BENCHMARK(BM_TiledRasterizer_DrawTriangles_32px);
@@ -0,0 +1,101 @@
+#include "benchmark.h"
+#include "../include/scenefile.h"
+#include "../include/matrix4.h"
+#include "../include/quaternion.h"
+#include "../include/vector4.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+// One million positions, three million indices, 4096 matrices and 256k quaternions written into the
+// temporary directory, about 45 MB. The text export holds the same positions, one "x y z w" line each.
+struct SceneFixture {
+    static constexpr size_t positionCount = 1 << 20;
+
+    std::string path;
+    std::string text;
+
+    SceneFixture() {
+        path = (std::filesystem::temp_directory_path() / "w_engine_bench.wscene").string();
+        Vector4Stream positions(positionCount);
+        for (size_t i = 0; i < positionCount; i++) {
+            positions.Set(i, Vector4(float(i % 1024), float(i / 1024 % 1024) * 0.5f, float(i) * 0.001f, 1.0f));
+        }
+        std::vector<uint32_t> indices(3 * positionCount);
+        for (size_t i = 0; i < indices.size(); i++) indices[i] = static_cast<uint32_t>((i * 2654435761u) % positionCount);
+        std::vector<Matrix4> matrices(4096, Matrix4(0.8f, 0.0f, 0.6f, 1.0f, 0.0f, 1.0f, 0.0f, 2.0f, -0.6f, 0.0f, 0.8f, 3.0f, 0.0f, 0.0f, 0.0f, 1.0f));
+        QuaternionStream quaternions(1 << 18);
+        for (size_t i = 0; i < quaternions.count; i++) quaternions.Set(i, Quaternion::FromAngleAxis(float(i) * 1e-4f, Vector4(0.0f, 1.0f, 0.0f)));
+
+        SceneFile::Contents contents;
+        contents.positions = &positions;
+        contents.indices = indices.data();
+        contents.indexCount = indices.size();
+        contents.matrices = matrices.data();
+        contents.matrixCount = matrices.size();
+        contents.quaternions = &quaternions;
+        SceneFile::Write(path, contents);
+
+        char line[96];
+        for (size_t i = 0; i < positionCount; i++) {
+            std::snprintf(line, sizeof(line), "%g %g %g %g\n", positions.x[i], positions.y[i], positions.z[i], positions.w[i]);
+            text += line;
+        }
+    }
+
+    ~SceneFixture() {
+        std::remove(path.c_str());
+    }
+};
+
+// Map, validate and take the views, nothing is read beyond the header and the section table.
+static void BM_SceneFile_Open(Benchmark::State& state) {
+    const SceneFixture fixture;
+    size_t count = 0;
+    for (auto _ : state) {
+        SceneFile file(fixture.path);
+        Vector4Stream positions = file.Positions();
+        count = positions.count;
+        Benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(BM_SceneFile_Open);
+
+// Mapped positions fed straight into the batch transform, page faults of the first touch included.
+static void BM_SceneFile_OpenTransform(Benchmark::State& state) {
+    const SceneFixture fixture;
+    const Matrix4 m(0.8f, 0.0f, 0.6f, 1.0f, 0.0f, 1.0f, 0.0f, 2.0f, -0.6f, 0.0f, 0.8f, 3.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+    Vector4Stream out(SceneFixture::positionCount);
+    for (auto _ : state) {
+        SceneFile file(fixture.path);
+        const Vector4Stream positions = file.Positions();
+        m.TransformStream(positions, out, positions.count);
+        Benchmark::DoNotOptimize(out.x[0]);
+    }
+    state.SetItemsPerIteration(SceneFixture::positionCount);
+    state.SetBytesPerIteration(SceneFixture::positionCount * 2 * sizeof(Vector4));
+}
+BENCHMARK(BM_SceneFile_OpenTransform);
+
+// Parsing the text export from memory into a stream, the lower bound of the text path without any disk access.
+static void BM_SceneFile_ParseText(Benchmark::State& state) {
+    const SceneFixture fixture;
+    Vector4Stream positions(SceneFixture::positionCount);
+    for (auto _ : state) {
+        const char* cursor = fixture.text.c_str();
+        char* end;
+        for (size_t i = 0; i < positions.count; i++) {
+            positions.x[i] = std::strtof(cursor, &end);
+            positions.y[i] = std::strtof(end, &end);
+            positions.z[i] = std::strtof(end, &end);
+            positions.w[i] = std::strtof(end, &end);
+            cursor = end;
+        }
+        Benchmark::DoNotOptimize(positions.x[0]);
+    }
+    state.SetItemsPerIteration(SceneFixture::positionCount);
+    state.SetBytesPerIteration(fixture.text.size());
+}
+BENCHMARK(BM_SceneFile_ParseText);
@@ -0,0 +1,56 @@
+#include "benchmark.h"
+#include "../include/vector4.h"
+#include "../include/matrix4.h"
+#include "../include/skinning.h"
+#include "../include/threadpool.h"
+#include "../include/vector4stream.h"
+#include <vector>
+#include <cmath>
+
+// Crowd-sized character: 100k vertices, 64 joints, 4 influences per vertex.
+static void RunSkinning(Benchmark::State& state, bool dualQuaternion) {
+    const size_t vertices = 100000, jointCount = 64, influenceCount = 4;
+
+    std::vector<Matrix4> palette(jointCount);
+    for (size_t j = 0; j < jointCount; j++) {
+        const float angle = 0.05f * j, c = std::cos(angle), s = std::sin(angle);
+        palette[j] = Matrix4(
+            c, -s, 0, 0.01f * j,
+            s,  c, 0, 0.0f,
+            0,  0, 1, 0.02f * j,
+            0,  0, 0, 1
+        );
+    }
+
+    std::vector<uint16_t> joints(influenceCount * vertices);
+    std::vector<float> weights(influenceCount * vertices);
+    Vector4Stream positions(vertices), normals(vertices), outPositions(vertices), outNormals(vertices);
+    for (size_t v = 0; v < vertices; v++) {
+        for (size_t k = 0; k < influenceCount; k++) {
+            joints[k * vertices + v] = static_cast<uint16_t>((v / 64 + k * 7) % jointCount);
+            weights[k * vertices + v] = k == 0 ? 0.4f : 0.2f;
+        }
+        positions.Set(v, Vector4(0.001f * v, 1.0f, 0.5f, 1.0f));
+        normals.Set(v, Vector4(0.0f, 1.0f, 0.0f, 0.0f));
+    }
+    const Skinning::Influences influences = { joints.data(), weights.data(), influenceCount, vertices };
+
+    static ThreadPool pool;
+    Skinning skinning(pool);
+    for (auto _ : state) {
+        if (dualQuaternion) {
+            skinning.DualQuaternion(palette.data(), jointCount, influences, positions, outPositions, &normals, &outNormals);
+        } else {
+            skinning.LinearBlend(palette.data(), jointCount, influences, positions, outPositions, &normals, &outNormals);
+        }
+        Benchmark::DoNotOptimize(outPositions.x);
+    }
+    state.SetItemsPerIteration(vertices);
+    state.SetBytesPerIteration(vertices * (4 * sizeof(Vector4) + influenceCount * (sizeof(uint16_t) + sizeof(float))));
+}
+
+static void BM_Skinning_LinearBlend(Benchmark::State& state) { RunSkinning(state, false); }
+BENCHMARK(BM_Skinning_LinearBlend);
+
+static void BM_Skinning_DualQuaternion(Benchmark::State& state) { RunSkinning(state, true); }
+BENCHMARK(BM_Skinning_DualQuaternion);
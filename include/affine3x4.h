@@ -0,0 +1,124 @@
+#ifndef AFFINE3X4_H
+#define AFFINE3X4_H
+
+class Vector4;
+class Matrix4;
+
+#include <optional>
+
+// Matrix4 with the implicit bottom row 0,0,0,1. Same column-vector convention as Matrix4::MultiplyVector.
+class alignas(16) Affine3x4 {
+public:
+    Affine3x4(
+        float m11 = 1.0f, float m12 = 0.0f, float m13 = 0.0f, float m14 = 0.0f,
+        float m21 = 0.0f, float m22 = 1.0f, float m23 = 0.0f, float m24 = 0.0f,
+        float m31 = 0.0f, float m32 = 0.0f, float m33 = 1.0f, float m34 = 0.0f
+    ):
+    m11(m11), m12(m12), m13(m13), m14(m14),
+    m21(m21), m22(m22), m23(m23), m24(m24),
+    m31(m31), m32(m32), m33(m33), m34(m34) {}
+
+public:
+    float m11, m12, m13, m14;
+    float m21, m22, m23, m24;
+    float m31, m32, m33, m34;
+
+public:
+    /**
+     * @brief Outputs the matrix to the console.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#Print
+    */
+    void Print(const int& precision = 6) const;
+
+public:
+    /**
+     * @brief Drops the bottom row of the matrix. The row is not checked, see Matrix4::IsRigid.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#FromMatrix4
+     *
+     * @param m matrix with bottom row 0,0,0,1.
+     * @return New affine matrix.
+    */
+    static Affine3x4 FromMatrix4(const Matrix4& m);
+
+public:
+    /**
+     * @brief Restores the bottom row 0,0,0,1.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#ToMatrix4
+     *
+     * @return New Matrix4.
+    */
+    Matrix4 ToMatrix4() const;
+
+public:
+    /**
+     * @brief Computes the determinant of the 3x3 linear part, which equals the determinant of the full matrix.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#Determinant
+     *
+     * @return Scalar value of determinant.
+    */
+    float Determinant() const;
+
+public:
+    /**
+     * @brief Multiplies current matrix by column-vector. The w coefficient passes through unchanged.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#MultiplyVector
+     *
+     * @param v vector to multiply.
+     * @return New column-vector.
+    */
+    Vector4 MultiplyVector(const Vector4& v) const;
+
+public:
+    /**
+     * @brief Calculates product of two affine matrices. 36 multiplications instead of 64.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#MultiplyAffine
+     *
+     * @param m matrix to multiply.
+     * @return Product of the matrices.
+    */
+    Affine3x4 MultiplyAffine(const Affine3x4& m) const;
+
+public:
+    /**
+     * @brief Calculates the inverse matrix as inverse of the 3x3 part and its product with the negated translation.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#Inverse
+     *
+     * @return New inversed matrix or nullopt when determinant is equal zero.
+    */
+    std::optional<Affine3x4> Inverse() const;
+
+public:
+    /**
+     * @brief Inverts rotation and translation matrix: transposed rotation and rotated negated translation.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Affine3x4#InverseRigid
+     *
+     * @return New inversed matrix. Wrong for matrices with scale or shear.
+    */
+    Affine3x4 InverseRigid() const;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef BFLOAT16_H
+#define BFLOAT16_H
+
+#include <cstdint>
+#include <cstring>
+
+// Storage-only brain float: upper 16 bits of an IEEE float (8 exponent bits, 7 mantissa bits). Arithmetic is done
+// in float through the implicit conversion, the result is rounded back to nearest-even when stored. Halves the
+// bandwidth of float data that tolerates ~3 significant digits, e.g. Vec<BFloat16, 4> normals or weights.
+class BFloat16 {
+public:
+    BFloat16(): bits(0) {}
+
+    BFloat16(int value): BFloat16(static_cast<float>(value)) {}
+
+    BFloat16(float value) {
+        uint32_t word;
+        std::memcpy(&word, &value, sizeof(word));
+        if ((word & 0x7FFFFFFFu) > 0x7F800000u) {
+            // NaN stays NaN even when the payload is only in the dropped bits.
+            bits = static_cast<uint16_t>((word >> 16) | 0x40u);
+        } else {
+            bits = static_cast<uint16_t>((word + 0x7FFFu + ((word >> 16) & 1u)) >> 16);
+        }
+    }
+
+public:
+    uint16_t bits;
+
+public:
+    operator float() const {
+        const uint32_t word = static_cast<uint32_t>(bits) << 16;
+        float value;
+        std::memcpy(&value, &word, sizeof(value));
+        return value;
+    }
+};
+
+static_assert(sizeof(BFloat16) == 2, "BFloat16 must be stored in 16 bits.");
+
+#endif
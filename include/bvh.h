@@ -0,0 +1,172 @@
+#ifndef BVH_H
+#define BVH_H
+
+class ThreadPool;
+class Vector4Stream;
+
+#include "vector3.h"
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+// Bounding volume hierarchy over an indexed triangle mesh for ray picking and line-of-sight queries.
+// Built top-down with the binned surface area heuristic, the subtrees below the first levels are built in parallel.
+// Nodes are flattened into one array with siblings stored next to each other (two 32-byte nodes per cache line),
+// triangles are copied into leaf order so a leaf is a contiguous run of memory.
+class BVH {
+public:
+    static constexpr uint32_t noHit = 0xFFFFFFFFu;
+    // Largest mesh of Build. The tree has up to 2 * triangleCount - 1 nodes, their indices must fit into uint32_t.
+    static constexpr size_t maxTriangleCount = size_t(1) << 31;
+
+public:
+    struct Hit {
+        float t;
+        // Barycentric coordinates of the hit point: p = (1 - u - v) * v0 + u * v1 + v * v2.
+        float u;
+        float v;
+        // Index of the triangle in the mesh, noHit when the ray missed.
+        uint32_t triangle;
+    };
+
+    struct Node {
+        Vector3 min;
+        // Interior: index of the first child, the second one follows it. Leaf: first triangle in leaf order.
+        uint32_t leftOrFirst;
+        Vector3 max;
+        // Amount of triangles in a leaf, 0 for interior nodes.
+        uint32_t count;
+    };
+
+public:
+    /**
+     * @param pool workers used by Build and IntersectStream. Must outlive the hierarchy.
+     * @param chunkSize rays per job of IntersectStream. Rounded up to 16 so that chunks never share an output cache line.
+    */
+    BVH(ThreadPool& pool, size_t chunkSize = 1024);
+
+public:
+    /**
+     * @brief Builds the hierarchy, replacing the previous one. The mesh is copied and may be released afterwards.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/BVH#Build
+     *
+     * @param vertices triangle corners.
+     * @param vertexCount amount of vertices. Every index must be below it.
+     * @param indices three indices per triangle.
+     * @param triangleCount amount of triangles, at most maxTriangleCount. std::out_of_range otherwise.
+     * @param maxLeafSize leaves hold at most this many triangles, between 1 and 16. Smaller leaves are made whenever
+     * the heuristic finds splitting cheaper.
+    */
+    void Build(const Vector3* vertices, size_t vertexCount, const uint32_t* indices, size_t triangleCount, size_t maxLeafSize = 4);
+
+public:
+    /**
+     * @brief Finds the closest triangle hit by the ray within (0, tMax). Both faces of a triangle are hit.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/BVH#Intersect
+     *
+     * @param origin ray origin.
+     * @param direction ray direction, not required to be normalized. t is measured in its length.
+     * @param hit closest hit. Triangle is noHit and t is tMax when nothing was hit.
+     * @param tMax farthest accepted distance.
+     * @return Whether any triangle was hit.
+    */
+    bool Intersect(const Vector3& origin, const Vector3& direction, Hit& hit,
+                   float tMax = std::numeric_limits<float>::infinity()) const;
+
+public:
+    /**
+     * @brief Checks whether any triangle lies on the ray within (0, tMax). Stops at the first hit, so it is
+     * cheaper than Intersect for line-of-sight and shadow tests.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/BVH#Occluded
+     *
+     * @param origin ray origin.
+     * @param direction ray direction, for segments the difference of the end points with tMax = 1.
+     * @param tMax farthest tested distance.
+    */
+    bool Occluded(const Vector3& origin, const Vector3& direction, float tMax = std::numeric_limits<float>::infinity()) const;
+
+public:
+    /**
+     * @brief Finds closest hits of a batch of rays, chunks of rays are traced on the pool.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/BVH#IntersectStream
+     *
+     * @param origins ray origins in x, y, z and tMax in w.
+     * @param directions ray directions, at least origins.count long. W is ignored.
+     * @param hits closest hit of every ray, room for origins.count values.
+     * @return Amount of rays that hit a triangle.
+    */
+    size_t IntersectStream(const Vector4Stream& origins, const Vector4Stream& directions, Hit* hits);
+
+public:
+    /**
+     * @brief Slab test of a ray against an axis-aligned box.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/BVH#IntersectBox
+     *
+     * @param origin ray origin.
+     * @param inverseDirection 1 / direction per component. Infinite components of a zero direction are allowed, the
+     * ray is then within the slab when the origin is, faces included.
+     * @param tMax farthest accepted distance.
+     * @param tNear entry distance, clamped to 0 when the origin is inside.
+     * @return Whether the ray enters the box within [0, tMax].
+    */
+    static bool IntersectBox(const Vector3& origin, const Vector3& inverseDirection, const Vector3& min, const Vector3& max,
+                             float tMax, float& tNear);
+
+public:
+    /**
+     * @brief Moller-Trumbore ray/triangle test. Both faces are hit.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/BVH#IntersectTriangle
+     *
+     * @return Whether the ray hits the triangle within (0, tMax). t, u and v are written only on a hit.
+    */
+    static bool IntersectTriangle(const Vector3& origin, const Vector3& direction, const Vector3& v0, const Vector3& v1,
+                                  const Vector3& v2, float tMax, float& t, float& u, float& v);
+
+public:
+    const std::vector<Node>& Nodes() const;
+
+public:
+    // Longest path from the root to a leaf, counted in nodes. 0 for an empty hierarchy.
+    size_t Depth() const;
+
+private:
+    // First vertex and the two edges leaving it, which is all Moller-Trumbore needs.
+    struct Triangle {
+        Vector3 v0;
+        Vector3 edge1;
+        Vector3 edge2;
+    };
+
+private:
+    template <bool any>
+    bool Traverse(const Vector3& origin, const Vector3& direction, Hit& hit) const;
+
+private:
+    ThreadPool& pool;
+    size_t chunkSize;
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;
+    // Mesh index of every triangle in leaf order.
+    std::vector<uint32_t> triangleIndices;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef CLIPPER_H
+#define CLIPPER_H
+
+class Vector4Stream;
+
+#include "vector4.h"
+#include "frustum.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Vertex post-transform stage between clip space and the rasterizers: trivial rejection, guard-band clipping,
+// perspective divide and viewport mapping of indexed triangles.
+//
+// Outcodes of all vertices are computed 8 at a time from SoA clip coordinates (AVX2 when available). Triangles
+// entirely outside one frustum plane are dropped. Triangles crossing the left, right, bottom or top frustum planes
+// are kept as they are as long as they stay inside the guard band, the rasterizers scissor them to the framebuffer.
+// Only triangles crossing the near or far plane or leaving the guard band go through Sutherland-Hodgman, and only
+// against the planes they cross. The resulting polygons are fanned into triangles with the winding of the input.
+class Clipper {
+public:
+    // Half of TiledRasterizer::coordinateLimit, vertices on the guard band stay inside the limit after rounding.
+    static constexpr float defaultGuardBand = 16384.0f;
+
+public:
+    struct Stats {
+        // Input triangles emitted without clipping.
+        size_t accepted = 0;
+        // Input triangles outside one of the frustum planes.
+        size_t rejected = 0;
+        // Input triangles passed through Sutherland-Hodgman.
+        size_t clipped = 0;
+    };
+
+public:
+    /**
+     * @param x,y top-left corner of the viewport in pixels.
+     * @param width,height viewport size in pixels, greater than 0.
+     * @param depth clip-space depth range of the projection. Screen depth is always mapped to [0, 1].
+     * @param guardBand screen coordinates of emitted vertices stay within [-guardBand, guardBand]. Must contain the viewport.
+    */
+    Clipper(float x, float y, float width, float height, Frustum::Depth depth = Frustum::Depth::NegativeOneToOne,
+            float guardBand = defaultGuardBand);
+
+public:
+    /**
+     * @brief Maps clip-space vertex to the screen: x and y in pixels with y pointing down, z depth in [0, 1] and
+     * 1 / w in w for perspective-correct interpolation.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Clipper#Map
+     *
+     * @param clip vertex with w greater than 0.
+    */
+    Vector4 Map(const Vector4& clip) const;
+
+public:
+    /**
+     * @brief Clips, divides and maps indexed triangles, replacing the previous output.
+     *
+     * Vertex i of the input becomes vertex i of Vertices, vertices created by clipping are appended after them.
+     * Indices hold three entries per emitted triangle, in input order, and can be passed to Rasterizer::DrawTriangles
+     * and TiledRasterizer::DrawTriangles together with Vertices.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Clipper#Process
+     *
+     * @param clip clip-space positions, e.g. the output of TransformPipeline::Transform with projection * view * model.
+     * @param indices three indices per triangle, each below clip.count.
+     * @param triangleCount amount of input triangles.
+     * @return Amount of emitted triangles.
+    */
+    size_t Process(const Vector4Stream& clip, const uint32_t* indices, size_t triangleCount);
+
+public:
+    const std::vector<Vector4>& Vertices() const;
+
+public:
+    const std::vector<uint32_t>& Indices() const;
+
+public:
+    // Counters of the last Process call.
+    const Stats& LastStats() const;
+
+private:
+    static constexpr uint32_t noVertex = 0xFFFFFFFFu;
+
+private:
+    // Polygon vertex during clipping. Index of the input vertex, or noVertex for vertices made by clipping.
+    struct ClipVertex {
+        float x, y, z, w;
+        uint32_t index;
+    };
+
+private:
+    void ClipTriangle(const Vector4Stream& clip, const uint32_t* triangle, uint32_t planes);
+
+private:
+    // Screen coordinate = scale * NDC coordinate + offset for x, y and z, stored as scale, offset pairs.
+    float viewport[6];
+    // Guard band in clip space: guard[0] * w <= x <= guard[1] * w and guard[2] * w <= y <= guard[3] * w.
+    float guard[4];
+    // Near plane is z + nearW * w >= 0: 1 for Depth::NegativeOneToOne, 0 for Depth::ZeroToOne.
+    float nearW;
+    // Outcode of every input vertex, bit set when the vertex is outside of the plane.
+    std::vector<uint16_t> codes;
+    std::vector<Vector4> vertices;
+    std::vector<uint32_t> indices;
+    Stats stats;
+};
+
+#endif
@@ -6,9 +6,11 @@
 class Vector4;
 class Matrix4;
 class Quaternion;
+class QuaternionStream;
 
 #include <set>
 #include <cmath>
+#include <cstddef>
 #include <string>
 #include <iomanip> 
 #include <iostream>
@@ -21,7 +23,10 @@ public: enum class Order { XYZ, XZY, YXZ, YZX, ZXY, ZYX };
 public: float alpha, beta, gamma;
 public: Order order;
 
-public: Euler(float alpha = 0, float beta = 0, float gamma = 0, const std::string& order = "XYZ"):
+public: constexpr Euler(float alpha = 0, float beta = 0, float gamma = 0, Order order = Order::XYZ):
+    alpha(alpha), beta(beta), gamma(gamma), order(order) {}
+
+public: Euler(float alpha, float beta, float gamma, const std::string& order):
     alpha(alpha), beta(beta), gamma(gamma), order(StringToOrder(order)) {}
 
 public: static Order StringToOrder(const std::string& order);
@@ -42,16 +47,21 @@ public: static Euler ZXY(const Matrix4& rotationMatrix, float epsilon = 1e-6);
 
 public: static Euler ZYX(const Matrix4& rotationMatrix, float epsilon = 1e-6);
 
+// One of XYZ ... ZYX chosen by the runtime order, see EulerAngles::FromMatrix.
+public: static Euler Decompose(const Matrix4& rotationMatrix, Order order, float epsilon = 1e-6);
+
 public: static Euler FromAngleAxis(const float& angleRadians, const Vector4& axis, const std::string& order);
 
 public: static Euler FromRotationMatrix(const Matrix4& m);
 
-public: static Euler FromQuaternion(const Quaternion& q);
+// Angles of the given order read directly from the quaternion, see EulerAngles::FromQuaternion.
+public: static Euler FromQuaternion(const Quaternion& q, Order order = Order::XYZ, float epsilon = 1e-6);
 
 public: float ToRotationAngle() const;
 
 public: Vector4 ToRotationAxis() const;
 
+// Product of the three axis quaternions of the order, see EulerAngles::ToQuaternion.
 public: Quaternion ToQuaternion() const;
 
 public: Matrix4 RotateX() const;
@@ -62,6 +72,23 @@ public: Matrix4 RotateZ() const;
 
 public: Matrix4 RotateXYZ() const;
 
+// out[i] = Euler(alpha[i], beta[i], gamma[i], order).RotateXYZ() for SoA angle arrays. The order is dispatched once per batch,
+// sin and cos of 8 angles are evaluated at once with AVX2 and FMA, error below 3e-7 for |angle| < 8192.
+public: static void ToMatrices(const float* alpha, const float* beta, const float* gamma, Order order, Matrix4* out, size_t count);
+
+// out[i] = Euler(alpha[i], beta[i], gamma[i], order).ToQuaternion(), vectorized like ToMatrices.
+public: static void ToQuaternions(const float* alpha, const float* beta, const float* gamma, Order order, Quaternion* out, size_t count);
+
+public: static void ToQuaternions(const float* alpha, const float* beta, const float* gamma, Order order, QuaternionStream& out, size_t count);
+
+// Euler::FromQuaternion(q[i], order) into SoA angle arrays, 8 quaternions at once with AVX2 and FMA. Angles differ from the
+// scalar ones by less than 2e-6 away from gimbal lock.
+public: static void FromQuaternions(const Quaternion* q, Order order, float* alpha, float* beta, float* gamma, size_t count,
+                                    float epsilon = 1e-6);
+
+public: static void FromQuaternions(const QuaternionStream& q, Order order, float* alpha, float* beta, float* gamma, size_t count,
+                                    float epsilon = 1e-6);
+
 };
 
 #endif
@@ -0,0 +1,206 @@
+#ifndef EULERANGLES_H
+#define EULERANGLES_H
+
+#include "euler.h"
+#include "matrix4.h"
+#include "quaternion.h"
+#include <cmath>
+
+// Euler angles with the rotation order fixed at compile time. Alpha rotates about the first axis of the order, beta about
+// the second and gamma about the third: M = R_first(alpha) * R_second(beta) * R_third(gamma), the matrix Euler::RotateXYZ
+// builds. All six orders share one implementation written over the axis indices, which are constants here, so composition
+// and decomposition compile to straight-line code without any switch. Euler is the type-erased counterpart that stores
+// the order at runtime and dispatches into these specializations.
+template <Euler::Order O>
+class EulerAngles {
+public:
+    static constexpr Euler::Order order = O;
+    static constexpr int first = O == Euler::Order::XYZ || O == Euler::Order::XZY ? 0 : O == Euler::Order::YXZ || O == Euler::Order::YZX ? 1 : 2;
+    static constexpr int second = O == Euler::Order::YXZ || O == Euler::Order::ZXY ? 0 : O == Euler::Order::XYZ || O == Euler::Order::ZYX ? 1 : 2;
+    static constexpr int third = 3 - first - second;
+    // +1 when the axes follow the cyclic order x -> y -> z (XYZ, YZX, ZXY), -1 otherwise.
+    static constexpr float parity = (second - first + 3) % 3 == 1 ? 1.0f : -1.0f;
+
+public:
+    constexpr EulerAngles(float alpha = 0, float beta = 0, float gamma = 0): alpha(alpha), beta(beta), gamma(gamma) {}
+
+public:
+    float alpha, beta, gamma;
+
+public:
+    /**
+     * @brief Converts to the runtime-ordered Euler.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/EulerAngles#ToEuler
+    */
+    Euler ToEuler() const { return Euler(alpha, beta, gamma, O); }
+
+public:
+    /**
+     * @brief Builds rotation matrix for column-vectors, equal to Euler::RotateXYZ with the same order.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/EulerAngles#ToMatrix
+    */
+    Matrix4 ToMatrix() const {
+        // Product of the three axis rotations written out for XYZ over the axis indices i, j, k. An order of odd
+        // parity is XYZ with the axes permuted by a reflection, which turns every angle around, hence the signed sines.
+        const int i = first, j = second, k = third;
+        const float ca = std::cos(alpha), sa = parity * std::sin(alpha);
+        const float cb = std::cos(beta), sb = parity * std::sin(beta);
+        const float cg = std::cos(gamma), sg = parity * std::sin(gamma);
+        float m[9];
+        m[i * 3 + i] = cb * cg;
+        m[i * 3 + j] = -cb * sg;
+        m[i * 3 + k] = sb;
+        m[j * 3 + i] = ca * sg + sa * sb * cg;
+        m[j * 3 + j] = ca * cg - sa * sb * sg;
+        m[j * 3 + k] = -sa * cb;
+        m[k * 3 + i] = sa * sg - ca * sb * cg;
+        m[k * 3 + j] = sa * cg + ca * sb * sg;
+        m[k * 3 + k] = ca * cb;
+        return Matrix4(
+            m[0], m[1], m[2], 0,
+            m[3], m[4], m[5], 0,
+            m[6], m[7], m[8], 0,
+            0,    0,    0,    1
+        );
+    }
+
+public:
+    /**
+     * @brief Builds unit quaternion q_first(alpha) * q_second(beta) * q_third(gamma) from half-angle sin and cos.
+     *
+     * The result is continuous in the angles, so w may be negative.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/EulerAngles#ToQuaternion
+    */
+    Quaternion ToQuaternion() const {
+        const float ca = std::cos(0.5f * alpha), sa = std::sin(0.5f * alpha);
+        const float cb = std::cos(0.5f * beta), sb = std::sin(0.5f * beta);
+        const float cg = std::cos(0.5f * gamma), sg = std::sin(0.5f * gamma);
+        float q[4];
+        q[0] = ca * cb * cg - parity * sa * sb * sg;
+        q[1 + first] = sa * cb * cg + parity * ca * sb * sg;
+        q[1 + second] = ca * sb * cg - parity * sa * cb * sg;
+        q[1 + third] = ca * cb * sg + parity * sa * sb * cg;
+        return Quaternion(q[0], q[1], q[2], q[3]);
+    }
+
+public:
+    /**
+     * @brief Decomposes rotation matrix into angles of this order.
+     *
+     * Beta is in [-pi / 2, pi / 2]. When cos(beta) is below epsilon the first and third axes line up (gimbal lock),
+     * alpha is set to 0 and the whole remaining rotation goes to gamma, so ToMatrix reproduces the input.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/EulerAngles#FromMatrix
+     *
+     * @param m rotation matrix for column-vectors.
+     * @param epsilon threshold of cos(beta) for the gimbal lock case.
+    */
+    static EulerAngles FromMatrix(const Matrix4& m, float epsilon = 1e-6f) {
+        const int i = first, j = second, k = third;
+        const float sinBeta = parity * At(m, i, k);
+        const float cosBeta = std::sqrt(At(m, i, i) * At(m, i, i) + At(m, i, j) * At(m, i, j));
+        if (cosBeta > epsilon) {
+            return EulerAngles(
+                std::atan2(-parity * At(m, j, k), At(m, k, k)),
+                std::atan2(sinBeta, cosBeta),
+                std::atan2(-parity * At(m, i, j), At(m, i, i))
+            );
+        }
+        // Alpha = 0: row j of M is row j of R_third(gamma).
+        return EulerAngles(
+            0,
+            sinBeta < 0 ? -static_cast<float>(M_PI_2) : static_cast<float>(M_PI_2),
+            std::atan2(parity * At(m, j, i), At(m, j, j))
+        );
+    }
+
+public:
+    /**
+     * @brief Decomposes rotation of quaternion into angles of this order without building the matrix.
+     *
+     * Uses the five matrix elements FromMatrix reads, written in the quaternion components, so both agree up to
+     * rounding. The quaternion is not required to be normalized, q and -q give the same angles.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/EulerAngles#FromQuaternion
+     *
+     * @param q rotation, any non-zero length.
+     * @param epsilon threshold of cos(beta) for the gimbal lock case.
+    */
+    static EulerAngles FromQuaternion(const Quaternion& q, float epsilon = 1e-6f) {
+        const float v[3] = { q.x, q.y, q.z };
+        const float w = q.w, qi = v[first], qj = v[second], qk = v[third];
+        // Squared length stands for 1 on the diagonal, which keeps the elements consistent for any length.
+        const float n = w * w + qi * qi + qj * qj + qk * qk;
+        const float sinBeta = 2 * (w * qj + parity * qi * qk);
+        const float mii = n - 2 * (qj * qj + qk * qk);
+        const float mij = 2 * (w * qk - parity * qi * qj);
+        const float cosBeta = std::sqrt(mii * mii + mij * mij);
+        if (cosBeta > epsilon * n) {
+            return EulerAngles(
+                std::atan2(2 * (w * qi - parity * qj * qk), n - 2 * (qi * qi + qj * qj)),
+                std::atan2(sinBeta, cosBeta),
+                std::atan2(mij, mii)
+            );
+        }
+        return EulerAngles(
+            0,
+            sinBeta < 0 ? -static_cast<float>(M_PI_2) : static_cast<float>(M_PI_2),
+            std::atan2(2 * (w * qk + parity * qi * qj), n - 2 * (qi * qi + qk * qk))
+        );
+    }
+
+public:
+    /**
+     * @brief Decomposes rotation by angle around unit axis into angles of this order.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/EulerAngles#FromAngleAxis
+    */
+    static EulerAngles FromAngleAxis(float angleRadians, float x, float y, float z) {
+        const float c = std::cos(angleRadians), s = std::sin(angleRadians), t = 1.0f - c;
+        return FromMatrix(Matrix4(
+            c + x * x * t,     x * y * t - z * s, x * z * t + y * s, 0,
+            y * x * t + z * s, c + y * y * t,     y * z * t - x * s, 0,
+            z * x * t - y * s, z * y * t + x * s, c + z * z * t,     0,
+            0,                 0,                 0,                 1
+        ));
+    }
+
+private:
+    static constexpr float At(const Matrix4& m, int r, int c) {
+        switch (r * 3 + c) {
+            case 0: return m.m11;
+            case 1: return m.m12;
+            case 2: return m.m13;
+            case 3: return m.m21;
+            case 4: return m.m22;
+            case 5: return m.m23;
+            case 6: return m.m31;
+            case 7: return m.m32;
+            default: return m.m33;
+        }
+    }
+};
+
+typedef EulerAngles<Euler::Order::XYZ> EulerXYZ;
+typedef EulerAngles<Euler::Order::XZY> EulerXZY;
+typedef EulerAngles<Euler::Order::YXZ> EulerYXZ;
+typedef EulerAngles<Euler::Order::YZX> EulerYZX;
+typedef EulerAngles<Euler::Order::ZXY> EulerZXY;
+typedef EulerAngles<Euler::Order::ZYX> EulerZYX;
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cstdint>
+
+// Signed fixed point number with FractionBits fractional bits stored in 32 bits. Products and quotients are
+// computed in 64 bits, products round toward negative infinity and quotients toward zero. Results are identical
+// on every platform, which makes the type suitable for lockstep simulation. Overflow is not checked.
+template <int FractionBits>
+class Fixed {
+public:
+    static_assert(FractionBits > 0 && FractionBits < 31, "Fixed needs at least one integer and one fraction bit.");
+
+    static constexpr int fractionBits = FractionBits;
+    static constexpr int32_t one = int32_t(1) << FractionBits;
+
+public:
+    constexpr Fixed(): raw(0) {}
+
+    constexpr Fixed(int value): raw(static_cast<int32_t>(value * one)) {}
+
+    constexpr Fixed(float value): raw(static_cast<int32_t>(value * one + (value < 0 ? -0.5f : 0.5f))) {}
+
+    constexpr Fixed(double value): raw(static_cast<int32_t>(value * one + (value < 0 ? -0.5 : 0.5))) {}
+
+public:
+    int32_t raw;
+
+public:
+    /**
+     * @brief Wraps raw representation without conversion.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Fixed#FromRaw
+    */
+    static constexpr Fixed FromRaw(int32_t raw) {
+        Fixed result;
+        result.raw = raw;
+        return result;
+    }
+
+public:
+    /**
+     * @brief Converts to floating point, exact for float when FractionBits + integer bits fit 24 bits.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Fixed#ToFloat
+    */
+    constexpr float ToFloat() const { return static_cast<float>(raw) / one; }
+
+    constexpr double ToDouble() const { return static_cast<double>(raw) / one; }
+
+    explicit constexpr operator float() const { return ToFloat(); }
+
+    explicit constexpr operator double() const { return ToDouble(); }
+
+public:
+    constexpr Fixed operator-() const { return FromRaw(-raw); }
+
+    constexpr Fixed operator+(Fixed b) const { return FromRaw(raw + b.raw); }
+
+    constexpr Fixed operator-(Fixed b) const { return FromRaw(raw - b.raw); }
+
+    constexpr Fixed operator*(Fixed b) const { return FromRaw(static_cast<int32_t>((int64_t(raw) * b.raw) >> FractionBits)); }
+
+    constexpr Fixed operator/(Fixed b) const { return FromRaw(static_cast<int32_t>((int64_t(raw) << FractionBits) / b.raw)); }
+
+    constexpr Fixed& operator+=(Fixed b) { raw += b.raw; return *this; }
+
+    constexpr Fixed& operator-=(Fixed b) { raw -= b.raw; return *this; }
+
+    constexpr Fixed& operator*=(Fixed b) { return *this = *this * b; }
+
+    constexpr Fixed& operator/=(Fixed b) { return *this = *this / b; }
+
+    constexpr bool operator==(Fixed b) const { return raw == b.raw; }
+
+    constexpr bool operator!=(Fixed b) const { return raw != b.raw; }
+
+    constexpr bool operator<(Fixed b) const { return raw < b.raw; }
+
+    constexpr bool operator<=(Fixed b) const { return raw <= b.raw; }
+
+    constexpr bool operator>(Fixed b) const { return raw > b.raw; }
+
+    constexpr bool operator>=(Fixed b) const { return raw >= b.raw; }
+};
+
+// Same layout as the values produced by Interpolation::LinearFixed.
+typedef Fixed<16> Fixed16;
+
+static_assert(sizeof(Fixed16) == sizeof(int32_t), "Fixed must be stored as a plain 32-bit integer.");
+static_assert((Fixed16(1.5f) * Fixed16(-2)).raw == Fixed16(-3).raw, "Fixed multiplication.");
+static_assert((Fixed16(3) / Fixed16(4)).raw == Fixed16(0.75f).raw, "Fixed division.");
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+// Bump allocator for temporary results that live until the end of a frame. Allocation moves a pointer, Reset
+// releases everything at once. Memory comes from the heap only while the arena grows; after a frame that needed
+// several blocks Reset merges them into one, so from the next frame on the same workload allocates nothing.
+// An arena is not synchronized: every thread uses its own, see ForThread.
+class FrameArena {
+public:
+    static constexpr size_t defaultBlockSize = 1 << 20;
+
+public:
+    struct Stats {
+        // Allocate calls since the last Reset.
+        size_t allocations = 0;
+        // Bytes in use since the last Reset, including alignment padding.
+        size_t bytes = 0;
+        // Largest bytes value seen by Reset.
+        size_t peakBytes = 0;
+        // Blocks taken from the heap during the whole lifetime of the arena. Stays constant in the steady state.
+        size_t heapAllocations = 0;
+    };
+
+public:
+    // Position of the arena returned by Mark, Rewind releases everything allocated after it.
+    struct Marker {
+        size_t block;
+        size_t offset;
+        size_t bytes;
+    };
+
+public:
+    // Rewinds the arena to the position at construction when leaving the scope, for temporaries of one call.
+    class Scope {
+    public:
+        explicit Scope(FrameArena& arena): arena(arena), marker(arena.Mark()) {}
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() { arena.Rewind(marker); }
+
+    private:
+        FrameArena& arena;
+        Marker marker;
+    };
+
+public:
+    /**
+     * @param blockSize size of the first block and the minimum size of the following ones. 0 - no block is
+     * allocated before the first Allocate.
+    */
+    explicit FrameArena(size_t blockSize = defaultBlockSize);
+
+    FrameArena(const FrameArena&) = delete;
+
+    FrameArena& operator=(const FrameArena&) = delete;
+
+public:
+    /**
+     * @brief Arena of the calling thread, created on first use. The thread resets it once per frame.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/FrameArena#ForThread
+    */
+    static FrameArena& ForThread();
+
+public:
+    /**
+     * @brief Returns uninitialized memory valid until Reset or a Rewind past it.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/FrameArena#Allocate
+     *
+     * @note Time complexity: O(1). Touches the heap only when the current block is exhausted.
+     * @param bytes amount of bytes.
+     * @param alignment power of two.
+     * @return Pointer aligned to alignment.
+    */
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+public:
+    /**
+     * @brief Returns uninitialized storage for count values of T. Destructors are never called, so T must be
+     * trivially destructible.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/FrameArena#Allocate
+    */
+    template <class T>
+    T* Allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena does not call destructors.");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+public:
+    /**
+     * @brief Current position of the arena.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/FrameArena#Mark
+    */
+    Marker Mark() const;
+
+public:
+    /**
+     * @brief Releases everything allocated after marker. Blocks are kept.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/FrameArena#Rewind
+     *
+     * @param marker position returned by Mark since the last Reset.
+    */
+    void Rewind(const Marker& marker);
+
+public:
+    /**
+     * @brief Releases everything, called once per frame. If the frame needed more than one block, they are
+     * replaced by a single block of their total size.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/FrameArena#Reset
+    */
+    void Reset();
+
+public:
+    const Stats& GetStats() const;
+
+public:
+    // Total size of the blocks.
+    size_t Capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+private:
+    void AddBlock(size_t minimumSize);
+
+private:
+    std::vector<Block> blocks;
+    size_t blockSize;
+    // Current block and offset of the first free byte in it.
+    size_t block = 0;
+    size_t offset = 0;
+    Stats stats;
+};
+
+#endif
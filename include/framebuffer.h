@@ -0,0 +1,44 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Non-owning view of caller-provided color and depth planes.
+class Framebuffer {
+public:
+    Framebuffer(uint32_t* color = nullptr, float* depth = nullptr, int width = 0, int height = 0, int pitch = 0):
+        color(color), depth(depth), width(width), height(height), pitch(pitch != 0 ? pitch : width) {}
+
+public:
+    uint32_t* color;
+    float* depth;
+    int width, height;
+    // Distance between rows in pixels, equal to width for tightly packed planes.
+    int pitch;
+
+public:
+    /**
+     * @brief Fills color and depth planes.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Framebuffer#Clear
+     *
+     * @param color fill color.
+     * @param depth fill depth. Fragments pass the depth test when their z is less than the stored one.
+    */
+    void Clear(uint32_t color = 0, float depth = 1.0f);
+
+public:
+    /**
+     * @brief Returns non-owning view of the rectangle [x, x + width) x [y, y + height).
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Framebuffer#Region
+    */
+    Framebuffer Region(int x, int y, int width, int height) const;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+class Matrix4;
+class Vector4Stream;
+
+#include "vector4.h"
+#include <cstdint>
+#include <cstddef>
+
+// View frustum as six planes a * x + b * y + c * z + d >= 0 for the inside, normals have unit length so plane
+// distances are in world units. Single volumes are classified with plane masks for hierarchical culling, SoA
+// batches are tested 8 at a time with AVX2 and return compact lists of visible indices.
+class Frustum {
+public: enum class Depth { NegativeOneToOne, ZeroToOne };
+
+public: enum class Result { Outside, Intersect, Inside };
+
+public:
+    // Plane order: left, right, bottom, top, near, far. Bit i of a plane mask selects plane i.
+    static constexpr uint8_t allPlanes = 0x3F;
+
+public:
+    /**
+     * @brief Extracts planes from a view-projection matrix for column-vectors (Gribb-Hartmann).
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Frustum#Frustum
+     *
+     * @param viewProjection projection * view, clip = viewProjection * v.
+     * @param depth clip-space depth range of the projection.
+    */
+    Frustum(const Matrix4& viewProjection, Depth depth = Depth::NegativeOneToOne);
+
+public:
+    Vector4 planes[6];
+
+public:
+    /**
+     * @brief Classifies bounding sphere against the planes selected by planeMask.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Frustum#TestSphere
+     *
+     * @param sphere center in x, y, z and radius in w.
+     * @param planeMask planes to test. On return only the planes the sphere intersects remain set, so the children
+     * of a hierarchy node test fewer planes and an empty mask means the subtree is inside.
+     * @return Outside, Intersect or Inside with respect to the tested planes.
+    */
+    Result TestSphere(const Vector4& sphere, uint8_t& planeMask) const;
+
+public:
+    /**
+     * @brief Classifies axis-aligned box against the planes selected by planeMask.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Frustum#TestBox
+     *
+     * @param center box center, w is ignored.
+     * @param extent half size along each axis, w is ignored.
+     * @param planeMask same as for TestSphere.
+     * @return Outside, Intersect or Inside with respect to the tested planes.
+    */
+    Result TestBox(const Vector4& center, const Vector4& extent, uint8_t& planeMask) const;
+
+public:
+    /**
+     * @brief Writes indices of the spheres that are not outside. Order of the indices is ascending.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Frustum#CullSpheres
+     *
+     * @param spheres centers in x, y, z and radii in w.
+     * @param visible output indices, room for spheres.count values.
+     * @param planeMask planes to test, e.g. the mask left by TestSphere for the parent of the batch.
+     * @return Amount of visible spheres.
+    */
+    size_t CullSpheres(const Vector4Stream& spheres, uint32_t* visible, uint8_t planeMask = allPlanes) const;
+
+public:
+    /**
+     * @brief Writes indices of the axis-aligned boxes that are not outside. Order of the indices is ascending.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Frustum#CullBoxes
+     *
+     * @param centers box centers, w is ignored.
+     * @param extents half sizes, at least centers.count long. W is ignored.
+     * @param visible output indices, room for centers.count values.
+     * @param planeMask planes to test, e.g. the mask left by TestBox for the parent of the batch.
+     * @return Amount of visible boxes.
+    */
+    size_t CullBoxes(const Vector4Stream& centers, const Vector4Stream& extents, uint32_t* visible, uint8_t planeMask = allPlanes) const;
+};
+
+#endif
@@ -1,8 +1,28 @@
 #ifndef INTERPOLATION_H
 #define INTERPOLATION_H
+
+class FrameArena;
+
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
 class Interpolation {
+public:
+    // Largest amount of values of one interpolation, so that the value indices fit into int32_t.
+    static constexpr size_t maxCount = INT32_MAX;
+
+public:
+    // Edge values kept in a FrameArena, valid until the arena is reset.
+    struct EdgeValues {
+        // Values along the edge AC.
+        const float* ac;
+        size_t acCount;
+        // Values along the edges AB and BC, the value at B is stored once.
+        const float* abc;
+        size_t abcCount;
+    };
+
 public:
     /**
      * @brief Calculates intermediate values ​​of a linear function between points A and B.
@@ -18,6 +38,98 @@ public:
      * @return interpolated values. 
     */
     static std::vector<float> Linear(float xA, float yA, float xB, float yB, float step);
+public:
+    /**
+     * @brief Calculates the amount of values produced by Linear: floor((xB - xA) / step) + 1, or 0 when xB < xA.
+     * 
+     * Documentation: 
+     * 
+     * https://github.com/LeonidPreis/w-engine/blob/main/cpp_modules/interpolation/interplation.md
+     * @param xA coefficient x of point A.
+     * @param xB coefficient x of point B.
+     * @param step distance between the samples along x. Must be positive and finite, xA and xB finite,
+     * and the amount of values at most maxCount, otherwise std::invalid_argument is thrown.
+     * @return Exact amount of values.
+    */
+    static size_t LinearCount(float xA, float xB, float step);
+public:
+    /**
+     * @brief Writes intermediate values of a linear function between points A and B into a caller-provided buffer.
+     * 
+     * Value j is yA + j * step * slope, evaluated independently for every j, so there is no accumulated drift
+     * and the loop has no dependencies between iterations.
+     * 
+     * Documentation: 
+     * 
+     * https://github.com/LeonidPreis/w-engine/blob/main/cpp_modules/interpolation/interplation.md
+     * @note Time complexity: O(n). No allocations.
+     * @param xA coefficient x of point A. Must be less than xB.
+     * @param yA coefficient y of point A. 
+     * @param xB coefficient x of point B. 
+     * @param yB coefficient y of point B. 
+     * @param step distance between the samples along x. Must be positive.
+     * @param out destination buffer.
+     * @param capacity size of the destination buffer. At most capacity values are written.
+     * @return LinearCount(xA, xB, step), which may exceed capacity.
+    */
+    static size_t Linear(float xA, float yA, float xB, float yB, float step, float* out, size_t capacity);
+public:
+    /**
+     * @brief Same as the buffer overload of Linear, writes into an output iterator.
+     * 
+     * Documentation: 
+     * 
+     * https://github.com/LeonidPreis/w-engine/blob/main/cpp_modules/interpolation/interplation.md
+     * @return Iterator past the last written value.
+    */
+    template <class OutputIterator>
+    static OutputIterator Linear(float xA, float yA, float xB, float yB, float step, OutputIterator out) {
+        const size_t count = LinearCount(xA, xB, step);
+        const float increment = xA == xB ? 0.0f : (yB - yA) / (xB - xA) * step;
+        for (size_t j = 0; j < count; j++, ++out) {
+            *out = yA + static_cast<float>(j) * increment;
+        }
+        return out;
+    }
+public:
+    /**
+     * @brief Writes intermediate values of a linear function in 16.16 fixed point for the rasterization loops.
+     * 
+     * Value j is round(yA * 65536) + j * round(step * slope * 65536): one integer addition per value,
+     * error is at most (j + 1) / 131072. Values past the 16.16 range because of that error are clamped to it.
+     * 
+     * Documentation: 
+     * 
+     * https://github.com/LeonidPreis/w-engine/blob/main/cpp_modules/interpolation/interplation.md
+     * @note Time complexity: O(n). No allocations.
+     * @param xA coefficient x of point A. Must be less than xB.
+     * @param yA coefficient y of point A. Must fit into 16.16, otherwise std::invalid_argument is thrown.
+     * @param xB coefficient x of point B. 
+     * @param yB coefficient y of point B. Must fit into 16.16, otherwise std::invalid_argument is thrown.
+     * @param step distance between the samples along x. Must be positive.
+     * @param out destination buffer.
+     * @param capacity size of the destination buffer. At most capacity values are written.
+     * @return LinearCount(xA, xB, step), which may exceed capacity.
+    */
+    static size_t LinearFixed(float xA, float yA, float xB, float yB, float step, int32_t* out, size_t capacity);
+public:
+    /**
+     * @brief Same as the buffer overload of Linear, the values are allocated from a frame arena.
+     * 
+     * Documentation: 
+     * 
+     * https://github.com/LeonidPreis/w-engine/blob/main/cpp_modules/interpolation/interplation.md
+     * @note Time complexity: O(n). No heap allocations once the arena has grown to the frame size.
+     * @param xA coefficient x of point A. Must be less than xB.
+     * @param yA coefficient y of point A. 
+     * @param xB coefficient x of point B. 
+     * @param yB coefficient y of point B. 
+     * @param step distance between the samples along x. Must be positive.
+     * @param arena arena holding the values until its reset.
+     * @param count receives LinearCount(xA, xB, step).
+     * @return interpolated values.
+    */
+    static const float* Linear(float xA, float yA, float xB, float yB, float step, FrameArena& arena, size_t& count);
 public:
     /**
      * @brief Calculates the values ​​of the edges of the triangle between points A, B, C using three corresponding interpolations. X is a value dependent on Y.
@@ -35,6 +147,26 @@ public:
      * @return The vector of two vectors. First vector contains the interpolated values along the edge AC. Second vector contains the interpolated values along the edges AB and BC.
     */
     static std::vector<std::vector<float>> Edge(float xA, float yA, float xB, float yB, float xC, float yC, float step);
+public:
+    /**
+     * @brief Same as Edge, the values are written once into a frame arena instead of three temporary vectors:
+     * BC is written over the last value of AB.
+     * 
+     * Documentation: 
+     * 
+     * https://github.com/LeonidPreis/w-engine/blob/main/cpp_modules/interpolation/interplation.md
+     * @note Time complexity: O(n). No heap allocations once the arena has grown to the frame size.
+     * @param xA coefficient x of point A.
+     * @param yA coefficient y of point A. 
+     * @param xB coefficient x of point B. 
+     * @param yB coefficient y of point B. 
+     * @param xC coefficient x of point C. 
+     * @param yC coefficient y of point C.
+     * @param step distance between the samples along y. Must be positive.
+     * @param arena arena holding the values until its reset.
+     * @return Values along AC and along AB and BC, same as the two vectors returned by Edge.
+    */
+    static EdgeValues Edge(float xA, float yA, float xB, float yB, float xC, float yC, float step, FrameArena& arena);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,294 @@
+#ifndef MAT_H
+#define MAT_H
+
+#include "vec.h"
+#include <cstddef>
+#include <utility>
+
+// Elements of Mat in row-major order: an array in general, named m11 ... m44 for 4 x 4 so that Matrix4 keeps its
+// members. As for Vec, the named elements are indexed through a constexpr table of member pointers.
+template <typename T, size_t R, size_t C>
+struct MatElements {
+    T data[R * C];
+
+    constexpr T& Element(size_t r, size_t c) { return data[r * C + c]; }
+
+    constexpr const T& Element(size_t r, size_t c) const { return data[r * C + c]; }
+};
+
+template <typename T>
+struct MatElements<T, 4, 4> {
+    T m11, m12, m13, m14;
+    T m21, m22, m23, m24;
+    T m31, m32, m33, m34;
+    T m41, m42, m43, m44;
+
+    constexpr T& Element(size_t r, size_t c) { return this->*members[4 * r + c]; }
+
+    constexpr const T& Element(size_t r, size_t c) const { return this->*members[4 * r + c]; }
+
+    static constexpr T MatElements::* members[16] = {
+        &MatElements::m11, &MatElements::m12, &MatElements::m13, &MatElements::m14,
+        &MatElements::m21, &MatElements::m22, &MatElements::m23, &MatElements::m24,
+        &MatElements::m31, &MatElements::m32, &MatElements::m33, &MatElements::m34,
+        &MatElements::m41, &MatElements::m42, &MatElements::m43, &MatElements::m44
+    };
+};
+
+// R x C matrix over the scalars of Vec, the generic core of Matrix4 (column-vector convention: MultiplyVector
+// computes M * v). Mat is an aggregate filled row by row: Mat<float, 2, 2>{ 1, 2, 3, 4 }. Every product sums
+// from the first term to the last, the order the SIMD kernels of Matrix4 reproduce.
+template <typename T, size_t R, size_t C>
+class Mat: public MatElements<T, R, C> {
+public:
+    typedef T Scalar;
+    static constexpr size_t rowCount = R;
+    static constexpr size_t columnCount = C;
+
+public:
+    /**
+     * @brief Builds identity matrix. Only for square matrices.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Identity
+    */
+    static constexpr Mat Identity() {
+        static_assert(R == C, "Identity is defined for square matrices.");
+        return Generate([](size_t r, size_t c) { return r == c ? T(1) : T(0); });
+    }
+
+public:
+    /**
+     * @brief Clones the current matrix.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Clone
+    */
+    constexpr Mat Clone() const { return *this; }
+
+public:
+    /**
+     * @brief Checks exact equality of all elements.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Equals
+    */
+    constexpr bool Equals(const Mat& m) const {
+        return EqualsImpl(m, std::make_index_sequence<R * C>());
+    }
+
+public:
+    /**
+     * @brief Returns row r as a vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Row
+    */
+    constexpr Vec<T, C> Row(size_t r) const {
+        return Vec<T, C>::Generate([&](size_t c) { return this->Element(r, c); }, std::make_index_sequence<C>());
+    }
+
+public:
+    /**
+     * @brief Returns column c as a vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Column
+    */
+    constexpr Vec<T, R> Column(size_t c) const {
+        return Vec<T, R>::Generate([&](size_t r) { return this->Element(r, c); }, std::make_index_sequence<R>());
+    }
+
+public:
+    /**
+     * @brief Changes rows and columns of the matrix.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Transpose
+    */
+    constexpr Mat<T, C, R> Transpose() const {
+        return Mat<T, C, R>::Generate([&](size_t r, size_t c) { return this->Element(c, r); });
+    }
+
+public:
+    /**
+     * @brief Multiplies every element by a scalar.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Scale
+    */
+    constexpr Mat Scale(T scale) const {
+        return Generate([&](size_t r, size_t c) { return this->Element(r, c) * scale; });
+    }
+
+public:
+    /**
+     * @brief Element-wise sum.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Add
+    */
+    constexpr Mat Add(const Mat& m) const {
+        return Generate([&](size_t r, size_t c) { return this->Element(r, c) + m.Element(r, c); });
+    }
+
+public:
+    /**
+     * @brief Element-wise difference.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Subtract
+    */
+    constexpr Mat Subtract(const Mat& m) const {
+        return Generate([&](size_t r, size_t c) { return this->Element(r, c) - m.Element(r, c); });
+    }
+
+public:
+    /**
+     * @brief Multiplies current matrix by column-vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#MultiplyVector
+    */
+    constexpr Vec<T, R> MultiplyVector(const Vec<T, C>& v) const {
+        return Vec<T, R>::Generate([&](size_t r) { return SumImpl([&](size_t k) { return this->Element(r, k) * v[k]; },
+                                                                  std::make_index_sequence<C>()); },
+                                   std::make_index_sequence<R>());
+    }
+
+public:
+    /**
+     * @brief Calculates product of two matrices, the right operand is applied first.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#MultiplyMatrix
+    */
+    template <size_t K>
+    constexpr Mat<T, R, K> MultiplyMatrix(const Mat<T, C, K>& m) const {
+        return Mat<T, R, K>::Generate([&](size_t r, size_t k) {
+            return SumImpl([&](size_t i) { return this->Element(r, i) * m.Element(i, k); }, std::make_index_sequence<C>());
+        });
+    }
+
+public:
+    /**
+     * @brief Removes row and column, used by Determinant.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Minor
+    */
+    constexpr Mat<T, R - 1, C - 1> Minor(size_t row, size_t column) const {
+        static_assert(R > 1 && C > 1, "Minor needs at least two rows and columns.");
+        return Mat<T, R - 1, C - 1>::Generate([&](size_t r, size_t c) {
+            return this->Element(r < row ? r : r + 1, c < column ? c : c + 1);
+        });
+    }
+
+public:
+    /**
+     * @brief Computes the determinant by cofactor expansion along the first row. For 4 x 4 the 2 x 2 minors of the
+     * last two rows are shared between the terms.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Determinant
+    */
+    constexpr T Determinant() const {
+        static_assert(R == C, "Determinant is defined for square matrices.");
+        auto e = [&](size_t r, size_t c) { return this->Element(r - 1, c - 1); };
+        if constexpr (R == 1) {
+            return e(1, 1);
+        } else if constexpr (R == 2) {
+            return e(1, 1) * e(2, 2) - e(1, 2) * e(2, 1);
+        } else if constexpr (R == 4) {
+            const T m3344_3443 = e(3, 3) * e(4, 4) - e(3, 4) * e(4, 3);
+            const T m3244_3442 = e(3, 2) * e(4, 4) - e(3, 4) * e(4, 2);
+            const T m3243_3342 = e(3, 2) * e(4, 3) - e(3, 3) * e(4, 2);
+            const T m3144_3441 = e(3, 1) * e(4, 4) - e(3, 4) * e(4, 1);
+            const T m3143_3341 = e(3, 1) * e(4, 3) - e(3, 3) * e(4, 1);
+            const T m3142_3241 = e(3, 1) * e(4, 2) - e(3, 2) * e(4, 1);
+
+            return  e(1, 1) * (e(2, 2) * m3344_3443 - e(2, 3) * m3244_3442 + e(2, 4) * m3243_3342)-
+                    e(1, 2) * (e(2, 1) * m3344_3443 - e(2, 3) * m3144_3441 + e(2, 4) * m3143_3341)+
+                    e(1, 3) * (e(2, 1) * m3244_3442 - e(2, 2) * m3144_3441 + e(2, 4) * m3142_3241)-
+                    e(1, 4) * (e(2, 1) * m3243_3342 - e(2, 2) * m3143_3341 + e(2, 3) * m3142_3241);
+        } else {
+            T result = T(0);
+            for (size_t c = 0; c < C; c++) {
+                const T term = this->Element(0, c) * Minor(0, c).Determinant();
+                result = c % 2 == 0 ? result + term : result - term;
+            }
+            return result;
+        }
+    }
+
+public:
+    /**
+     * @brief Converts every element to another scalar type.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mat#Cast
+    */
+    template <typename U>
+    constexpr Mat<U, R, C> Cast() const {
+        return Mat<U, R, C>::Generate([&](size_t r, size_t c) { return static_cast<U>(this->Element(r, c)); });
+    }
+
+public:
+    template <typename F>
+    static constexpr Mat Generate(F f) {
+        return GenerateImpl(f, std::make_index_sequence<R * C>());
+    }
+
+private:
+    template <typename F, size_t... I>
+    static constexpr Mat GenerateImpl(F f, std::index_sequence<I...>) {
+        return Mat{ { static_cast<T>(f(I / C, I % C))... } };
+    }
+
+    template <typename F, size_t... I>
+    static constexpr T SumImpl(F f, std::index_sequence<I...>) {
+        return (... + f(I));
+    }
+
+    template <size_t... I>
+    constexpr bool EqualsImpl(const Mat& m, std::index_sequence<I...>) const {
+        return (... && (this->Element(I / C, I % C) == m.Element(I / C, I % C)));
+    }
+};
+
+// Element k is the dot product of the vector with column k, the same sums as MultiplyVector of the transpose.
+template <typename T, size_t N>
+template <size_t K>
+constexpr Vec<T, K> Vec<T, N>::MultiplyMatrix(const Mat<T, N, K>& m) const {
+    return m.Transpose().MultiplyVector(*this);
+}
+
+typedef Mat<float, 3, 3> Mat3f;
+typedef Mat<float, 4, 4> Mat4f;
+typedef Mat<double, 3, 3> Mat3d;
+typedef Mat<double, 4, 4> Mat4d;
+
+static_assert(sizeof(Mat4f) == 16 * sizeof(float), "Mat rows must be tightly packed.");
+static_assert(Mat<double, 3, 3>{ 2, 0, 0, 0, 3, 0, 1, 0, 4 }.Determinant() == 24, "Mat::Determinant");
+static_assert(Mat4d{ 2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 1, 2, 3, 1 }.Determinant() == 24, "Mat::Determinant");
+static_assert(Mat<float, 2, 3>{ 1, 2, 3, 4, 5, 6 }.MultiplyMatrix(Mat<float, 3, 2>{ 1, 0, 0, 1, 1, 1 })
+                  .Equals(Mat<float, 2, 2>{ 4, 5, 10, 11 }), "Mat::MultiplyMatrix");
+static_assert(Mat4d::Identity().MultiplyVector(Vec4d{ 1, 2, 3, 1 }).Equals(Vec4d{ 1, 2, 3, 1 }), "Mat::Identity");
+static_assert(Vec4d{ 1, 2, 3, 1 }.MultiplyMatrix(Mat4d{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1 }).Equals(Vec4d{ 6, 8, 10, 1 }),
+              "Vec::MultiplyMatrix must use the last row as translation for row-vectors.");
+
+#endif
@@ -1,29 +1,39 @@
 #ifndef MATRIX4_H
-#define MATRIX_4H
+#define MATRIX4_H
 
-class Vector4;
+class Vector4Stream;
 
+#include "mat.h"
+#include "vector4.h"
 #include <iostream>
 #include <optional>
-
-class Matrix4 {
+#include <cstddef>
+
+// True while the enclosing constexpr function is evaluated by the compiler, runtime calls take the SIMD kernels.
+#if defined(__GNUC__) || defined(__clang__)
+#define W_ENGINE_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define W_ENGINE_CONSTANT_EVALUATED() false
+#endif
+
+// Float 4 x 4 matrix for column-vectors. The arithmetic is that of Mat<float, 4, 4>, whose results convert back
+// implicitly. MultiplyVector and MultiplyMatrix take the SIMD kernels at runtime. Rows are contiguous and 16-byte
+// aligned, the kernels load them as m11, m21, m31, m41.
+class alignas(16) Matrix4: public Mat<float, 4, 4> {
 public: 
-    Matrix4(
+    constexpr Matrix4(
         float m11 = 1.0f, float m12 = 0.0f, float m13 = 0.0f, float m14 = 0.0f,
         float m21 = 0.0f, float m22 = 1.0f, float m23 = 0.0f, float m24 = 0.0f,
         float m31 = 0.0f, float m32 = 0.0f, float m33 = 1.0f, float m34 = 0.0f,
         float m41 = 0.0f, float m42 = 0.0f, float m43 = 0.0f, float m44 = 1.0f
-    ): 
-    m11(m11), m12(m12), m13(m13), m14(m14),
-    m21(m21), m22(m22), m23(m23), m24(m24),
-    m31(m31), m32(m32), m33(m33), m34(m34),
-    m41(m41), m42(m42), m43(m43), m44(m44) {}
+    ): Mat<float, 4, 4>{ {
+        m11, m12, m13, m14,
+        m21, m22, m23, m24,
+        m31, m32, m33, m34,
+        m41, m42, m43, m44
+    } } {}
 
-public:
-    float m11, m12, m13, m14;
-    float m21, m22, m23, m24;
-    float m31, m32, m33, m34;
-    float m41, m42, m43, m44;
+    constexpr Matrix4(const Mat<float, 4, 4>& m): Mat<float, 4, 4>(m) {}
 
 public:
     /**
@@ -37,70 +47,49 @@ public:
 
 public:
     /**
-     * @brief Clones the current matrix
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Clone
-     * 
-     * @return New Matrix.
-    */
-    Matrix4 Clone() const;
-
-public:
-    /**
-     * @brief Changes rows and columns of the matrix.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Transpose
+     * @brief Multiplies current matrix by column-vector.
      * 
-     * @return New transposed matrix.
-    */
-    Matrix4 Transpose() const;
-
-public:
-    /**
-     * @brief Computes the determinant of the matrix.
+     * Kernel is chosen by SIMD::Current(). Scalar, SSE2 and AVX2 results are bit-identical,
+     * FMA differs by at most 4 ulp of |m11*x| + |m12*y| + |m13*z| + |m14*w| per coefficient.
+     * In constant expressions the scalar formula is folded by the compiler.
      * 
      * Documentation:
      * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Determinant
+     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#MultiplyVector
      * 
-     * @return Scalar value of determinant.
+     * @param v vector to multiply. 
+     * @return New column-vector.
     */
-    float Determinant() const;
+    constexpr Vector4 MultiplyVector(const Vector4& v) const {
+        if (W_ENGINE_CONSTANT_EVALUATED()) return Mat<float, 4, 4>::MultiplyVector(v);
+        return MultiplyVectorRuntime(v);
+    }
 
 public:
     /**
-     * @brief Scales current matrix by a scalar value.
+     * @brief Multiplies current matrix by each column-vector of the stream.
      * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Scale
-     * 
-     * @param scale multiplyer.
-     * @return New scaled matrix.
-    */
-    Matrix4 Scale(const float& scale) const;
-
-public:
-    /**
-     * @brief Multiplies current matrix by column-vector.
+     * Processes 16 (AVX-512), 8 (AVX2) or 4 (SSE2) vectors per iteration, the tail is handled with masked
+     * loads or scalar code. Precision guarantees are the same as for MultiplyVector. In and out may alias.
      * 
      * Documentation:
      * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#MultiplyVector
+     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#TransformStream
      * 
-     * @param v vector to multiply. 
-     * @return New column-vector.
+     * @param in source vectors.
+     * @param out destination vectors.
+     * @param count amount of vectors to transform. Must not exceed in.count and out.count.
     */
-    Vector4 MultiplyVector(const Vector4& v) const;
+    void TransformStream(const Vector4Stream& in, Vector4Stream& out, size_t count) const;
 
 public:
     /**
      * @brief Calculates product of two matrices.
      * 
+     * Kernel is chosen by SIMD::Current(). Scalar, SSE2 and AVX2 results are bit-identical,
+     * FMA differs by at most 4 ulp of the sum of absolute products per element.
+     * In constant expressions the scalar formula is folded by the compiler.
+     * 
      * Documentation:
      * 
      * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#MultiplyMatrix
@@ -108,7 +97,10 @@ public:
      * @param m matrix to multiply.
      * @return product of f the matrices.
     */
-    Matrix4 MultiplyMatrix(const Matrix4& m) const;
+    constexpr Matrix4 MultiplyMatrix(const Matrix4& m) const {
+        if (W_ENGINE_CONSTANT_EVALUATED()) return Mat<float, 4, 4>::MultiplyMatrix(m);
+        return MultiplyMatrixRuntime(m);
+    }
 
 public:
     /**
@@ -124,42 +116,38 @@ public:
 
 public:
     /**
-     * @brief Multiplies current matrix by itself degree times.
+     * @brief Raises current matrix to the integer power.
+     * 
+     * Large powers of rigid matrices (rotation and translation) are computed as a screw motion: the rotation
+     * angle is multiplied by degree, the translation is rebuilt from the screw axis. Other matrices use
+     * binary exponentiation with O(log(degree)) multiplications. Negative degrees raise Inverse().
      * 
      * Documentation:
      * 
      * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Degree
      * 
-     * @param degree amount of the multiplications.
-     * @return New matrix.
+     * @param degree power. 0 returns identity.
+     * @return New matrix or identity when degree is negative and the matrix is singular.
     */
     Matrix4 Degree(int degree) const;
 
 public:
     /**
-     * Adds second matrix to the current matrix.
+     * @brief Checks that the bottom row is 0,0,0,1 and the upper 3x3 block is a proper rotation.
      * 
      * Documentation:
      * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Add
+     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#IsRigid
      * 
-     * @param m second matrix.
-     * @return Summ of the matrices.
+     * @param epsilon tolerance of the orthonormality and the bottom row.
+     * @return Boolean value.
     */
-    Matrix4 Add(const Matrix4& m) const;
+    bool IsRigid(float epsilon = 1e-4f) const;
 
-public:
-    /**
-     * @brief Subtracts second matrix from the current matrix.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Matrix4#Subtract
-     * 
-     * @param m second matrix.
-     * @return Differance of the matrices.
-    */
-    Matrix4 Subtract(const Matrix4& m) const;
+private:
+    Matrix4 MultiplyMatrixRuntime(const Matrix4& m) const;
+
+    Vector4 MultiplyVectorRuntime(const Vector4& v) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef MESH_H
+#define MESH_H
+
+class Matrix4;
+class FrameArena;
+
+#include "vector4.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Indexed triangle mesh over Vector4 positions. Triangles that share a vertex share its index, so a small cache of
+// transformed vertices, like the post-transform cache of a GPU, turns most repeated references into copies. The
+// triangle order decides how often that happens, OptimizeVertexCache reorders the triangles to make it frequent.
+class Mesh {
+public: enum class CachePolicy { FIFO, LRU };
+
+public:
+    struct CacheStats {
+        size_t triangles = 0;
+        // Distinct vertices referenced by the indices.
+        size_t vertices = 0;
+        // Vertices transformed, i.e. cache misses.
+        size_t transforms = 0;
+
+        // Average cache miss ratio: transforms per triangle, 3 without any reuse and about 0.5 at best for a closed mesh.
+        double ACMR() const { return triangles > 0 ? double(transforms) / triangles : 0.0; }
+
+        // Average transform to vertex ratio: 1 when every referenced vertex is transformed exactly once.
+        double ATVR() const { return vertices > 0 ? double(transforms) / vertices : 0.0; }
+    };
+
+public:
+    /**
+     * @brief Copies the vertices and indices.
+     *
+     * @param vertices positions.
+     * @param vertexCount amount of vertices. Every index must be below it.
+     * @param indices three indices per triangle.
+     * @param triangleCount amount of triangles.
+    */
+    Mesh(const Vector4* vertices, size_t vertexCount, const uint32_t* indices, size_t triangleCount);
+
+public:
+    const std::vector<Vector4>& Vertices() const;
+
+public:
+    const std::vector<uint32_t>& Indices() const;
+
+public:
+    size_t TriangleCount() const;
+
+public:
+    /**
+     * @brief Counts the transforms a post-transform cache would do for the current triangle order.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mesh#SimulateCache
+     *
+     * @param cacheSize amount of cached vertices, at least 1.
+     * @param policy FIFO evicts the vertex loaded first, hits do not refresh it. LRU evicts the least recently used one.
+     * @return Cache statistics, same as Transform with the same cache would return.
+    */
+    CacheStats SimulateCache(size_t cacheSize, CachePolicy policy = CachePolicy::FIFO) const;
+
+public:
+    /**
+     * @brief Transforms the triangle corners through a post-transform cache: only misses call Matrix4::MultiplyVector,
+     * hits copy the cached result.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mesh#Transform
+     *
+     * @param m transformation matrix for column-vectors.
+     * @param out transformed corners, three per triangle in index order. Room for 3 * TriangleCount() values.
+     * @param cacheSize amount of cached vertices, at least 1.
+     * @param policy replacement policy of the cache.
+     * @return Cache statistics.
+    */
+    CacheStats Transform(const Matrix4& m, Vector4* out, size_t cacheSize, CachePolicy policy = CachePolicy::FIFO) const;
+
+public:
+    /**
+     * @brief Same as Transform, the cache state is allocated from a frame arena and released before returning,
+     * so a frame that transforms many meshes does not touch the heap.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mesh#Transform
+     *
+     * @param arena arena of the calling thread.
+    */
+    CacheStats Transform(const Matrix4& m, Vector4* out, size_t cacheSize, CachePolicy policy, FrameArena& arena) const;
+
+public:
+    /**
+     * @brief Reorders the triangles for a post-transform cache with Forsyth's linear-speed algorithm.
+     *
+     * Every vertex is scored by its position in a simulated LRU cache and by the amount of triangles still using
+     * it, the next triangle is the one with the highest sum among the triangles of the cached vertices. Triangles
+     * keep their winding, the vertices are not moved.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Mesh#OptimizeVertexCache
+     *
+     * @param cacheSize size of the cache the order is tuned for, between 4 and 64. Orders tuned for 32 work
+     * well with larger caches and degrade gracefully on smaller ones.
+    */
+    void OptimizeVertexCache(size_t cacheSize = 32);
+
+private:
+    std::vector<Vector4> vertices;
+    std::vector<uint32_t> indices;
+};
+
+#endif
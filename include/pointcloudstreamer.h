@@ -0,0 +1,116 @@
+#ifndef POINTCLOUDSTREAMER_H
+#define POINTCLOUDSTREAMER_H
+
+class Vector4;
+class Quaternion;
+
+#include "matrix4.h"
+#include "frustum.h"
+#include "vector4stream.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+
+// Out-of-core transform of point clouds stored as packed little-endian float x, y, z triples. The input is read
+// in fixed-size chunks with two buffers: while chunk k is transformed, chunk k + 1 is read and chunk k - 1 is
+// written by asynchronous tasks, so with a fast enough transform the time is that of the disk. Memory use is
+// four chunk buffers regardless of the file size.
+class PointCloudStreamer {
+public:
+    static constexpr size_t defaultChunkSize = 1 << 20;
+
+public:
+    struct Stats {
+        size_t chunks = 0;
+        size_t pointsRead = 0;
+        size_t pointsWritten = 0;
+        // Time spent by the reading and writing tasks and by the transform, they overlap each other.
+        double readSeconds = 0.0;
+        double writeSeconds = 0.0;
+        double processSeconds = 0.0;
+        // Time the transform waited for the tasks.
+        double waitSeconds = 0.0;
+        double seconds = 0.0;
+
+        double PointsPerSecond() const { return seconds > 0.0 ? pointsRead / seconds : 0.0; }
+    };
+
+public:
+    /**
+     * @param chunkSize points per chunk, at least 1. The buffers take about 72 bytes per point.
+    */
+    PointCloudStreamer(size_t chunkSize = defaultChunkSize);
+
+public:
+    /**
+     * @brief Sets the transformation of the points, identity by default.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/PointCloudStreamer#SetTransform
+     *
+     * @param m affine transformation for column-vectors, points have w = 1.
+    */
+    void SetTransform(const Matrix4& m);
+
+public:
+    /**
+     * @brief Sets the transformation to a rotation followed by a translation. It is applied as one matrix.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/PointCloudStreamer#SetTransform
+     *
+     * @param rotation unit quaternion.
+     * @param translation offset added after the rotation, w is ignored.
+    */
+    void SetTransform(const Quaternion& rotation, const Vector4& translation);
+
+public:
+    /**
+     * @brief Keeps only the transformed points inside the frustum, tested with Frustum::CullSpheres.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/PointCloudStreamer#SetCulling
+    */
+    void SetCulling(const Frustum& frustum);
+
+public:
+    // Writes all points.
+    void ClearCulling();
+
+public:
+    /**
+     * @brief Streams the input file through the transform and the culling into the output file.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/PointCloudStreamer#Process
+     *
+     * @param input packed float x, y, z triples. The size must be a multiple of 12 bytes.
+     * @param output destination in the same format, replaced if it exists. Must not be the input file,
+     * also through another path or a link, std::invalid_argument otherwise.
+     * @return Statistics of the run.
+    */
+    Stats Process(const std::string& input, const std::string& output);
+
+private:
+    void ProcessChunk(const float* in, size_t count, float* out, size_t& written);
+
+private:
+    size_t chunkSize;
+    Matrix4 transform;
+    std::optional<Frustum> frustum;
+    // Deinterleaved chunk: x, y, z, w = 1 and zero radii for the culling, each chunkSize long.
+    Vector4Stream work;
+    std::vector<float> radii;
+    std::vector<uint32_t> visible;
+    // Packed x, y, z chunks, one of each pair is filled or drained by a task while the other is processed.
+    std::vector<float> inBuffers[2];
+    std::vector<float> outBuffers[2];
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef PROJECTION_H
+#define PROJECTION_H
+
+#include "matrix4.h"
+#include "frustum.h"
+
+// Projection matrices for column-vectors from a right-handed view space looking down -z into clip space. The depth
+// range matches Frustum, so Frustum(projection * view, depth) extracts the planes of the same volume.
+class Projection {
+public:
+    /**
+     * @brief Builds perspective projection, clip w is the view distance -z.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Projection#Perspective
+     *
+     * @param fovY vertical field of view in radians, between 0 and pi.
+     * @param aspect width / height of the viewport.
+     * @param near distance to the near plane, greater than 0.
+     * @param far distance to the far plane, greater than near.
+     * @param depth clip-space depth range.
+    */
+    static Matrix4 Perspective(float fovY, float aspect, float near, float far, Frustum::Depth depth = Frustum::Depth::NegativeOneToOne);
+
+public:
+    /**
+     * @brief Builds orthographic projection of the box [left, right] x [bottom, top] x [-far, -near], clip w is 1.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Projection#Orthographic
+     *
+     * @param depth clip-space depth range.
+    */
+    static Matrix4 Orthographic(float left, float right, float bottom, float top, float near, float far,
+                                Frustum::Depth depth = Frustum::Depth::NegativeOneToOne);
+};
+
+#endif
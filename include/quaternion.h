@@ -1,23 +1,27 @@
 #ifndef QUATERNION
 #define QUATERNION
 
-class Vector4;
+class Vector3;
 class Matrix4;
+class QuaternionStream;
+class Vector4Stream;
 
+#include "vector4.h"
 #include <iomanip>    
 #include <iostream>
 #include <cmath>
+#include <cstddef>
 
 //constexpr float radDeg = 57.295779513082320876;
 
 class Quaternion {
-public: Quaternion(float w = 0.0f, float x = 0.0f, float y = 0.0f, float z = 0.0f): w(w), x(x), y(y), z(z) {}
+public: constexpr Quaternion(float w = 0.0f, float x = 0.0f, float y = 0.0f, float z = 0.0f): w(w), x(x), y(y), z(z) {}
 
 public: float w, x, y, z;
 
 public: void Print(const int& precision) const;
 
-public: Quaternion Clone() const;
+public: constexpr Quaternion Clone() const { return Quaternion(w, x, y, z); }
 
 public: bool Equals(const Quaternion& q, const float& precision = 1e-6) const;
 
@@ -25,19 +29,29 @@ public: float Length() const;
 
 public: Quaternion Normalize() const;
 
-public: Quaternion& Conjugate();
+public: constexpr Quaternion& Conjugate() {
+    x = -x, y = -y, z = -z;
+    return *this;
+}
 
 public: Quaternion Inverse() const;
 
-public: Quaternion Add(const Quaternion& q) const;
+public: constexpr Quaternion Add(const Quaternion& q) const { return Quaternion(w + q.w, x + q.x, y + q.y, z + q.z); }
 
-public: Quaternion Subtract(const Quaternion q) const;
+public: constexpr Quaternion Subtract(const Quaternion q) const { return Quaternion(w - q.w, x - q.x, y - q.y, z - q.z); }
 
-public: Quaternion Scale(const float& scale) const;
+public: constexpr Quaternion Scale(const float& scale) const { return Quaternion(w * scale, x * scale, y * scale, z * scale); }
 
-public: Quaternion Multiply(const Quaternion& q) const;
+public: constexpr Quaternion Multiply(const Quaternion& q) const {
+    return Quaternion(
+        w * q.w - x * q.x - y * q.y - z * q.z,
+        w * q.x + x * q.w + y * q.z - z * q.y,
+        w * q.y - x * q.z + y * q.w + z * q.x,
+        w * q.z + x * q.y - y * q.x + z * q.w
+    );
+}
 
-public: float Dot(const Quaternion& q) const;
+public: constexpr float Dot(const Quaternion& q) const { return w * q.w + x * q.x + y * q.y + z * q.z; }
 
 public: float Angle(const Quaternion& q, const bool& degrees = false) const;
 
@@ -53,9 +67,40 @@ public: float ToYaw() const;
 
 public: Matrix4 ToRotationMatrix() const;
 
+// Computes q * v * q^-1 for any non-zero quaternion, w of the result is 0.
 public: Vector4 ApplyToVector(const Vector4& v) const;
 
-public: Quaternion Slerp(Quaternion& q, const float& t) const;
+// Rotation by a unit quaternion: t = 2 * cross(q.xyz, v), v' = v + w * t + cross(q.xyz, t). W of v is kept.
+public: constexpr Vector4 RotateVector(const Vector4& v) const {
+    const float tx = 2 * (y * v.z - z * v.y);
+    const float ty = 2 * (z * v.x - x * v.z);
+    const float tz = 2 * (x * v.y - y * v.x);
+    return Vector4(
+        v.x + w * tx + (y * tz - z * ty),
+        v.y + w * ty + (z * tx - x * tz),
+        v.z + w * tz + (x * ty - y * tx),
+        v.w
+    );
+}
+
+// RotateVector over count vectors of the stream, 8 per iteration with AVX2 and FMA. In and out may alias.
+public: void RotateStream(const Vector4Stream& in, Vector4Stream& out, size_t count) const;
+
+// RotateVector over arrays, transposed to 4-wide SoA blocks with SSE2. In and out may alias.
+public: void RotateVectors(const Vector4* in, Vector4* out, size_t count) const;
+
+public: void RotateVectors(const Vector3* in, Vector3* out, size_t count) const;
+
+public: Quaternion Slerp(const Quaternion& q, const float& t) const;
+
+// Exact evaluates Slerp per element, Polynomial replaces acos and sin with a fitted polynomial, components are off by at most 4e-5.
+public: enum class Precision { Exact, Polynomial };
+
+// out[i] = Slerp(a[i], b[i], t[i]) for unit quaternions and t in [0, 1], 8 lanes per iteration with AVX2 and FMA. Out may alias a or b.
+public: static void SlerpStream(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t count, Precision precision = Precision::Polynomial);
+
+// Normalized linear interpolation along the shorter arc. Cheaper than Slerp, angular velocity is not constant.
+public: static void NlerpStream(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t count);
 
 public: static Quaternion FromAngleAxis(const float& angleRadians, const Vector4& axis);
 
@@ -0,0 +1,59 @@
+#ifndef QUATERNIONSTREAM_H
+#define QUATERNIONSTREAM_H
+
+class Quaternion;
+
+#include "soa4storage.h"
+#include <cstddef>
+
+// Structure-of-arrays quaternions, the component arrays and their ownership are those of SoA4Storage.
+class QuaternionStream: public SoA4Storage {
+public:
+    QuaternionStream(size_t count = 0);
+
+public:
+    /**
+     * @brief Wraps external component arrays without copying. The stream does not own them.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/QuaternionStream#View
+     *
+     * @param w,x,y,z component arrays, at least count elements each.
+     * @param count amount of quaternions.
+     * @return Non-owning stream.
+    */
+    static QuaternionStream View(float* w, float* x, float* y, float* z, size_t count);
+
+public:
+    /**
+     * @brief Returns a non-owning stream over quaternions [offset, offset + count).
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/QuaternionStream#Slice
+    */
+    QuaternionStream Slice(size_t offset, size_t count) const;
+
+public:
+    /**
+     * @brief Gathers quaternion at index i.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/QuaternionStream#Get
+    */
+    Quaternion Get(size_t i) const;
+
+public:
+    /**
+     * @brief Scatters quaternion to index i.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/QuaternionStream#Set
+    */
+    void Set(size_t i, const Quaternion& q);
+};
+
+#endif
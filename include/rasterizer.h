@@ -0,0 +1,55 @@
+#ifndef RASTERIZER_H
+#define RASTERIZER_H
+
+class Vector4;
+class Framebuffer;
+
+#include <cstdint>
+#include <cstddef>
+
+class Rasterizer {
+public:
+    // Vertices are snapped to 1/16 pixel, the edge functions stay exact for coordinates below this limit.
+    static constexpr float coordinateLimit = 32768.0f;
+
+public:
+    /**
+     * @brief Fills a screen-space triangle scanline by scanline.
+     *
+     * Vertices are snapped to 1/16 pixel, on every row the covered span is solved exactly from the integer edge
+     * functions, so nothing is allocated and the coverage is the same as the one of TiledRasterizer. Pixel
+     * centers lying on a top or left edge are filled, on a bottom or right edge are not, so triangles sharing
+     * an edge never fill a pixel twice. Depth is interpolated linearly and tested with less-than when the
+     * framebuffer has a depth plane. Triangles with a vertex outside of [-coordinateLimit, coordinateLimit] or
+     * a NaN coordinate are skipped and must be clipped beforehand.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Rasterizer#DrawTriangle
+     *
+     * @param framebuffer target planes.
+     * @param a,b,c vertices: x and y in pixels, z depth. w is ignored.
+     * @param color fill color.
+     * @return Amount of written pixels.
+    */
+    static size_t DrawTriangle(Framebuffer& framebuffer, const Vector4& a, const Vector4& b, const Vector4& c, uint32_t color);
+
+public:
+    /**
+     * @brief Fills indexed triangle list.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Rasterizer#DrawTriangles
+     *
+     * @param framebuffer target planes.
+     * @param vertices screen-space vertices.
+     * @param indices three indices per triangle.
+     * @param triangleCount amount of triangles.
+     * @param color fill color.
+     * @return Amount of written pixels.
+    */
+    static size_t DrawTriangles(Framebuffer& framebuffer, const Vector4* vertices, const uint32_t* indices, size_t triangleCount, uint32_t color);
+};
+
+#endif
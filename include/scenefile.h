@@ -0,0 +1,156 @@
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+class Matrix4;
+
+#include "vector4stream.h"
+#include "quaternionstream.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Binary container of scene data, memory-mapped and consumed without parsing or copying.
+//
+// Layout, all values little-endian:
+//   header, 64 bytes: magic "WSCENE\0\0", uint32 version, uint32 section count, uint64 file size, zero padding;
+//   section table, 32 bytes per section: uint32 type, uint32 component arrays, uint64 count, uint64 offset,
+//   uint64 stride in bytes between the component arrays;
+//   section data, every component array starts on a 64-byte boundary of the file.
+// Positions, normals and quaternions are stored as four component arrays (x, y, z, w and w, x, y, z), the
+// layout of Vector4Stream and QuaternionStream. Indices are one uint32 array, matrices one array of row-major
+// Matrix4 records. Readers skip unknown section types; versions change only with incompatible layouts.
+class SceneFile {
+public: enum class Section : uint32_t { Positions = 1, Normals = 2, Indices = 3, Matrices = 4, Quaternions = 5 };
+
+public:
+    static constexpr uint32_t version = 1;
+    static constexpr size_t alignment = 64;
+
+public:
+    // Data for Write, absent sections are null.
+    struct Contents {
+        const Vector4Stream* positions = nullptr;
+        const Vector4Stream* normals = nullptr;
+        const uint32_t* indices = nullptr;
+        size_t indexCount = 0;
+        const Matrix4* matrices = nullptr;
+        size_t matrixCount = 0;
+        const QuaternionStream* quaternions = nullptr;
+    };
+
+public:
+    /**
+     * @brief Maps the file and validates the header and the section table. Pages are read on first access.
+     *
+     * The mapping is copy-on-write: the views may be modified in place, changes stay in memory and never reach
+     * the file. Section contents, such as index ranges, are not validated.
+     *
+     * @param path file written by Write.
+    */
+    explicit SceneFile(const std::string& path);
+
+    SceneFile(const SceneFile&) = delete;
+
+    SceneFile& operator=(const SceneFile&) = delete;
+
+    SceneFile(SceneFile&& file) noexcept;
+
+    ~SceneFile();
+
+public:
+    /**
+     * @brief Writes the sections present in contents into a new file.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SceneFile#Write
+     *
+     * @param path destination, replaced if it exists.
+     * @param contents sections to write.
+    */
+    static void Write(const std::string& path, const Contents& contents);
+
+public:
+    /**
+     * @brief Checks whether the file contains the section.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SceneFile#Has
+    */
+    bool Has(Section section) const;
+
+public:
+    /**
+     * @brief Non-owning stream over the mapped positions, empty when the section is absent.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SceneFile#Positions
+     *
+     * @note Time complexity: O(1). Valid while the file is open.
+    */
+    Vector4Stream Positions() const;
+
+public:
+    /**
+     * @brief Non-owning stream over the mapped normals, empty when the section is absent.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SceneFile#Normals
+     *
+     * @note Time complexity: O(1). Valid while the file is open.
+    */
+    Vector4Stream Normals() const;
+
+public:
+    /**
+     * @brief Non-owning stream over the mapped quaternions, empty when the section is absent.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SceneFile#Quaternions
+     *
+     * @note Time complexity: O(1). Valid while the file is open.
+    */
+    QuaternionStream Quaternions() const;
+
+public:
+    // Mapped indices, three per triangle, or null when the section is absent.
+    const uint32_t* Indices() const;
+
+public:
+    size_t IndexCount() const;
+
+public:
+    // Mapped matrices or null when the section is absent.
+    const Matrix4* Matrices() const;
+
+public:
+    size_t MatrixCount() const;
+
+public:
+    // Size of the file in bytes.
+    size_t Size() const;
+
+private:
+    struct Mapped {
+        unsigned char* data = nullptr;
+        size_t count = 0;
+        size_t stride = 0;
+    };
+
+private:
+    const Mapped& Get(Section section) const;
+
+    float* Component(Section section, size_t component) const;
+
+private:
+    unsigned char* data = nullptr;
+    size_t size = 0;
+    // Indexed by section type - 1.
+    Mapped sections[5];
+};
+
+#endif
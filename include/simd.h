@@ -0,0 +1,70 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define W_ENGINE_X86 1
+#include <immintrin.h>
+#define W_ENGINE_TARGET(features) __attribute__((target(features)))
+#else
+#define W_ENGINE_X86 0
+#define W_ENGINE_TARGET(features)
+#endif
+
+#include <atomic>
+
+class SIMD {
+public: enum class Level { Scalar, SSE2, AVX2, FMA, AVX512 };
+
+public:
+    /**
+     * @brief Queries CPUID for the widest instruction set supported by the processor.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SIMD#Detect
+     *
+     * @return Highest available level. Scalar on non-x86 targets.
+    */
+    static Level Detect();
+
+public:
+    /**
+     * @brief Returns the level used by the dispatched kernels. Detected once on first call.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SIMD#Current
+     *
+     * @return Active level.
+    */
+    static Level Current();
+
+public:
+    /**
+     * @brief Forces the kernels to a lower level, e.g. to compare a vector path against the scalar one.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SIMD#SetLevel
+     *
+     * @param level requested level. Clamped to the detected one.
+     * @return Level that was actually set.
+    */
+    static Level SetLevel(Level level);
+
+public:
+    /**
+     * @brief Converts level to the printable name.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SIMD#LevelToString
+    */
+    static const char* LevelToString(Level level);
+
+private:
+    // Read by every kernel dispatch from any thread, written by SetLevel.
+    static std::atomic<Level>& Active();
+};
+
+#endif
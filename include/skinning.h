@@ -0,0 +1,93 @@
+#ifndef SKINNING_H
+#define SKINNING_H
+
+class Matrix4;
+class ThreadPool;
+class Vector4Stream;
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Deforms SoA vertex streams by a joint palette. Vertices are split into chunks executed on the pool,
+// inside a chunk 8 vertices are skinned per iteration with AVX2 and FMA, the rest with scalar code.
+class Skinning {
+public:
+    static constexpr size_t maxInfluences = 8;
+
+public:
+    // Joint indices and weights stored influence-major: joints[k * stride + vertex] is the k-th joint of the vertex.
+    // Weights of a vertex must sum to 1, unused influences have weight 0.
+    struct Influences {
+        const uint16_t* joints;
+        const float* weights;
+        size_t count;
+        size_t stride;
+    };
+
+public:
+    /**
+     * @param pool workers executing the chunks. Must outlive the skinning.
+     * @param chunkSize vertices per job. Rounded up to 16 so that chunks never share an output cache line.
+    */
+    Skinning(ThreadPool& pool, size_t chunkSize = 2048);
+
+public:
+    /**
+     * @brief Linear blend skinning: every vertex is transformed by the weighted sum of its joint matrices.
+     *
+     * Normals are transformed by the upper 3x3 block of the blended matrix and normalized, which is exact
+     * for palettes without non-uniform scale.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Skinning#LinearBlend
+     *
+     * @param palette skinning matrices for column-vectors, usually world * inverse bind pose.
+     * @param jointCount amount of matrices. Every joint index must be below it.
+     * @param influences joint indices and weights, count between 1 and maxInfluences.
+     * @param positions bind pose positions.
+     * @param outPositions deformed positions, at least positions.count long. May alias positions.
+     * @param normals bind pose normals or nullptr.
+     * @param outNormals deformed normals, required when normals are given. May alias normals.
+    */
+    void LinearBlend(const Matrix4* palette, size_t jointCount, const Influences& influences,
+                     const Vector4Stream& positions, Vector4Stream& outPositions,
+                     const Vector4Stream* normals = nullptr, Vector4Stream* outNormals = nullptr);
+
+public:
+    /**
+     * @brief Dual quaternion skinning: joint transforms are blended as unit dual quaternions, which keeps
+     * volume at twisted joints where linear blending collapses.
+     *
+     * Every joint is converted once per call. Quaternions of the influences are aligned to the hemisphere of the
+     * first one before blending.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Skinning#DualQuaternion
+     *
+     * @param palette rigid skinning matrices for column-vectors. Scale and shear are discarded.
+     * @param jointCount amount of matrices. Every joint index must be below it.
+     * @param influences joint indices and weights, count between 1 and maxInfluences.
+     * @param positions bind pose positions.
+     * @param outPositions deformed positions, at least positions.count long. May alias positions.
+     * @param normals bind pose normals or nullptr.
+     * @param outNormals deformed normals, required when normals are given. May alias normals.
+    */
+    void DualQuaternion(const Matrix4* palette, size_t jointCount, const Influences& influences,
+                        const Vector4Stream& positions, Vector4Stream& outPositions,
+                        const Vector4Stream* normals = nullptr, Vector4Stream* outNormals = nullptr);
+
+private:
+    void Validate(size_t jointCount, const Influences& influences, const Vector4Stream& positions, const Vector4Stream& outPositions,
+                  const Vector4Stream* normals, const Vector4Stream* outNormals) const;
+
+private:
+    ThreadPool& pool;
+    size_t chunkSize;
+    // Joints repacked per call: 12 floats (rows of a 3x4 matrix) or 8 floats (real and dual quaternion).
+    std::vector<float> joints;
+};
+
+#endif
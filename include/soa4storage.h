@@ -0,0 +1,53 @@
+#ifndef SOA4STORAGE_H
+#define SOA4STORAGE_H
+
+#include <cstddef>
+
+// Storage of the structure-of-arrays streams: four float component arrays of count elements. An owning storage
+// keeps them in one aligned allocation, a view points into arrays owned elsewhere.
+class SoA4Storage {
+public:
+    // Each component array starts on a 64-byte boundary so AVX2 and AVX-512 loads never split a cache line.
+    static constexpr size_t alignment = 64;
+
+public:
+    float* x;
+    float* y;
+    float* z;
+    float* w;
+    size_t count;
+
+public:
+    /**
+     * @brief Checks whether the storage owns its component arrays.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/SoA4Storage#Owns
+    */
+    bool Owns() const;
+
+protected:
+    // Zero-initialized owning storage, or an empty view when count is 0.
+    SoA4Storage(size_t count);
+
+    // A copy always owns its arrays, also when copied from a view.
+    SoA4Storage(const SoA4Storage& storage);
+
+    // The moved-from storage is left empty, not as a view of the arrays it no longer owns.
+    SoA4Storage(SoA4Storage&& storage) noexcept;
+
+    SoA4Storage& operator=(const SoA4Storage& storage);
+
+    SoA4Storage& operator=(SoA4Storage&& storage) noexcept;
+
+    ~SoA4Storage();
+
+private:
+    void Swap(SoA4Storage& storage) noexcept;
+
+private:
+    float* data;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+class ThreadPool {
+public:
+    /**
+     * @param threads amount of workers including the calling thread. 0 - one per hardware thread.
+    */
+    ThreadPool(size_t threads = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+public:
+    /**
+     * @brief Amount of workers. The thread calling Run is worker 0.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/ThreadPool#Size
+    */
+    size_t Size() const;
+
+public:
+    /**
+     * @brief Executes task(job, worker) for every job in [0, jobs) and waits for completion.
+     *
+     * Jobs are dealt to the workers in contiguous blocks, a worker that runs out of its own jobs
+     * steals from the back of the other queues. The first exception thrown by a task is rethrown here.
+     * Run is not reentrant: tasks must not call Run of the same pool.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/ThreadPool#Run
+     *
+     * @param jobs amount of jobs.
+     * @param task callable receiving job index and worker index.
+    */
+    void Run(size_t jobs, const std::function<void(size_t job, size_t worker)>& task);
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<size_t> jobs;
+    };
+
+private:
+    void Loop(size_t worker);
+
+    void Work(size_t worker);
+
+    bool Pop(size_t worker, size_t& job);
+
+private:
+    std::vector<std::thread> threads;
+    std::unique_ptr<Queue[]> queues;
+    size_t size;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    size_t generation = 0;
+    bool stopping = false;
+
+    const std::function<void(size_t, size_t)>* task = nullptr;
+    std::atomic<size_t> remaining{0};
+    std::exception_ptr error;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef TILEDRASTERIZER_H
+#define TILEDRASTERIZER_H
+
+class Vector4;
+class ThreadPool;
+class Framebuffer;
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class TiledRasterizer {
+public:
+    static constexpr int tileSize = 64;
+    static constexpr int blockSize = 8;
+    // Vertices are snapped to 1/16 pixel, the edge functions stay exact for coordinates below this limit.
+    static constexpr float coordinateLimit = 32768.0f;
+
+public:
+    /**
+     * @param pool workers binning triangles and rasterizing tiles. Must outlive the rasterizer.
+    */
+    TiledRasterizer(ThreadPool& pool);
+
+public:
+    /**
+     * @brief Fills indexed triangle list using screen tiles processed in parallel.
+     *
+     * Binning pass sorts triangles into 64x64 tiles by bounding box, then every tile is rasterized by one
+     * worker, so no two threads touch the same pixel. Inside a tile 8x8 blocks are trivially rejected or
+     * accepted by edge functions at the block corners, partially covered blocks are tested 8 pixels at a
+     * time (AVX2 when available). Triangles keep submission order within a tile. Coverage, fill rule and depth
+     * test match Rasterizer::DrawTriangle, both snap the vertices to 1/16 pixel. Triangles with a vertex outside
+     * of [-coordinateLimit, coordinateLimit] are skipped and must be clipped beforehand.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TiledRasterizer#DrawTriangles
+     *
+     * @param framebuffer target planes.
+     * @param vertices screen-space vertices: x and y in pixels, z depth.
+     * @param indices three indices per triangle.
+     * @param triangleCount amount of triangles.
+     * @param color fill color.
+     * @return Amount of written pixels.
+    */
+    size_t DrawTriangles(Framebuffer& framebuffer, const Vector4* vertices, const uint32_t* indices, size_t triangleCount, uint32_t color);
+
+public:
+    // Edge functions a * x + b * y + c in 1/16 pixel units, positive inside. Empty box marks a skipped triangle.
+    struct Setup {
+        int32_t a[3], b[3];
+        int64_t c[3];
+        int minX, minY, maxX, maxY;
+        float zOrigin, dzdx, dzdy;
+    };
+
+private:
+    ThreadPool& pool;
+    std::vector<Setup> setups;
+    // bins[chunk][tile] lists triangles of the binning chunk overlapping the tile. Kept between calls.
+    std::vector<std::vector<std::vector<uint32_t>>> bins;
+};
+
+#endif
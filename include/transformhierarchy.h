@@ -0,0 +1,141 @@
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include "matrix4.h"
+#include "vector4.h"
+#include "quaternion.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Parent/child chains of local translation-rotation-scale transforms. Nodes live in flat arrays sorted
+// breadth-first, so every parent precedes its children and Update is a single forward sweep.
+class TransformHierarchy {
+public:
+    typedef uint32_t Node;
+    static constexpr Node none = 0xFFFFFFFFu;
+
+public:
+    /**
+     * @brief Adds node with the identity world matrix until the next Update.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#AddNode
+     *
+     * @param parent existing node or none for a root.
+     * @param translation local translation, w is ignored.
+     * @param rotation local rotation. Must be normalized.
+     * @param scale local scale per axis, w is ignored.
+     * @return Handle of the node. Handles stay valid when the arrays are reordered.
+    */
+    Node AddNode(Node parent = none, const Vector4& translation = Vector4(), const Quaternion& rotation = Quaternion(1.0f), const Vector4& scale = Vector4(1.0f, 1.0f, 1.0f));
+
+public:
+    /**
+     * @brief Amount of nodes.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#Size
+    */
+    size_t Size() const;
+
+public:
+    /**
+     * @brief Replaces local translation and marks the subtree dirty.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#SetTranslation
+    */
+    void SetTranslation(Node node, const Vector4& translation);
+
+public:
+    /**
+     * @brief Replaces local rotation and marks the subtree dirty.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#SetRotation
+    */
+    void SetRotation(Node node, const Quaternion& rotation);
+
+public:
+    /**
+     * @brief Replaces local scale and marks the subtree dirty.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#SetScale
+    */
+    void SetScale(Node node, const Vector4& scale);
+
+public:
+    /**
+     * @brief Returns parent of the node or none.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#Parent
+    */
+    Node Parent(Node node) const;
+
+public:
+    /**
+     * @brief Builds the local matrix T * R * S for column-vectors.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#Local
+    */
+    Matrix4 Local(Node node) const;
+
+public:
+    /**
+     * @brief Returns the world matrix computed by the last Update.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#World
+    */
+    const Matrix4& World(Node node) const;
+
+public:
+    /**
+     * @brief Recomputes world matrices of dirty nodes and their descendants only.
+     *
+     * The sweep starts at the first dirty slot. A node is recomputed when it or its parent changed,
+     * the flag of the parent is always already known because of the breadth-first order.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformHierarchy#Update
+     *
+     * @return Amount of recomputed world matrices.
+    */
+    size_t Update();
+
+private:
+    void MarkDirty(uint32_t slot);
+
+    void SortBreadthFirst();
+
+private:
+    // Slot-indexed arrays in breadth-first order.
+    std::vector<uint32_t> parents;
+    std::vector<Vector4> translations;
+    std::vector<Quaternion> rotations;
+    std::vector<Vector4> scales;
+    std::vector<Matrix4> worlds;
+    std::vector<uint8_t> dirty;
+
+    std::vector<uint32_t> slots;
+    std::vector<Node> nodes;
+
+    size_t firstDirty = 0;
+    bool unsorted = false;
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef TRANSFORMPIPELINE_H
+#define TRANSFORMPIPELINE_H
+
+class Vector4;
+class Matrix4;
+class ThreadPool;
+class Vector4Stream;
+
+#include <vector>
+#include <cstddef>
+
+class TransformPipeline {
+public: enum class Convention { ColumnVector, RowVector };
+
+public:
+    struct alignas(64) WorkerStats {
+        size_t chunks = 0;
+        size_t vectors = 0;
+        double seconds = 0.0;
+
+        double VectorsPerSecond() const { return seconds > 0.0 ? vectors / seconds : 0.0; }
+    };
+
+public:
+    /**
+     * @param pool workers executing the chunks. Must outlive the pipeline.
+     * @param chunkSize vectors per job. Rounded up to 16 so that chunks never share an output cache line.
+    */
+    TransformPipeline(ThreadPool& pool, size_t chunkSize = 4096);
+
+public:
+    /**
+     * @brief Transforms SoA stream by Matrix4::TransformStream in parallel chunks.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformPipeline#Transform
+     *
+     * @param m transformation matrix.
+     * @param in source vectors.
+     * @param out destination vectors, at least in.count long. May alias in.
+    */
+    void Transform(const Matrix4& m, const Vector4Stream& in, Vector4Stream& out);
+
+public:
+    /**
+     * @brief Transforms vertex buffer in parallel chunks with Matrix4::MultiplyVector (column-vectors)
+     * or Vector4::MultiplyMatrix (row-vectors).
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformPipeline#Transform
+     *
+     * @param m transformation matrix.
+     * @param in source vectors.
+     * @param out destination vectors. May alias in.
+     * @param count amount of vectors.
+     * @param convention side of the multiplication.
+    */
+    void Transform(const Matrix4& m, const Vector4* in, Vector4* out, size_t count, Convention convention = Convention::ColumnVector);
+
+public:
+    /**
+     * @brief Returns per-worker counters accumulated since the last ResetStats.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformPipeline#Stats
+    */
+    const std::vector<WorkerStats>& Stats() const;
+
+public:
+    /**
+     * @brief Clears per-worker counters.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformPipeline#ResetStats
+    */
+    void ResetStats();
+
+public:
+    /**
+     * @brief Outputs per-worker throughput to the console.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/TransformPipeline#PrintStats
+    */
+    void PrintStats(const int& precision = 3) const;
+
+private:
+    ThreadPool& pool;
+    size_t chunkSize;
+    std::vector<WorkerStats> stats;
+};
+
+#endif
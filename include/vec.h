@@ -0,0 +1,345 @@
+#ifndef VEC_H
+#define VEC_H
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+template <typename T, size_t R, size_t C>
+class Mat;
+
+// Components of Vec: an array in general, named x, y, z, w for 2 to 4 components so that Vector3 and Vector4
+// keep their members. Indexing the named components goes through a table of member pointers, which is constexpr
+// and folds to a plain offset whenever the index is a constant.
+template <typename T, size_t N>
+struct VecComponents {
+    T data[N];
+
+    constexpr T& operator[](size_t i) { return data[i]; }
+
+    constexpr const T& operator[](size_t i) const { return data[i]; }
+};
+
+template <typename T>
+struct VecComponents<T, 2> {
+    T x, y;
+
+    constexpr T& operator[](size_t i) { return this->*members[i]; }
+
+    constexpr const T& operator[](size_t i) const { return this->*members[i]; }
+
+    static constexpr T VecComponents::* members[2] = { &VecComponents::x, &VecComponents::y };
+};
+
+template <typename T>
+struct VecComponents<T, 3> {
+    T x, y, z;
+
+    constexpr T& operator[](size_t i) { return this->*members[i]; }
+
+    constexpr const T& operator[](size_t i) const { return this->*members[i]; }
+
+    static constexpr T VecComponents::* members[3] = { &VecComponents::x, &VecComponents::y, &VecComponents::z };
+};
+
+template <typename T>
+struct VecComponents<T, 4> {
+    T x, y, z, w;
+
+    constexpr T& operator[](size_t i) { return this->*members[i]; }
+
+    constexpr const T& operator[](size_t i) const { return this->*members[i]; }
+
+    static constexpr T VecComponents::* members[4] = { &VecComponents::x, &VecComponents::y, &VecComponents::z, &VecComponents::w };
+};
+
+// Fixed-size vector over any scalar with +, -, * and construction from int: float, double, _Float16, BFloat16,
+// Fixed. Every operation is expanded over std::index_sequence, so there are no runtime loops and the result is
+// constexpr whenever the scalar arithmetic is. Vec is an aggregate: Vec<float, 3>{ 1, 2, 3 }. Length, Normalize,
+// Project and Angle also need / and the square root of the scalar, they are instantiated only when called.
+template <typename T, size_t N>
+class Vec: public VecComponents<T, N> {
+public:
+    static_assert(N > 0, "Vec needs at least one component.");
+
+    typedef T Scalar;
+    static constexpr size_t size = N;
+
+public:
+    /**
+     * @brief Builds vector with every component equal to value.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Fill
+    */
+    static constexpr Vec Fill(T value) {
+        return Generate([&](size_t) { return value; }, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Clones the current vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Clone
+    */
+    constexpr Vec Clone() const { return *this; }
+
+public:
+    /**
+     * @brief Checks exact equality of all components.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Equals
+    */
+    constexpr bool Equals(const Vec& v) const {
+        return EqualsImpl(v, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Negates all components of the current vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Negate
+     *
+     * @return Reference to the current vector. Operation is mutable.
+    */
+    constexpr Vec& Negate() {
+        *this = Generate([&](size_t i) { return -(*this)[i]; }, std::make_index_sequence<N>());
+        return *this;
+    }
+
+public:
+    /**
+     * @brief Multiplies every component by a scalar.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Scale
+    */
+    constexpr Vec Scale(T scale) const {
+        return Generate([&](size_t i) { return (*this)[i] * scale; }, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Component-wise sum.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Add
+    */
+    constexpr Vec Add(const Vec& v) const {
+        return Generate([&](size_t i) { return (*this)[i] + v[i]; }, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Component-wise difference.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Subtract
+    */
+    constexpr Vec Subtract(const Vec& v) const {
+        return Generate([&](size_t i) { return (*this)[i] - v[i]; }, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Component-wise product.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Multiply
+    */
+    constexpr Vec Multiply(const Vec& v) const {
+        return Generate([&](size_t i) { return (*this)[i] * v[i]; }, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Multiplies current row-vector by matrix, the generic counterpart of Vector4::MultiplyMatrix.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#MultiplyMatrix
+    */
+    // Defined in mat.h.
+    template <size_t K>
+    constexpr Vec<T, K> MultiplyMatrix(const Mat<T, N, K>& m) const;
+
+public:
+    /**
+     * @brief Dot product, summed from the first component to the last.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Dot
+    */
+    constexpr T Dot(const Vec& v) const {
+        return DotImpl(v, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Squared length.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#LengthSquared
+    */
+    constexpr T LengthSquared() const { return Dot(*this); }
+
+public:
+    /**
+     * @brief Calculates length of the vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Length
+    */
+    T Length() const {
+        using std::sqrt;
+        return static_cast<T>(sqrt(LengthSquared()));
+    }
+
+public:
+    /**
+     * @brief Brings the vector to unit length if length not equal zero.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Normalize
+     *
+     * @return New vector, zero vector when the length is zero.
+    */
+    Vec Normalize() const {
+        const T length = Length();
+        if (length == T(0)) return Fill(T(0));
+        return Generate([&](size_t i) { return (*this)[i] / length; }, std::make_index_sequence<N>());
+    }
+
+public:
+    /**
+     * @brief Calculates a vector that is perpendicular to two source vectors, from the first three components.
+     * For N == 4 the fourth component of the result is 0.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Cross
+    */
+    constexpr Vec Cross(const Vec& v) const {
+        static_assert(N == 3 || N == 4, "Cross is defined for 3 and 4 component vectors.");
+        const Vec& u = *this;
+        Vec result = Fill(T(0));
+        result[0] = u[1] * v[2] - u[2] * v[1];
+        result[1] = u[2] * v[0] - u[0] * v[2];
+        result[2] = u[0] * v[1] - u[1] * v[0];
+        return result;
+    }
+
+public:
+    /**
+     * @brief Calculates the length of the projection of the current vector onto second vector.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Project
+     *
+     * @return Length of the projection, 0 when the second vector is zero.
+    */
+    T Project(const Vec& v) const {
+        const T length = v.Length();
+        if (length == T(0)) return T(0);
+        return Dot(v) / length;
+    }
+
+public:
+    /**
+     * @brief Calculates the angle between two vectors in radians or degrees.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Angle
+     *
+     * @param degrees taken into account when returning the value. Default - false (return value in radians).
+     * @return Angle between vectors, 0 when one of them is zero.
+    */
+    T Angle(const Vec& v, bool degrees = false) const {
+        const T lengths = Length() * v.Length();
+        if (lengths == T(0)) return T(0);
+        const double angle = std::acos(static_cast<double>(Dot(v) / lengths));
+        return static_cast<T>(degrees ? angle * 57.295779513082320876f : angle);
+    }
+
+public:
+    /**
+     * @brief Calculates the vector reflected relative to the normal.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Reflect
+     *
+     * @param normal vector of the normal. Must be normalized.
+    */
+    constexpr Vec Reflect(const Vec& normal) const { return Subtract(normal.Scale(T(2) * Dot(normal))); }
+
+public:
+    /**
+     * @brief Converts every component to another scalar type, e.g. from _Float16 storage to float for computation.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vec#Cast
+    */
+    template <typename U>
+    constexpr Vec<U, N> Cast() const {
+        return Vec<U, N>::Generate([&](size_t i) { return static_cast<U>((*this)[i]); }, std::make_index_sequence<N>());
+    }
+
+public:
+    template <typename F, size_t... I>
+    static constexpr Vec Generate(F f, std::index_sequence<I...>) {
+        return Vec{ { static_cast<T>(f(I))... } };
+    }
+
+private:
+    template <size_t... I>
+    constexpr bool EqualsImpl(const Vec& v, std::index_sequence<I...>) const {
+        return (... && ((*this)[I] == v[I]));
+    }
+
+    template <size_t... I>
+    constexpr T DotImpl(const Vec& v, std::index_sequence<I...>) const {
+        return (... + ((*this)[I] * v[I]));
+    }
+};
+
+typedef Vec<float, 2> Vec2f;
+typedef Vec<float, 3> Vec3f;
+typedef Vec<float, 4> Vec4f;
+typedef Vec<double, 2> Vec2d;
+typedef Vec<double, 3> Vec3d;
+typedef Vec<double, 4> Vec4d;
+
+#if defined(__FLT16_MAX__)
+typedef Vec<_Float16, 3> Vec3h;
+typedef Vec<_Float16, 4> Vec4h;
+#endif
+
+static_assert(sizeof(Vec4f) == 4 * sizeof(float), "Vec must not be padded, arrays of Vec are arrays of scalars.");
+static_assert(sizeof(Vec<float, 5>) == 5 * sizeof(float), "Vec must not be padded, arrays of Vec are arrays of scalars.");
+static_assert(Vec3f{ 1, 0, 0 }.Cross(Vec3f{ 0, 1, 0 }).Equals(Vec3f{ 0, 0, 1 }), "Vec::Cross must be right-handed.");
+static_assert(Vec3f{ 0, 0, 1 }.Cross(Vec3f{ 1, 0, 0 }).Equals(Vec3f{ 0, 1, 0 }), "Vec::Cross must be right-handed.");
+static_assert(Vec3d{ 1, 2, 3 }.Cross(Vec3d{ 4, 5, 6 }).Equals(Vec3d{ -3, 6, -3 }), "Vec::Cross");
+static_assert(Vec4d{ 1, 2, 3, 4 }.Dot(Vec4d::Fill(2)) == 20, "Vec::Dot");
+static_assert(Vec<double, 5>{ 1, 2, 3, 4, 5 }.Add(Vec<double, 5>::Fill(1)).Equals(Vec<double, 5>{ 2, 3, 4, 5, 6 }), "Vec::Add");
+static_assert(Vec3f{ 1, -1, 0 }.Reflect(Vec3f{ 0, 1, 0 }).Equals(Vec3f{ 1, 1, 0 }), "Vec::Reflect");
+
+#endif
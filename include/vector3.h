@@ -1,17 +1,16 @@
 #ifndef VECTOR3_H
 #define VECTOR3_H
 
-#include <cmath>
+#include "vec.h"
 #include <iostream>
 
-const float radDeg = 57.295779513082320876;
-
-class Vector3 {
+// Float 3D vector. The arithmetic is that of Vec<float, 3>, the methods returning a vector are redeclared here so
+// that their results stay Vector3 and calls can be chained: a.Cross(b).Normalize().Print().
+class Vector3: public Vec<float, 3> {
 public:
-    Vector3(float x = 0, float y = 0, float z = 0): x(x), y(y), z(z) {}
+    constexpr Vector3(float x = 0, float y = 0, float z = 0): Vec<float, 3>{ { x, y, z } } {}
 
-public:
-    float x, y, z;
+    constexpr Vector3(const Vec<float, 3>& v): Vec<float, 3>(v) {}
 
 public:
     /**
@@ -21,159 +20,90 @@ public:
      * 
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Print
     */
-    void Print();
+    void Print() const;
 
 public:
     /**
      * @brief Clones the current vector.
-     * 
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Clone
-     * 
-     * @return New vector. Operation is non-mutable.
-    */
-    Vector3 Clone() const;
-
-public:
-    /**
-     * @brief Checks the equality of vectors.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Equals
-     * @param v second vector.
-     * @return Boolean value.
     */
-    bool Equals(const Vector3& v) const;
+    constexpr Vector3 Clone() const { return *this; }
 
 public:
     /**
-     * @brief Changes the signs of the x,y,z coefficients. Mutable operation.
-     * 
+     * @brief Negates all components of the current vector. Operation is mutable.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Negate
     */
-    Vector3& Negate();
+    constexpr Vector3& Negate() {
+        Vec<float, 3>::Negate();
+        return *this;
+    }
 
 public:
     /**
-     * @brief Calculates length of the vector.
-     * 
+     * @brief Brings the vector to unit length if length not equal zero, zero vector otherwise.
+     *
      * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Length
-     * @return Length value of the vector.
-    */
-    float Length() const;
-
-public:
-    /**
-     * @brief Brings the vector to unit length if length not equal zero.
-     * 
-     * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Normalize
     */
-    Vector3 Normalize();
+    Vector3 Normalize() const { return Vec<float, 3>::Normalize(); }
 
 public:
     /**
-     * @brief Multiplies each vector coefficient by a scalar.
-     * 
+     * @brief Multiplies every component by a scalar.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Scale
-     * @param scale multiplier.
-     * @return New scaled vector.
     */
-    Vector3 Scale(const float& scale) const;
+    constexpr Vector3 Scale(float scale) const { return Vec<float, 3>::Scale(scale); }
 
 public:
     /**
-     * @brief Adds vector B to the current vector.
-     * 
+     * @brief Component-wise sum.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Add
-     * @param v second vector.
-     * @return New vector. Operation is non-mutable.
     */
-    Vector3 Add(const Vector3& v);
+    constexpr Vector3 Add(const Vec<float, 3>& v) const { return Vec<float, 3>::Add(v); }
 
 public:
     /**
-     * @brief Subtracts vector B from the current vector.
-     * 
+     * @brief Component-wise difference.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Subtract
-     * @param v second vector.
-     * @return New vector. Operation is non-mutable.
-    */
-    Vector3 Subtract(const Vector3& v);
-
-public:
-    /**
-     * @brief Calculates a dot product of two vectors.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Dot
-     * @param v second vector.
-     * @return Dot product.
     */
-    float Dot(const Vector3& v);
+    constexpr Vector3 Subtract(const Vec<float, 3>& v) const { return Vec<float, 3>::Subtract(v); }
 
 public:
     /**
      * @brief Calculates a vector that is perpendicular to two source vectors.
-     * 
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Cross
-     * @param v second vector.
-     * @return New vector. Operation is non-mutable.
     */
-    Vector3 Cross(const Vector3& v);
+    constexpr Vector3 Cross(const Vec<float, 3>& v) const { return Vec<float, 3>::Cross(v); }
 
 public:
     /**
-     * @brief Calculates the length of the projection of the current vector onto vector B.
-     * 
+     * @brief Calculates the vector reflected relative to the normal, which must be normalized.
+     *
      * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Project
-     * @param v second vector.
-     * @return Length of the projections.
-    */
-    float Project(const Vector3& v);
-
-public:
-    /**
-     * @brief Calculates the angle between two vectors in radians or degrees.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Angle
-     * @param v second vector.
-     * @param degrees taken into account when returning the value. Dafault - false (return value in radians).
-     * @return Angle between vectors.
-    */
-    float Angle(const Vector3& v, bool degrees = false);
-
-public:
-    /**
-     * @brief Calculates the vector reflected relative to the normal.
-     * 
-     * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector3#Reflect
-     * @param normal vector of the normal. Must be normalized.
-     * @return Reflected vector.
     */
-    Vector3 Reflect(const Vector3& normal);
+    constexpr Vector3 Reflect(const Vec<float, 3>& normal) const { return Vec<float, 3>::Reflect(normal); }
 };
 
-#endif
\ No newline at end of file
+#endif
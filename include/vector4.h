@@ -1,19 +1,17 @@
 #ifndef VECTOR4_H
 #define VECTOR4_H
 
-class Matrix4;
-
-#include <cmath>
+#include "vec.h"
+#include "mat.h"
 #include <iostream>
 
-constexpr float radDeg = 57.295779513082320876;
-
-class Vector4 {
+// Float homogeneous vector. The arithmetic is that of Vec<float, 4>, the methods returning a vector are redeclared
+// here so that their results stay Vector4. MultiplyMatrix with a Matrix4 is the row-vector product of Vec.
+class Vector4: public Vec<float, 4> {
 public:
-    Vector4(float x = 0, float y = 0, float z = 0, float w = 0): x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(float x = 0, float y = 0, float z = 0, float w = 0): Vec<float, 4>{ { x, y, z, w } } {}
 
-public:
-    float x, y, z, w;
+    constexpr Vector4(const Vec<float, 4>& v): Vec<float, 4>(v) {}
 
 public:
     /**
@@ -23,172 +21,100 @@ public:
      * 
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Print
     */
-    void Print();
+    void Print() const;
 
 public:
     /**
      * @brief Clones the current vector.
-     * 
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Clone
-     * 
-     * @return New vector. 
     */
-    Vector4 Clone() const;
+    constexpr Vector4 Clone() const { return *this; }
 
 public:
     /**
-     * @brief Checks the equality of vectors.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Equals
-     * 
-     * @param v second vector.
-     * @return Boolean value.
-    */
-    bool Equals(const Vector4& v) const;
-
-public:
-    /**
-     * @brief Changes the signs of the x,y,z coefficients.
-     * 
+     * @brief Negates all components of the current vector. Operation is mutable.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Negate
     */
-    Vector4& Negate();
-
-public:
-    /**
-     * @brief Calculates length of the vector.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Length
-     * @return Length value of the vector.
-    */
-    float Length() const;
+    constexpr Vector4& Negate() {
+        Vec<float, 4>::Negate();
+        return *this;
+    }
 
 public:
     /**
-     * @brief Brings the vector to unit length if length not equal zero.
-     * 
+     * @brief Brings the vector to unit length if length not equal zero, zero vector otherwise.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Normalize
     */
-    Vector4 Normalize() const;
+    Vector4 Normalize() const { return Vec<float, 4>::Normalize(); }
 
 public:
     /**
-     * @brief Multiplies each vector coefficient by a scalar.
-     * 
+     * @brief Multiplies every component by a scalar.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Scale
-     * @param scale multiplier.
-     * @return New vector. Operation is non-mutable.
     */
-    Vector4 Scale(const float& scale) const;
+    constexpr Vector4 Scale(float scale) const { return Vec<float, 4>::Scale(scale); }
 
 public:
     /**
-     * @brief Multiplyes current vector by matrix.
-     * 
+     * @brief Multiplies current row-vector by matrix.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#MultiplyMatrix
-     * @param m matrix 4x4.
-     * @return New row-vector.
     */
-    Vector4 MultiplyMatrix(const Matrix4& m) const;
+    constexpr Vector4 MultiplyMatrix(const Mat<float, 4, 4>& m) const { return Vec<float, 4>::MultiplyMatrix(m); }
 
 public:
     /**
-     * @brief Adds second vector to the current vector.
-     * 
+     * @brief Component-wise sum.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Add
-     * @param v second vector.
-     * @return New vector. Operation is non-mutable.
     */
-    Vector4 Add(const Vector4& v) const;
+    constexpr Vector4 Add(const Vec<float, 4>& v) const { return Vec<float, 4>::Add(v); }
 
 public:
     /**
-     * @brief Subtracts second vector from the current vector.
-     * 
+     * @brief Component-wise difference.
+     *
      * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Subtract
-     * @param v second vector.
-     * @return New vector. Operation is non-mutable.
     */
-    Vector4 Subtract(const Vector4& v) const;
+    constexpr Vector4 Subtract(const Vec<float, 4>& v) const { return Vec<float, 4>::Subtract(v); }
 
 public:
     /**
-     * @brief Calculates a dot product of two vectors.
-     * 
+     * @brief Calculates a vector that is perpendicular to two source vectors. W of the result is 0.
+     *
      * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Dot
-     * @param v second vector.
-     * @return Dot product.
-    */
-    float Dot(const Vector4& v) const;
-
-public:
-    /**
-     * @brief Calculates a vector that is perpendicular to two source vectors.
-     * 
-     * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Cross
-     * @param v second vector.
-     * @return New vector. Operation is non-mutable.
     */
-    Vector4 Cross(const Vector4& v);
+    constexpr Vector4 Cross(const Vec<float, 4>& v) const { return Vec<float, 4>::Cross(v); }
 
 public:
     /**
-     * @brief Calculates the length of the projection of the current vector onto second vector.
-     * 
+     * @brief Calculates the vector reflected relative to the normal, which must be normalized.
+     *
      * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Project
-     * @param v second vector.
-     * @return Length of the projection.
-    */
-    float Project(const Vector4& v);
-
-public:
-    /**
-     * @brief Calculates the angle between two vectors in radians or degrees.
-     * 
-     * Documentation:
-     * 
-     * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Angle
-     * @param v second vector.
-     * @param degrees taken into account when returning the value. Dafault - false (return value in radians).
-     * @return Angle between vectors.
-    */
-    float Angle(const Vector4& v, bool degrees = false);
-
-public:
-    /**
-     * @brief Calculates the vector reflected relative to the normal.
-     * 
-     * Documentation:
-     * 
+     *
      * https://github.com/LeonidPreis/w-engine/wiki/Vector4#Reflect
-     * @param normal vector of the normal. Must be normalized.
-     * @return Reflected vector.
     */
-    Vector4 Reflect(const Vector4& normal);
+    constexpr Vector4 Reflect(const Vec<float, 4>& normal) const { return Vec<float, 4>::Reflect(normal); }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,59 @@
+#ifndef VECTOR4STREAM_H
+#define VECTOR4STREAM_H
+
+class Vector4;
+
+#include "soa4storage.h"
+#include <cstddef>
+
+// Structure-of-arrays vectors, the component arrays and their ownership are those of SoA4Storage.
+class Vector4Stream: public SoA4Storage {
+public:
+    Vector4Stream(size_t count = 0);
+
+public:
+    /**
+     * @brief Wraps external component arrays without copying. The stream does not own them.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vector4Stream#View
+     *
+     * @param x,y,z,w component arrays, at least count elements each.
+     * @param count amount of vectors.
+     * @return Non-owning stream.
+    */
+    static Vector4Stream View(float* x, float* y, float* z, float* w, size_t count);
+
+public:
+    /**
+     * @brief Returns a non-owning stream over vectors [offset, offset + count).
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vector4Stream#Slice
+    */
+    Vector4Stream Slice(size_t offset, size_t count) const;
+
+public:
+    /**
+     * @brief Gathers vector at index i.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vector4Stream#Get
+    */
+    Vector4 Get(size_t i) const;
+
+public:
+    /**
+     * @brief Scatters vector to index i.
+     *
+     * Documentation:
+     *
+     * https://github.com/LeonidPreis/w-engine/wiki/Vector4Stream#Set
+    */
+    void Set(size_t i, const Vector4& v);
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "../include/affine3x4.h"
+#include "../include/vector4.h"
+#include "../include/matrix4.h"
+#include <iomanip>
+#include <iostream>
+
+void Affine3x4::Print(const int& precision) const {
+    std::cout << std::fixed << std::setprecision(precision) << "Affine3x4[[ m11: " << m11 << " m12: " << m12 << " m13: " << m13 << " m14: " << m14 << " ]," << std::endl;
+    std::cout << std::fixed << std::setprecision(precision) << "          [ m21: " << m21 << " m22: " << m22 << " m23: " << m23 << " m24: " << m24 << " ]," << std::endl;
+    std::cout << std::fixed << std::setprecision(precision) << "          [ m31: " << m31 << " m32: " << m32 << " m33: " << m33 << " m34: " << m34 << " ]]\n" << std::endl;
+}
+
+Affine3x4 Affine3x4::FromMatrix4(const Matrix4& m) {
+    return Affine3x4(
+        m.m11, m.m12, m.m13, m.m14,
+        m.m21, m.m22, m.m23, m.m24,
+        m.m31, m.m32, m.m33, m.m34
+    );
+}
+
+Matrix4 Affine3x4::ToMatrix4() const {
+    return Matrix4(
+        m11, m12, m13, m14,
+        m21, m22, m23, m24,
+        m31, m32, m33, m34,
+        0.0f, 0.0f, 0.0f, 1.0f
+    );
+}
+
+float Affine3x4::Determinant() const {
+    return m11 * (m22 * m33 - m23 * m32) -
+           m12 * (m21 * m33 - m23 * m31) +
+           m13 * (m21 * m32 - m22 * m31);
+}
+
+Vector4 Affine3x4::MultiplyVector(const Vector4& v) const {
+    return Vector4(
+        m11 * v.x + m12 * v.y + m13 * v.z + m14 * v.w,
+        m21 * v.x + m22 * v.y + m23 * v.z + m24 * v.w,
+        m31 * v.x + m32 * v.y + m33 * v.z + m34 * v.w,
+        v.w
+    );
+}
+
+Affine3x4 Affine3x4::MultiplyAffine(const Affine3x4& m) const {
+    return Affine3x4(
+        m11 * m.m11 + m12 * m.m21 + m13 * m.m31,
+        m11 * m.m12 + m12 * m.m22 + m13 * m.m32,
+        m11 * m.m13 + m12 * m.m23 + m13 * m.m33,
+        m11 * m.m14 + m12 * m.m24 + m13 * m.m34 + m14,
+        m21 * m.m11 + m22 * m.m21 + m23 * m.m31,
+        m21 * m.m12 + m22 * m.m22 + m23 * m.m32,
+        m21 * m.m13 + m22 * m.m23 + m23 * m.m33,
+        m21 * m.m14 + m22 * m.m24 + m23 * m.m34 + m24,
+        m31 * m.m11 + m32 * m.m21 + m33 * m.m31,
+        m31 * m.m12 + m32 * m.m22 + m33 * m.m32,
+        m31 * m.m13 + m32 * m.m23 + m33 * m.m33,
+        m31 * m.m14 + m32 * m.m24 + m33 * m.m34 + m34
+    );
+}
+
+std::optional<Affine3x4> Affine3x4::Inverse() const {
+    const float c11 = m22 * m33 - m23 * m32;
+    const float c12 = m23 * m31 - m21 * m33;
+    const float c13 = m21 * m32 - m22 * m31;
+    const float determinant = m11 * c11 + m12 * c12 + m13 * c13;
+
+    if (determinant == 0) {
+        return std::nullopt;
+    }
+
+    const float d = 1.0f / determinant;
+    const float i11 = d * c11, i12 = d * (m13 * m32 - m12 * m33), i13 = d * (m12 * m23 - m13 * m22);
+    const float i21 = d * c12, i22 = d * (m11 * m33 - m13 * m31), i23 = d * (m13 * m21 - m11 * m23);
+    const float i31 = d * c13, i32 = d * (m12 * m31 - m11 * m32), i33 = d * (m11 * m22 - m12 * m21);
+
+    return Affine3x4(
+        i11, i12, i13, -(i11 * m14 + i12 * m24 + i13 * m34),
+        i21, i22, i23, -(i21 * m14 + i22 * m24 + i23 * m34),
+        i31, i32, i33, -(i31 * m14 + i32 * m24 + i33 * m34)
+    );
+}
+
+Affine3x4 Affine3x4::InverseRigid() const {
+    return Affine3x4(
+        m11, m21, m31, -(m11 * m14 + m21 * m24 + m31 * m34),
+        m12, m22, m32, -(m12 * m14 + m22 * m24 + m32 * m34),
+        m13, m23, m33, -(m13 * m14 + m23 * m24 + m33 * m34)
+    );
+}
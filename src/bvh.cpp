@@ -0,0 +1,424 @@
+#include "../include/bvh.h"
+#include "../include/threadpool.h"
+#include "../include/vector4stream.h"
+#include <deque>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+// Traversal stack entries. Build switches to median splits below medianDepth, so no tree is deeper than
+// medianDepth + 32 for up to 2^31 triangles.
+static const size_t stackSize = 96;
+static const size_t medianDepth = 48;
+static const int binCount = 16;
+// Subtrees with fewer triangles are built by a single job.
+static const size_t parallelGrain = 4096;
+
+struct Bounds {
+    Vector3 min = Vector3(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+    Vector3 max = Vector3(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity());
+
+    void Grow(const Vector3& p) {
+        min = Vector3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max = Vector3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+
+    void Grow(const Bounds& b) {
+        min = Vector3(std::min(min.x, b.min.x), std::min(min.y, b.min.y), std::min(min.z, b.min.z));
+        max = Vector3(std::max(max.x, b.max.x), std::max(max.y, b.max.y), std::max(max.z, b.max.z));
+    }
+
+    // Half of the surface area, the heuristic only compares ratios.
+    float Area() const {
+        if (min.x > max.x) return 0;
+        const float dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+static float Axis(const Vector3& v, int axis) {
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+// Triangle as seen by the build. Primitives are partitioned in place, so every pass reads them sequentially.
+struct Primitive {
+    Bounds bounds;
+    Vector3 centroid;
+    uint32_t triangle;
+};
+
+// Top-down binned SAH build over an array of primitives.
+struct Builder {
+    Primitive* primitives;
+    size_t maxLeafSize;
+
+    // Computes bounds of primitives[begin, end) and partitions them. Returns the first index of the right child, end for a leaf.
+    size_t Split(size_t begin, size_t end, size_t depth, Bounds& nodeBounds) const {
+        Bounds centroidBounds;
+        for (size_t i = begin; i < end; i++) {
+            nodeBounds.Grow(primitives[i].bounds);
+            centroidBounds.Grow(primitives[i].centroid);
+        }
+        const size_t count = end - begin;
+        if (count == 1) return end;
+
+        if (depth >= medianDepth) return count <= maxLeafSize ? end : SplitMedian(begin, end, centroidBounds);
+
+        // All three axes are binned in one pass over the triangles. Small nodes use fewer bins, sweeping all of them
+        // would cost more than the binning itself.
+        const int bins = count < binCount ? static_cast<int>(count) : binCount;
+        float lo[3], scale[3];
+        for (int axis = 0; axis < 3; axis++) {
+            lo[axis] = Axis(centroidBounds.min, axis);
+            const float extent = Axis(centroidBounds.max, axis) - lo[axis];
+            scale[axis] = extent > 0 ? bins / extent : 0;
+        }
+        Bounds binBounds[3][binCount];
+        size_t binCounts[3][binCount] = {};
+        for (size_t i = begin; i < end; i++) {
+            const Vector3& centroid = primitives[i].centroid;
+            const Bounds& triangle = primitives[i].bounds;
+            const int bin[3] = {
+                std::min(bins - 1, static_cast<int>((centroid.x - lo[0]) * scale[0])),
+                std::min(bins - 1, static_cast<int>((centroid.y - lo[1]) * scale[1])),
+                std::min(bins - 1, static_cast<int>((centroid.z - lo[2]) * scale[2]))
+            };
+            for (int axis = 0; axis < 3; axis++) {
+                binBounds[axis][bin[axis]].Grow(triangle);
+                binCounts[axis][bin[axis]]++;
+            }
+        }
+
+        // Traversal and intersection are weighted equally: leaf = count * area, split = area + left + right.
+        float bestCost = std::numeric_limits<float>::infinity();
+        int bestAxis = -1, bestBin = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            if (scale[axis] == 0) continue;
+
+            // Sweep from the right to get the cost of every right side, then from the left for the splits.
+            float rightCost[binCount];
+            Bounds right;
+            size_t rightCount = 0;
+            for (int bin = bins - 1; bin > 0; bin--) {
+                right.Grow(binBounds[axis][bin]);
+                rightCount += binCounts[axis][bin];
+                rightCost[bin] = rightCount * right.Area();
+            }
+            Bounds left;
+            size_t leftCount = 0;
+            for (int bin = 1; bin < bins; bin++) {
+                left.Grow(binBounds[axis][bin - 1]);
+                leftCount += binCounts[axis][bin - 1];
+                const float cost = leftCount * left.Area() + rightCost[bin];
+                if (leftCount > 0 && leftCount < count && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        const float area = nodeBounds.Area();
+        if (bestAxis < 0) return count <= maxLeafSize ? end : SplitMedian(begin, end, centroidBounds);
+        if (count <= maxLeafSize && area + bestCost >= count * area) return end;
+
+        const Primitive* middle = std::partition(primitives + begin, primitives + end, [&](const Primitive& primitive) {
+            const float c = Axis(primitive.centroid, bestAxis);
+            return std::min(bins - 1, static_cast<int>((c - lo[bestAxis]) * scale[bestAxis])) < bestBin;
+        });
+        return middle - primitives;
+    }
+
+    // Object median along the widest centroid axis. Always makes progress, also for coincident centroids.
+    size_t SplitMedian(size_t begin, size_t end, const Bounds& centroidBounds) const {
+        const Vector3 extent = centroidBounds.max.Subtract(centroidBounds.min);
+        const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+        const size_t middle = begin + (end - begin) / 2;
+        std::nth_element(primitives + begin, primitives + middle, primitives + end, [&](const Primitive& a, const Primitive& b) {
+            return Axis(a.centroid, axis) < Axis(b.centroid, axis);
+        });
+        return middle;
+    }
+
+    void Subtree(std::vector<BVH::Node>& nodes, size_t index, size_t begin, size_t end, size_t depth) const {
+        Bounds nodeBounds;
+        const size_t middle = Split(begin, end, depth, nodeBounds);
+        nodes[index].min = nodeBounds.min;
+        nodes[index].max = nodeBounds.max;
+        if (middle == end) {
+            nodes[index].leftOrFirst = static_cast<uint32_t>(begin);
+            nodes[index].count = static_cast<uint32_t>(end - begin);
+            return;
+        }
+
+        const size_t left = nodes.size();
+        nodes.resize(left + 2);
+        nodes[index].leftOrFirst = static_cast<uint32_t>(left);
+        nodes[index].count = 0;
+        Subtree(nodes, left, begin, middle, depth + 1);
+        Subtree(nodes, left + 1, middle, end, depth + 1);
+    }
+};
+
+BVH::BVH(ThreadPool& pool, size_t chunkSize):
+    pool(pool), chunkSize((chunkSize + 15) / 16 * 16) {
+    if (this->chunkSize == 0) this->chunkSize = 16;
+}
+
+void BVH::Build(const Vector3* vertices, size_t vertexCount, const uint32_t* indices, size_t triangleCount, size_t maxLeafSize) {
+    if (maxLeafSize == 0 || maxLeafSize > 16) {
+        throw std::invalid_argument("BVH leaves must hold between 1 and 16 triangles.");
+    }
+    if (triangleCount > maxTriangleCount) {
+        throw std::out_of_range("BVH supports at most 2^31 triangles.");
+    }
+    for (size_t i = 0; i < 3 * triangleCount; i++) {
+        if (indices[i] >= vertexCount) throw std::out_of_range("BVH triangle index is out of the vertex range.");
+    }
+
+    nodes.clear();
+    triangles.clear();
+    triangleIndices.clear();
+    if (triangleCount == 0) return;
+
+    std::vector<Primitive> primitives(triangleCount);
+    const size_t chunks = (triangleCount + chunkSize - 1) / chunkSize;
+    pool.Run(chunks, [&](size_t chunk, size_t) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = begin + chunkSize < triangleCount ? begin + chunkSize : triangleCount;
+        for (size_t i = begin; i < end; i++) {
+            Primitive& primitive = primitives[i];
+            primitive.bounds.Grow(vertices[indices[3 * i]]);
+            primitive.bounds.Grow(vertices[indices[3 * i + 1]]);
+            primitive.bounds.Grow(vertices[indices[3 * i + 2]]);
+            primitive.centroid = primitive.bounds.min.Add(primitive.bounds.max).Scale(0.5f);
+            primitive.triangle = static_cast<uint32_t>(i);
+        }
+    });
+
+    const Builder builder{ primitives.data(), maxLeafSize };
+
+    // Split the first levels breadth-first until there are a few subtrees per worker, then build those in parallel.
+    struct Task {
+        size_t node, begin, end, depth;
+    };
+    std::deque<Task> pending{ Task{ 0, 0, triangleCount, 0 } };
+    std::vector<Task> tasks;
+    nodes.resize(1);
+    const size_t taskTarget = 4 * pool.Size();
+    while (!pending.empty()) {
+        const Task task = pending.front();
+        pending.pop_front();
+        if (task.end - task.begin < parallelGrain || tasks.size() + pending.size() + 1 >= taskTarget) {
+            tasks.push_back(task);
+            continue;
+        }
+
+        Bounds nodeBounds;
+        const size_t middle = builder.Split(task.begin, task.end, task.depth, nodeBounds);
+        Node& node = nodes[task.node];
+        node.min = nodeBounds.min;
+        node.max = nodeBounds.max;
+        if (middle == task.end) {
+            node.leftOrFirst = static_cast<uint32_t>(task.begin);
+            node.count = static_cast<uint32_t>(task.end - task.begin);
+            continue;
+        }
+        const size_t left = nodes.size();
+        node.leftOrFirst = static_cast<uint32_t>(left);
+        node.count = 0;
+        nodes.resize(left + 2);
+        pending.push_back(Task{ left, task.begin, middle, task.depth + 1 });
+        pending.push_back(Task{ left + 1, middle, task.end, task.depth + 1 });
+    }
+
+    std::vector<std::vector<Node>> subtrees(tasks.size());
+    pool.Run(tasks.size(), [&](size_t job, size_t) {
+        const Task& task = tasks[job];
+        std::vector<Node>& subtree = subtrees[job];
+        subtree.reserve(2 * (task.end - task.begin));
+        subtree.resize(1);
+        builder.Subtree(subtree, 0, task.begin, task.end, task.depth);
+    });
+
+    // Subtree roots replace their placeholder nodes, the rest is appended with child indices rebased.
+    for (size_t job = 0; job < tasks.size(); job++) {
+        std::vector<Node>& subtree = subtrees[job];
+        const uint32_t offset = static_cast<uint32_t>(nodes.size() - 1);
+        for (Node& node : subtree) {
+            if (node.count == 0) node.leftOrFirst += offset;
+        }
+        nodes[tasks[job].node] = subtree[0];
+        nodes.insert(nodes.end(), subtree.begin() + 1, subtree.end());
+        std::vector<Node>().swap(subtree);
+    }
+
+    triangles.resize(triangleCount);
+    triangleIndices.resize(triangleCount);
+    pool.Run(chunks, [&](size_t chunk, size_t) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = begin + chunkSize < triangleCount ? begin + chunkSize : triangleCount;
+        for (size_t i = begin; i < end; i++) {
+            triangleIndices[i] = primitives[i].triangle;
+            const uint32_t* corners = indices + 3 * primitives[i].triangle;
+            const Vector3& v0 = vertices[corners[0]];
+            triangles[i] = Triangle{ v0, vertices[corners[1]].Subtract(v0), vertices[corners[2]].Subtract(v0) };
+        }
+    });
+}
+
+// Narrows [enter, exit] to the distances where the ray is between min and max along one axis. An infinite inverse
+// means a zero direction component: the ray is parallel to the slab and is inside it for every t or for none, which
+// is decided by the origin alone. Multiplying would give 0 * inf = NaN for an origin on a face.
+static inline bool ClipSlab(float origin, float inverseDirection, float min, float max, float& enter, float& exit) {
+    if (std::isinf(inverseDirection)) return origin >= min && origin <= max;
+    const float t1 = (min - origin) * inverseDirection, t2 = (max - origin) * inverseDirection;
+    const float near = t1 < t2 ? t1 : t2, far = t1 < t2 ? t2 : t1;
+    enter = near > enter ? near : enter;
+    exit = far < exit ? far : exit;
+    return true;
+}
+
+bool BVH::IntersectBox(const Vector3& origin, const Vector3& inverseDirection, const Vector3& min, const Vector3& max,
+                       float tMax, float& tNear) {
+    float enter = 0, exit = tMax;
+    if (!ClipSlab(origin.x, inverseDirection.x, min.x, max.x, enter, exit)) return false;
+    if (!ClipSlab(origin.y, inverseDirection.y, min.y, max.y, enter, exit)) return false;
+    if (!ClipSlab(origin.z, inverseDirection.z, min.z, max.z, enter, exit)) return false;
+    tNear = enter;
+    return enter <= exit;
+}
+
+static inline bool HitTriangle(const Vector3& origin, const Vector3& direction, const Vector3& v0, const Vector3& edge1,
+                               const Vector3& edge2, float tMax, float& t, float& u, float& v) {
+    const Vector3 p = direction.Cross(edge2);
+    const float determinant = edge1.Dot(p);
+    if (determinant == 0) return false;
+    const float inverseDeterminant = 1.0f / determinant;
+
+    const Vector3 s = origin.Subtract(v0);
+    const float hitU = s.Dot(p) * inverseDeterminant;
+    if (hitU < 0 || hitU > 1) return false;
+
+    const Vector3 q = s.Cross(edge1);
+    const float hitV = direction.Dot(q) * inverseDeterminant;
+    if (hitV < 0 || hitU + hitV > 1) return false;
+
+    const float hitT = edge2.Dot(q) * inverseDeterminant;
+    if (!(hitT > 0 && hitT < tMax)) return false;
+    t = hitT;
+    u = hitU;
+    v = hitV;
+    return true;
+}
+
+bool BVH::IntersectTriangle(const Vector3& origin, const Vector3& direction, const Vector3& v0, const Vector3& v1,
+                            const Vector3& v2, float tMax, float& t, float& u, float& v) {
+    return HitTriangle(origin, direction, v0, v1.Subtract(v0), v2.Subtract(v0), tMax, t, u, v);
+}
+
+template <bool any>
+bool BVH::Traverse(const Vector3& origin, const Vector3& direction, Hit& hit) const {
+    if (nodes.empty()) return false;
+    const Vector3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+    struct Entry {
+        uint32_t node;
+        float tNear;
+    };
+    Entry stack[stackSize];
+    size_t top = 0;
+
+    float tNear;
+    if (!IntersectBox(origin, inverseDirection, nodes[0].min, nodes[0].max, hit.t, tNear)) return false;
+    uint32_t index = 0;
+    while (true) {
+        const Node& node = nodes[index];
+        if (node.count != 0) {
+            for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+                const Triangle& triangle = triangles[i];
+                if (HitTriangle(origin, direction, triangle.v0, triangle.edge1, triangle.edge2, hit.t, hit.t, hit.u, hit.v)) {
+                    hit.triangle = triangleIndices[i];
+                    if (any) return true;
+                }
+            }
+        } else {
+            // Descend into the nearer child first, the farther one waits on the stack with its entry distance.
+            const uint32_t left = node.leftOrFirst, right = left + 1;
+            float tLeft, tRight;
+            const bool hitLeft = IntersectBox(origin, inverseDirection, nodes[left].min, nodes[left].max, hit.t, tLeft);
+            const bool hitRight = IntersectBox(origin, inverseDirection, nodes[right].min, nodes[right].max, hit.t, tRight);
+            if (hitLeft && hitRight) {
+                const bool leftFirst = tLeft <= tRight;
+                stack[top++] = leftFirst ? Entry{ right, tRight } : Entry{ left, tLeft };
+                index = leftFirst ? left : right;
+                continue;
+            }
+            if (hitLeft || hitRight) {
+                index = hitLeft ? left : right;
+                continue;
+            }
+        }
+
+        // Skip stacked nodes that lie behind a hit found meanwhile.
+        while (top > 0 && stack[top - 1].tNear > hit.t) top--;
+        if (top == 0) break;
+        index = stack[--top].node;
+    }
+    return hit.triangle != noHit;
+}
+
+bool BVH::Intersect(const Vector3& origin, const Vector3& direction, Hit& hit, float tMax) const {
+    hit = Hit{ tMax, 0, 0, noHit };
+    return Traverse<false>(origin, direction, hit);
+}
+
+bool BVH::Occluded(const Vector3& origin, const Vector3& direction, float tMax) const {
+    Hit hit{ tMax, 0, 0, noHit };
+    return Traverse<true>(origin, direction, hit);
+}
+
+size_t BVH::IntersectStream(const Vector4Stream& origins, const Vector4Stream& directions, Hit* hits) {
+    if (directions.count < origins.count) {
+        throw std::out_of_range("IntersectStream directions are shorter than the origins.");
+    }
+
+    const size_t count = origins.count;
+    std::vector<size_t> hitCounts(pool.Size(), 0);
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    pool.Run(chunks, [&](size_t chunk, size_t worker) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        size_t hitCount = 0;
+        for (size_t i = begin; i < end; i++) {
+            const Vector3 origin(origins.x[i], origins.y[i], origins.z[i]);
+            const Vector3 direction(directions.x[i], directions.y[i], directions.z[i]);
+            hitCount += Intersect(origin, direction, hits[i], origins.w[i]);
+        }
+        hitCounts[worker] += hitCount;
+    });
+
+    size_t total = 0;
+    for (size_t hitCount : hitCounts) total += hitCount;
+    return total;
+}
+
+const std::vector<BVH::Node>& BVH::Nodes() const {
+    return nodes;
+}
+
+size_t BVH::Depth() const {
+    if (nodes.empty()) return 0;
+    size_t depth = 0;
+    std::vector<std::pair<uint32_t, size_t>> stack{ { 0u, 1 } };
+    while (!stack.empty()) {
+        const std::pair<uint32_t, size_t> entry = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, entry.second);
+        const Node& node = nodes[entry.first];
+        if (node.count != 0) continue;
+        stack.push_back({ node.leftOrFirst, entry.second + 1 });
+        stack.push_back({ node.leftOrFirst + 1, entry.second + 1 });
+    }
+    return depth;
+}
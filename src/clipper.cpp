@@ -0,0 +1,266 @@
+#include "../include/clipper.h"
+#include "../include/vector4stream.h"
+#include "../include/simd.h"
+#include <utility>
+#include <stdexcept>
+
+// Outcode bits: the frustum planes in the order of Frustum, then the guard band.
+static constexpr uint32_t leftPlane = 1u << 0, rightPlane = 1u << 1, bottomPlane = 1u << 2, topPlane = 1u << 3;
+static constexpr uint32_t nearPlane = 1u << 4, farPlane = 1u << 5;
+static constexpr uint32_t guardLeftPlane = 1u << 6, guardRightPlane = 1u << 7, guardBottomPlane = 1u << 8, guardTopPlane = 1u << 9;
+// Crossing only the left, right, bottom or top plane is left to the scissoring of the rasterizers.
+static constexpr uint32_t clipPlanes = nearPlane | farPlane | guardLeftPlane | guardRightPlane | guardBottomPlane | guardTopPlane;
+
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Clipper stores screen vertices as 4 packed floats.");
+
+Clipper::Clipper(float x, float y, float width, float height, Frustum::Depth depth, float guardBand) {
+    if (!(width > 0 && height > 0)) {
+        throw std::invalid_argument("Clipper viewport must have positive size.");
+    }
+    if (!(x >= -guardBand && y >= -guardBand && x + width <= guardBand && y + height <= guardBand)) {
+        throw std::invalid_argument("Clipper guard band must contain the viewport.");
+    }
+
+    const bool negativeOneToOne = depth == Frustum::Depth::NegativeOneToOne;
+    viewport[0] = 0.5f * width, viewport[1] = x + 0.5f * width;
+    viewport[2] = -0.5f * height, viewport[3] = y + 0.5f * height;
+    viewport[4] = negativeOneToOne ? 0.5f : 1.0f, viewport[5] = negativeOneToOne ? 0.5f : 0.0f;
+    // NDC coordinates of the screen coordinates -guardBand and guardBand, y is flipped.
+    guard[0] = (-guardBand - viewport[1]) / viewport[0];
+    guard[1] = (guardBand - viewport[1]) / viewport[0];
+    guard[2] = (guardBand - viewport[3]) / viewport[2];
+    guard[3] = (-guardBand - viewport[3]) / viewport[2];
+    nearW = negativeOneToOne ? 1.0f : 0.0f;
+}
+
+Vector4 Clipper::Map(const Vector4& clip) const {
+    const float inverseW = 1.0f / clip.w;
+    return Vector4(
+        viewport[0] * (clip.x * inverseW) + viewport[1],
+        viewport[2] * (clip.y * inverseW) + viewport[3],
+        viewport[4] * (clip.z * inverseW) + viewport[5],
+        inverseW
+    );
+}
+
+// Comparisons are negated so that NaN coordinates end up outside of every plane.
+static inline uint32_t Outcode(float x, float y, float z, float w, const float guard[4], float nearW) {
+    uint32_t code = 0;
+    if (!(x >= -w)) code |= leftPlane;
+    if (!(x <= w)) code |= rightPlane;
+    if (!(y >= -w)) code |= bottomPlane;
+    if (!(y <= w)) code |= topPlane;
+    if (!(z >= -nearW * w)) code |= nearPlane;
+    if (!(z <= w)) code |= farPlane;
+    if (!(x >= guard[0] * w)) code |= guardLeftPlane;
+    if (!(x <= guard[1] * w)) code |= guardRightPlane;
+    if (!(y >= guard[2] * w)) code |= guardBottomPlane;
+    if (!(y <= guard[3] * w)) code |= guardTopPlane;
+    return code;
+}
+
+// Outcodes and mapped positions of all input vertices. Vertices behind the eye get meaningless positions, no emitted
+// triangle references them.
+static void PrepareScalar(const Vector4Stream& clip, const float viewport[6], const float guard[4], float nearW,
+                          uint16_t* codes, Vector4* screen, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const float x = clip.x[i], y = clip.y[i], z = clip.z[i], w = clip.w[i];
+        codes[i] = static_cast<uint16_t>(Outcode(x, y, z, w, guard, nearW));
+        const float inverseW = 1.0f / w;
+        screen[i] = Vector4(
+            viewport[0] * (x * inverseW) + viewport[1],
+            viewport[2] * (y * inverseW) + viewport[3],
+            viewport[4] * (z * inverseW) + viewport[5],
+            inverseW
+        );
+    }
+}
+
+#if W_ENGINE_X86
+static const int clipTailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+W_ENGINE_TARGET("avx2,fma")
+static inline __m256i OutcodeBit(__m256 outside, uint32_t bit) {
+    return _mm256_and_si256(_mm256_castps_si256(outside), _mm256_set1_epi32(static_cast<int>(bit)));
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static void PrepareAVX2(const Vector4Stream& clip, const float viewport[6], const float guard[4], float nearW,
+                        uint16_t* codes, Vector4* screen, size_t count) {
+    const __m256 scaleX = _mm256_set1_ps(viewport[0]), offsetX = _mm256_set1_ps(viewport[1]);
+    const __m256 scaleY = _mm256_set1_ps(viewport[2]), offsetY = _mm256_set1_ps(viewport[3]);
+    const __m256 scaleZ = _mm256_set1_ps(viewport[4]), offsetZ = _mm256_set1_ps(viewport[5]);
+    const __m256 guardMinX = _mm256_set1_ps(guard[0]), guardMaxX = _mm256_set1_ps(guard[1]);
+    const __m256 guardMinY = _mm256_set1_ps(guard[2]), guardMaxY = _mm256_set1_ps(guard[3]);
+    const __m256 near = _mm256_set1_ps(-nearW), signMask = _mm256_set1_ps(-0.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        const size_t lanes = count - i < 8 ? count - i : 8;
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(clipTailMask + 8 - lanes));
+        const __m256 x = _mm256_maskload_ps(clip.x + i, tail), y = _mm256_maskload_ps(clip.y + i, tail);
+        const __m256 z = _mm256_maskload_ps(clip.z + i, tail), w = _mm256_maskload_ps(clip.w + i, tail);
+        const __m256 negativeW = _mm256_xor_ps(w, signMask);
+
+        __m256i code = OutcodeBit(_mm256_cmp_ps(x, negativeW, _CMP_NGE_UQ), leftPlane);
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(x, w, _CMP_NLE_UQ), rightPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(y, negativeW, _CMP_NGE_UQ), bottomPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(y, w, _CMP_NLE_UQ), topPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(z, _mm256_mul_ps(near, w), _CMP_NGE_UQ), nearPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(z, w, _CMP_NLE_UQ), farPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(x, _mm256_mul_ps(guardMinX, w), _CMP_NGE_UQ), guardLeftPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(x, _mm256_mul_ps(guardMaxX, w), _CMP_NLE_UQ), guardRightPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(y, _mm256_mul_ps(guardMinY, w), _CMP_NGE_UQ), guardBottomPlane));
+        code = _mm256_or_si256(code, OutcodeBit(_mm256_cmp_ps(y, _mm256_mul_ps(guardMaxY, w), _CMP_NLE_UQ), guardTopPlane));
+        // Codes fit 16 bits: pack within the 128-bit halves, then move the second half's quadword next to the first.
+        const __m128i packed = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(code, code), 0x08));
+
+        const __m256 inverseW = _mm256_div_ps(_mm256_set1_ps(1.0f), w);
+        const __m256 sx = _mm256_fmadd_ps(_mm256_mul_ps(x, inverseW), scaleX, offsetX);
+        const __m256 sy = _mm256_fmadd_ps(_mm256_mul_ps(y, inverseW), scaleY, offsetY);
+        const __m256 sz = _mm256_fmadd_ps(_mm256_mul_ps(z, inverseW), scaleZ, offsetZ);
+        const __m256 ab0 = _mm256_unpacklo_ps(sx, sy), ab1 = _mm256_unpackhi_ps(sx, sy);
+        const __m256 cd0 = _mm256_unpacklo_ps(sz, inverseW), cd1 = _mm256_unpackhi_ps(sz, inverseW);
+        const __m256 rows[4] = {
+            _mm256_shuffle_ps(ab0, cd0, 0x44), _mm256_shuffle_ps(ab0, cd0, 0xEE),
+            _mm256_shuffle_ps(ab1, cd1, 0x44), _mm256_shuffle_ps(ab1, cd1, 0xEE)
+        };
+
+        if (lanes == 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(codes + i), packed);
+            float* target = &screen[i].x;
+            for (int l = 0; l < 4; l++) {
+                _mm_storeu_ps(target + 4 * l, _mm256_castps256_ps128(rows[l]));
+                _mm_storeu_ps(target + 4 * (l + 4), _mm256_extractf128_ps(rows[l], 1));
+            }
+            continue;
+        }
+
+        alignas(32) uint16_t codeBlock[8];
+        alignas(32) float block[32];
+        _mm_store_si128(reinterpret_cast<__m128i*>(codeBlock), packed);
+        for (int l = 0; l < 4; l++) {
+            _mm_store_ps(block + 4 * l, _mm256_castps256_ps128(rows[l]));
+            _mm_store_ps(block + 4 * (l + 4), _mm256_extractf128_ps(rows[l], 1));
+        }
+        for (size_t l = 0; l < lanes; l++) {
+            codes[i + l] = codeBlock[l];
+            screen[i + l] = Vector4(block[4 * l], block[4 * l + 1], block[4 * l + 2], block[4 * l + 3]);
+        }
+    }
+}
+#endif
+
+size_t Clipper::Process(const Vector4Stream& clip, const uint32_t* indices, size_t triangleCount) {
+    if (clip.count >= noVertex) {
+        throw std::out_of_range("Clipper supports less than 2^32 - 1 vertices.");
+    }
+    for (size_t i = 0; i < 3 * triangleCount; i++) {
+        if (indices[i] >= clip.count) throw std::out_of_range("Clipper triangle index is out of the vertex range.");
+    }
+
+    codes.resize(clip.count);
+    vertices.resize(clip.count);
+    this->indices.clear();
+    this->indices.reserve(3 * triangleCount);
+    stats = Stats();
+
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: PrepareAVX2(clip, viewport, guard, nearW, codes.data(), vertices.data(), clip.count); break;
+#endif
+        default: PrepareScalar(clip, viewport, guard, nearW, codes.data(), vertices.data(), clip.count); break;
+    }
+
+    for (size_t t = 0; t < triangleCount; t++) {
+        const uint32_t* triangle = indices + 3 * t;
+        const uint32_t a = codes[triangle[0]], b = codes[triangle[1]], c = codes[triangle[2]];
+        if (a & b & c) {
+            stats.rejected++;
+            continue;
+        }
+        const uint32_t crossed = (a | b | c) & clipPlanes;
+        if (crossed == 0) {
+            this->indices.insert(this->indices.end(), triangle, triangle + 3);
+            stats.accepted++;
+            continue;
+        }
+        stats.clipped++;
+        ClipTriangle(clip, triangle, crossed);
+    }
+    return this->indices.size() / 3;
+}
+
+void Clipper::ClipTriangle(const Vector4Stream& clip, const uint32_t* triangle, uint32_t planes) {
+    // Each of the 6 clipped planes adds at most one vertex to the convex polygon.
+    ClipVertex buffers[2][9];
+    ClipVertex* polygon = buffers[0];
+    ClipVertex* next = buffers[1];
+    size_t size = 3;
+    for (int i = 0; i < 3; i++) {
+        const uint32_t v = triangle[i];
+        polygon[i] = { clip.x[v], clip.y[v], clip.z[v], clip.w[v], v };
+    }
+
+    for (uint32_t plane = nearPlane; plane <= guardTopPlane && size >= 3; plane <<= 1) {
+        if (!(planes & plane)) continue;
+        const auto distance = [&](const ClipVertex& v) {
+            switch (plane) {
+                case nearPlane: return v.z + nearW * v.w;
+                case farPlane: return v.w - v.z;
+                case guardLeftPlane: return v.x - guard[0] * v.w;
+                case guardRightPlane: return guard[1] * v.w - v.x;
+                case guardBottomPlane: return v.y - guard[2] * v.w;
+                default: return guard[3] * v.w - v.y;
+            }
+        };
+
+        size_t written = 0;
+        for (size_t i = 0; i < size; i++) {
+            const ClipVertex& a = polygon[i];
+            const ClipVertex& b = polygon[i + 1 < size ? i + 1 : 0];
+            const float da = distance(a), db = distance(b);
+            if (da >= 0) next[written++] = a;
+            if ((da > 0 && db < 0) || (da < 0 && db > 0)) {
+                // Interpolated from the inside vertex, so the triangles sharing the edge create the same point.
+                const ClipVertex& from = da > 0 ? a : b;
+                const ClipVertex& to = da > 0 ? b : a;
+                const float t = da > 0 ? da / (da - db) : db / (db - da);
+                next[written++] = {
+                    from.x + t * (to.x - from.x), from.y + t * (to.y - from.y),
+                    from.z + t * (to.z - from.z), from.w + t * (to.w - from.w), noVertex
+                };
+            }
+        }
+        std::swap(polygon, next);
+        size = written;
+    }
+    if (size < 3) return;
+
+    uint32_t mapped[9];
+    for (size_t i = 0; i < size; i++) {
+        const ClipVertex& v = polygon[i];
+        if (v.index != noVertex) {
+            mapped[i] = v.index;
+            continue;
+        }
+        mapped[i] = static_cast<uint32_t>(vertices.size());
+        vertices.push_back(Map(Vector4(v.x, v.y, v.z, v.w)));
+    }
+    for (size_t i = 1; i + 1 < size; i++) {
+        indices.push_back(mapped[0]);
+        indices.push_back(mapped[i]);
+        indices.push_back(mapped[i + 1]);
+    }
+}
+
+const std::vector<Vector4>& Clipper::Vertices() const {
+    return vertices;
+}
+
+const std::vector<uint32_t>& Clipper::Indices() const {
+    return indices;
+}
+
+const Clipper::Stats& Clipper::LastStats() const {
+    return stats;
+}
@@ -1,7 +1,11 @@
 #include "../include/euler.h"
+#include "../include/eulerangles.h"
 #include "../include/vector4.h"
 #include "../include/matrix4.h"
 #include "../include/quaternion.h"
+#include "../include/quaternionstream.h"
+#include "../include/simd.h"
+#include <type_traits>
 
 Euler::Order Euler::StringToOrder(const std::string& order) {
     if (order == "XYZ" || order == "xyz") return Order::XYZ;
@@ -13,6 +17,21 @@ Euler::Order Euler::StringToOrder(const std::string& order) {
     throw std::invalid_argument("Invalid rotation order: " + order + ".\nValid options are: XYZ, XZY, YXZ, YZX, ZXY, ZYX or xyz, xzy, yxz, yzx, zxy, zyx.");
 }
 
+// Calls kernel(std::integral_constant<Euler::Order, O>()) for the runtime order. Every entry point taking a runtime order
+// goes through here once and continues in the EulerAngles specialization.
+template <typename Kernel>
+static decltype(auto) DispatchOrder(Euler::Order order, Kernel kernel) {
+    switch (order) {
+        case Euler::Order::XYZ: return kernel(std::integral_constant<Euler::Order, Euler::Order::XYZ>());
+        case Euler::Order::XZY: return kernel(std::integral_constant<Euler::Order, Euler::Order::XZY>());
+        case Euler::Order::YXZ: return kernel(std::integral_constant<Euler::Order, Euler::Order::YXZ>());
+        case Euler::Order::YZX: return kernel(std::integral_constant<Euler::Order, Euler::Order::YZX>());
+        case Euler::Order::ZXY: return kernel(std::integral_constant<Euler::Order, Euler::Order::ZXY>());
+        case Euler::Order::ZYX: return kernel(std::integral_constant<Euler::Order, Euler::Order::ZYX>());
+        default: throw std::invalid_argument("Invalid rotation order.\nValid options are: XYZ, XZY, YXZ, YZX, ZXY, ZYX.");
+    }
+}
+
 std::string Euler::OrderToString(Euler::Order order) {
     switch (order) {
         case Order::XYZ: return "XYZ";
@@ -30,175 +49,37 @@ void Euler::Print(const int& precision = 6) const {
 }
 
 Euler Euler::XYZ(const Matrix4& rotationMatrix, float epsilon) {
-    float alpha, beta, gamma; 
-    float cosBeta = sqrt(rotationMatrix.m11*rotationMatrix.m11 + rotationMatrix.m12*rotationMatrix.m12);
-
-    if (cosBeta > epsilon) {
-        beta = atan2f(rotationMatrix.m13, cosBeta);
-        alpha = atan2f(-rotationMatrix.m23, rotationMatrix.m33);
-        gamma = atan2f(-rotationMatrix.m12, rotationMatrix.m11);
-    } else {
-        alpha = 0;
-        if (rotationMatrix.m13 < 0.0) {
-            beta = -M_PI_2;
-            gamma = -atan2f(rotationMatrix.m21, rotationMatrix.m22);
-        } else {
-            beta = M_PI_2;
-            gamma = atan2f(rotationMatrix.m21, -rotationMatrix.m22);
-        }
-    }
-
-    return Euler(alpha, beta, gamma, "XYZ");
+    return EulerXYZ::FromMatrix(rotationMatrix, epsilon).ToEuler();
 }
 
 Euler Euler::XZY(const Matrix4& rotationMatrix, float epsilon) {
-    float alpha, beta, gamma;
-    float cosBeta = sqrt(rotationMatrix.m11*rotationMatrix.m11 + rotationMatrix.m13*rotationMatrix.m13);
-
-    if (cosBeta > epsilon) {
-        beta = atan2f(-rotationMatrix.m12, cosBeta);
-        alpha = atan2f(rotationMatrix.m32, rotationMatrix.m22);
-        gamma = atan2f(rotationMatrix.m13, rotationMatrix.m11);
-    } else {
-        alpha = 0;
-        if (rotationMatrix.m12 < 0.0) {
-            beta = M_PI_2;
-            gamma = atan2f(rotationMatrix.m23, rotationMatrix.m33);
-        } else {
-            beta = -M_PI_2;
-            gamma = atan2f(rotationMatrix.m23, rotationMatrix.m33);
-        }
-    }
-
-    return Euler(alpha, beta, gamma, "XZY");
+    return EulerXZY::FromMatrix(rotationMatrix, epsilon).ToEuler();
 }
 
 Euler Euler::YXZ(const Matrix4& rotationMatrix, float epsilon) {
-    float alpha, beta, gamma;
-    float cosBeta = sqrt(rotationMatrix.m21*rotationMatrix.m21 + rotationMatrix.m22*rotationMatrix.m22);
-
-    if (cosBeta > epsilon) {
-        beta = atan2f(-rotationMatrix.m23, cosBeta);
-        alpha = atan2f(rotationMatrix.m13, rotationMatrix.m33);
-        gamma = atan2f(rotationMatrix.m21, rotationMatrix.m22);
-    } else {
-        alpha = 0;
-        if (rotationMatrix.m23 < 0.0) {
-            beta = M_PI_2;
-            gamma = atan2f(rotationMatrix.m31, rotationMatrix.m32);
-        } else {
-            beta = -M_PI_2;
-            gamma = atan2f(rotationMatrix.m31, rotationMatrix.m32);
-        }
-    }
-
-    return Euler(alpha, beta, gamma, "YXZ");
+    return EulerYXZ::FromMatrix(rotationMatrix, epsilon).ToEuler();
 }
 
 Euler Euler::YZX(const Matrix4& rotationMatrix, float epsilon) {
-    float alpha, beta, gamma;
-    float cosBeta = sqrt(rotationMatrix.m11*rotationMatrix.m11 + rotationMatrix.m31*rotationMatrix.m31);
-
-    if (cosBeta > epsilon) {
-        beta = atan2f(rotationMatrix.m21, cosBeta);
-        alpha = atan2f(-rotationMatrix.m31, rotationMatrix.m11);
-        gamma = atan2f(-rotationMatrix.m23, rotationMatrix.m22);
-    } else {
-        alpha = 0;
-        if (rotationMatrix.m21 < 0.0) {
-            beta = -M_PI_2;
-            gamma = -atan2f(rotationMatrix.m32, rotationMatrix.m33);
-        } else {
-            beta = M_PI_2;
-            gamma = atan2f(rotationMatrix.m32, rotationMatrix.m33);
-        }
-    }
-
-    return Euler(alpha, beta, gamma, "YZX");
+    return EulerYZX::FromMatrix(rotationMatrix, epsilon).ToEuler();
 }
 
 Euler Euler::ZXY(const Matrix4& rotationMatrix, float epsilon) {
-    float alpha, beta, gamma;
-    float cosBeta = sqrt(rotationMatrix.m31*rotationMatrix.m31 + rotationMatrix.m33*rotationMatrix.m33);
-
-    if (cosBeta > epsilon) {
-        beta = atan2f(rotationMatrix.m32, cosBeta);
-        alpha = atan2f(-rotationMatrix.m12, rotationMatrix.m22);
-        gamma = atan2f(-rotationMatrix.m31, rotationMatrix.m33);
-    } else {
-        alpha = 0;
-        if (rotationMatrix.m32 < 0.0) {
-            beta = -M_PI_2;
-            gamma = atan2f(rotationMatrix.m21, rotationMatrix.m22);
-        } else {
-            beta = M_PI_2;
-            gamma = atan2f(rotationMatrix.m21, rotationMatrix.m22);
-        }
-    }
-
-    return Euler(alpha, beta, gamma, "ZXY");
+    return EulerZXY::FromMatrix(rotationMatrix, epsilon).ToEuler();
 }
 
 Euler Euler::ZYX(const Matrix4& rotationMatrix, float epsilon) {
-    float alpha, beta, gamma;
-    float cosBeta = sqrt(rotationMatrix.m32*rotationMatrix.m32 + rotationMatrix.m33*rotationMatrix.m33);
-
-    if (cosBeta > epsilon) { 
-        beta = atan2f(-rotationMatrix.m31, cosBeta);
-        alpha = atan2f(rotationMatrix.m21, rotationMatrix.m11);
-        gamma = atan2f(rotationMatrix.m32, rotationMatrix.m33);
-    } else {
-        alpha = 0;
-        if (rotationMatrix.m31 < 0.0) {
-            beta = M_PI_2;
-            gamma = atan2f(rotationMatrix.m12, rotationMatrix.m22);
-        } else {
-            beta = -M_PI_2;
-            gamma = atan2f(rotationMatrix.m12, rotationMatrix.m22);
-        }
-    }
+    return EulerZYX::FromMatrix(rotationMatrix, epsilon).ToEuler();
+}
 
-    return Euler(alpha, beta, gamma, "ZYX");
+Euler Euler::Decompose(const Matrix4& rotationMatrix, Order order, float epsilon) {
+    return DispatchOrder(order, [&](auto o) { return EulerAngles<decltype(o)::value>::FromMatrix(rotationMatrix, epsilon).ToEuler(); });
 }
 
 Euler Euler::FromAngleAxis(const float& angleRadians, const Vector4& axis, const std::string& order) {
-    Euler::Order ORDER = StringToOrder(order);
-
-    const float cosTheta = cosf(angleRadians);
-    const float sinTheta = sinf(angleRadians);
-
-    const Matrix4 rotationMatrix = Matrix4(
-        cosTheta + axis.x * axis.x * (1.0f - cosTheta), axis.x * axis.y * (1.0f - cosTheta) - axis.z * sinTheta, axis.x * axis.z * (1.0f - cosTheta) + axis.y * sinTheta, 0,
-        axis.y * axis.x * (1.0f - cosTheta) + axis.z * sinTheta, cosTheta + axis.y * axis.y * (1.0f - cosTheta), axis.y * axis.z * (1.0f - cosTheta) - axis.x * sinTheta, 0,
-        axis.z * axis.x * (1.0f - cosTheta) - axis.y * sinTheta, axis.z * axis.y * (1.0f - cosTheta) + axis.x * sinTheta, cosTheta + axis.z * axis.z * (1.0f - cosTheta), 0,
-        0,                                                       0,                                              0,                                                       1                
-    );
-
-    float alpha, beta, gamma;
-
-    switch(ORDER) {
-        case Order::XYZ:
-            return Euler::XYZ(rotationMatrix);
-            break;
-        case Order::XZY:
-            return Euler::XZY(rotationMatrix);
-            break;
-        case Order::YXZ:
-            return Euler::YXZ(rotationMatrix);
-            break;
-        case Order::YZX:
-            return Euler::YZX(rotationMatrix);
-            break;
-        case Order::ZXY:
-            return Euler::ZXY(rotationMatrix);
-            break;
-        case Order::ZYX:
-            return Euler::ZYX(rotationMatrix);
-            break;
-        default:
-            throw std::invalid_argument("Invalid rotation order: " + order + ".\nValid options are: XYZ, XZY, YXZ, YZX, ZXY, ZYX or xyz, xzy, yxz, yzx, zxy, zyx.");
-    }
-    return Euler(alpha, beta, gamma, order);
+    return DispatchOrder(StringToOrder(order), [&](auto o) {
+        return EulerAngles<decltype(o)::value>::FromAngleAxis(angleRadians, axis.x, axis.y, axis.z).ToEuler();
+    });
 }
 
 Euler Euler::FromRotationMatrix(const Matrix4& m) {
@@ -208,12 +89,8 @@ Euler Euler::FromRotationMatrix(const Matrix4& m) {
     return Euler(alpha, beta, gamma);
 }
 
-Euler Euler::FromQuaternion(const Quaternion& q) {
-    return Euler(
-       -atan2f(2 * (q.w * q.x + q.y * q.z), 1 - 2 * (q.x * q.x + q.y * q.y)),
-        asinf(2 * (q.w * q.y - q.z * q.x)),
-        atan2f(2 * (q.w * q.z + q.x * q.y), 1 - 2 * (q.y * q.y + q.z * q.z))
-    );
+Euler Euler::FromQuaternion(const Quaternion& q, Order order, float epsilon) {
+    return DispatchOrder(order, [&](auto o) { return EulerAngles<decltype(o)::value>::FromQuaternion(q, epsilon).ToEuler(); });
 }
 
 float Euler::ToRotationAngle() const {
@@ -233,54 +110,7 @@ Vector4 Euler::ToRotationAxis() const {
 }
 
 Quaternion Euler::ToQuaternion() const {
-    const Matrix4 m = this->RotateXYZ();
-    const float w = sqrtf((1 + m.m11 + m.m22 + m.m33) * 0.25f);
-    const float x = sqrtf((1 + m.m11 - m.m22 - m.m33) * 0.25f);
-    const float y = sqrtf((1 - m.m11 + m.m22 - m.m33) * 0.25f);
-    const float z = sqrtf((1 - m.m11 - m.m22 + m.m33) * 0.25f);
-
-    if (w > x && w > y && w > z) {
-        const float multiplier = 1.0f / (4.0f * w);
-        return Quaternion(
-            w,
-            (m.m32 - m.m23) * multiplier,
-            (m.m13 - m.m31) * multiplier,
-            (m.m21 - m.m12) * multiplier
-        );
-    }
-
-    if (x > w && x > y && x > z) {
-        const float multiplier = 1.0f / (4.0f * x);
-        return Quaternion(
-            (m.m32 - m.m23) * multiplier,
-            x,
-            (m.m12 + m.m21) * multiplier,
-            (m.m13 + m.m31) * multiplier
-        );
-    }
-
-    if (y > w && y > x && y > z) {
-        const float multiplier = 1.0f / (4.0f * y);
-        return Quaternion(
-            (m.m13 - m.m31) * multiplier,
-            (m.m12 + m.m21) * multiplier,
-            y,
-            (m.m23 + m.m32) * multiplier
-        );
-    }
-
-    if (z > w && z > x && z > y) {
-        const float multiplier = 1.0f / (4.0f * z);
-        return Quaternion(
-            (m.m21 - m.m12) * multiplier,
-            (m.m13 + m.m31) * multiplier,
-            (m.m23 + m.m32) * multiplier,
-            z
-        );
-    }
-
-    std::cerr << "Cannot determine quaternion from matrix." << std::endl;
-    return Quaternion();
+    return DispatchOrder(this->order, [&](auto o) { return EulerAngles<decltype(o)::value>(this->alpha, this->beta, this->gamma).ToQuaternion(); });
 }
 
 Matrix4 Euler::RotateX() const {
@@ -317,150 +147,338 @@ Matrix4 Euler::RotateZ() const {
 }
 
 Matrix4 Euler::RotateXYZ() const {
-    const float cA = cosf(this->alpha),  sA = sinf(this->alpha);
-    const float cB = cosf(this->beta), sB = sinf(this->beta);
-    const float cG = cosf(this->gamma),   sG = sinf(this->gamma);
-
-    switch (this->order) {
-        case Order::XYZ:
-            return Matrix4(
-                cB*cG , -cB*sG , sB, 0,
-                cA*sG + sA*sB*cG , cA*cG - sA*sB*sG , -sA*cB, 0,
-                sA*sG - cA*sB*cG , cA*sB*sG + sA*cG , cA*cB, 0,
-                0,0,0,1);
-            break;
-        case Order::XZY:
-            return Matrix4(
-                cG*cB , -sB , sG*cB, 0,
-                cA*cG*sB + sA*sG , cA*cB , cA*sG*sB - sA*cG, 0,
-                sA*cG*sB - cA*sG , sA*cB , cA*cG + sA*sG*sB, 0,
-                0,0,0,1);
-            break;
-        case Order::YXZ:
-            return Matrix4(
-                sB*sA*sG + cA*cG , sB*sA*cG - cA*sG , cB*sA, 0,
-                cB*sG , cB*cG , -sB, 0,
-                sB*cA*sG - sA*cG , sB*cA*cG + sA*sG , cB*cA, 0,
-                0,0,0,1);
-            break;
-        case Order::YZX:
-            return Matrix4(
-                cA*cB , sG*sA - cG*cA*sB , cG*sA + sG*cA*sB, 0,
-                sB , cG*cB , -sG*cB, 0,
-                -sA*cB , cG*sA*sB + sG*cA , cG*cA - sG*sA*sB, 0,
-                0,0,0,1);
-            break;
-        case Order::ZXY:
-            return Matrix4(
-                cG*cA - sB*sG*sA , -cB*sA , sB*cG*sA + sG*cA, 0,
-                sB*sG*cA + cG*sA , cB*cA , sG*sA - sB*cG*cA, 0,
-                -cB*sG , sB , cB*cG, 0,
-                0,0,0,1);
-            break;
-        case Order::ZYX:
-            return Matrix4(
-                cB*cA , sG*sB*cA - cG*sA , cG*sB*cA + sG*sA, 0,
-                cB*sA , cG*cA + sG*sB*sA , cG*sB*sA - sG*cA, 0,
-                -sB , sG*cB , cG*cB, 0,
-                0,0,0,1);
-            break;
-        default:
-            std::cerr << "Invalid rotation order.\nValid options are: XYZ, XZY, YXZ, YZX, ZXY, ZYX or xyz, xzy, yxz, yzx, zxy, zyx." << std::endl;
-            return Matrix4();
+    return DispatchOrder(this->order, [&](auto o) { return EulerAngles<decltype(o)::value>(this->alpha, this->beta, this->gamma).ToMatrix(); });
+}
+
+// Batch conversion. The matrix is M = R_a0(alpha) * R_a1(beta) * R_a2(gamma) as in EulerAngles, where a0, a1, a2 are the
+// axes of the order from left to right, and the quaternion is q_a0(alpha) * q_a1(beta) * q_a2(gamma). The kernels are
+// instantiated per order, so only the rotations themselves remain in the inner loop. Matrices are 3x3 row-major.
+
+template <Euler::Order O>
+static void ToMatricesScalar(const float* alpha, const float* beta, const float* gamma, Matrix4* out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        out[i] = EulerAngles<O>(alpha[i], beta[i], gamma[i]).ToMatrix();
+    }
+}
+
+template <Euler::Order O>
+static void ToQuaternionsScalar(const float* alpha, const float* beta, const float* gamma, Quaternion* out, QuaternionStream* stream,
+                                size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const Quaternion q = EulerAngles<O>(alpha[i], beta[i], gamma[i]).ToQuaternion();
+        if (out != nullptr) {
+            out[i] = q;
+        } else {
+            stream->w[i] = q.w, stream->x[i] = q.x, stream->y[i] = q.y, stream->z[i] = q.z;
+        }
     }
 }
 
-#ifdef _WIN32
-#include <windows.h>
-#include <cstdlib>
-void clearConsole() {
-    system("cls");
-    std::cout << "\n" << std::endl;
+template <Euler::Order O>
+static void FromQuaternionsScalar(const Quaternion* q, const QuaternionStream* stream, float* alpha, float* beta, float* gamma,
+                                  size_t count, float epsilon) {
+    for (size_t i = 0; i < count; i++) {
+        const EulerAngles<O> e = EulerAngles<O>::FromQuaternion(
+            q != nullptr ? q[i] : Quaternion(stream->w[i], stream->x[i], stream->y[i], stream->z[i]), epsilon
+        );
+        alpha[i] = e.alpha, beta[i] = e.beta, gamma[i] = e.gamma;
+    }
+}
+
+#if W_ENGINE_X86
+static const int eulerTailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+// Cephes sinf/cosf: reduction by pi / 2 in three parts and minimax polynomials on [-pi / 4, pi / 4]. The quadrant
+// swaps sin and cos and selects the signs.
+W_ENGINE_TARGET("avx2,fma")
+static inline void SinCosFMA(__m256 x, __m256& sine, __m256& cosine) {
+    const __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(0.636619772367581343f)));
+    const __m256 j = _mm256_cvtepi32_ps(quadrant);
+    __m256 r = _mm256_fnmadd_ps(j, _mm256_set1_ps(1.5703125f), x);
+    r = _mm256_fnmadd_ps(j, _mm256_set1_ps(4.837512969970703125e-4f), r);
+    r = _mm256_fnmadd_ps(j, _mm256_set1_ps(7.54978995489188216e-8f), r);
+    const __m256 r2 = _mm256_mul_ps(r, r);
+
+    __m256 s = _mm256_fmadd_ps(_mm256_set1_ps(-1.9515295891e-4f), r2, _mm256_set1_ps(8.3321608736e-3f));
+    s = _mm256_fmadd_ps(s, r2, _mm256_set1_ps(-1.6666654611e-1f));
+    s = _mm256_fmadd_ps(_mm256_mul_ps(s, r2), r, r);
+    __m256 c = _mm256_fmadd_ps(_mm256_set1_ps(2.443315711809948e-5f), r2, _mm256_set1_ps(-1.388731625493765e-3f));
+    c = _mm256_fmadd_ps(c, r2, _mm256_set1_ps(4.166664568298827e-2f));
+    c = _mm256_fmadd_ps(_mm256_mul_ps(c, r2), r2, _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), r2, _mm256_set1_ps(1.0f)));
+
+    const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+    const __m256 sineSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+    const __m256 cosineSign = _mm256_castsi256_ps(
+        _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30)
+    );
+    sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sineSign);
+    cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosineSign);
+}
+
+template <int axis>
+W_ENGINE_TARGET("avx2,fma")
+static inline void AxisMatrixFMA(__m256 c, __m256 s, __m256 m[9]) {
+    const int i = (axis + 1) % 3, j = (axis + 2) % 3;
+    for (int e = 0; e < 9; e++) m[e] = _mm256_setzero_ps();
+    m[axis * 4] = _mm256_set1_ps(1.0f);
+    m[i * 4] = c, m[i * 3 + j] = _mm256_xor_ps(s, _mm256_set1_ps(-0.0f));
+    m[j * 3 + i] = s, m[j * 4] = c;
 }
-#endif
 
-int main() {
-    float rad = M_PI / 180.0;
-    float deg = 180.0 / M_PI;
-    std::string input;
-
-    while (true) {
-        std::cout << "Type 'exit' to quit, 'clear' to clear console.\n";
-        
-        if (input == "exit") {
-            break;
-        } else if (input == "clear") {
-            clearConsole();
+template <int axis>
+W_ENGINE_TARGET("avx2,fma")
+static inline void RotateMatrixFMA(__m256 c, __m256 s, __m256 m[9]) {
+    const int i = (axis + 1) % 3, j = (axis + 2) % 3;
+    for (int r = 0; r < 3; r++) {
+        const __m256 mi = m[r * 3 + i], mj = m[r * 3 + j];
+        m[r * 3 + i] = _mm256_fmadd_ps(c, mi, _mm256_mul_ps(s, mj));
+        m[r * 3 + j] = _mm256_fmsub_ps(c, mj, _mm256_mul_ps(s, mi));
+    }
+}
+
+template <int axis>
+W_ENGINE_TARGET("avx2,fma")
+static inline void RotateQuaternionFMA(__m256 c, __m256 s, __m256 q[4]) {
+    const int a = 1 + axis, i = 1 + (axis + 1) % 3, j = 1 + (axis + 2) % 3;
+    const __m256 w = q[0], qa = q[a], qi = q[i], qj = q[j];
+    q[0] = _mm256_fmsub_ps(c, w, _mm256_mul_ps(s, qa));
+    q[a] = _mm256_fmadd_ps(c, qa, _mm256_mul_ps(s, w));
+    q[i] = _mm256_fmadd_ps(c, qi, _mm256_mul_ps(s, qj));
+    q[j] = _mm256_fmsub_ps(c, qj, _mm256_mul_ps(s, qi));
+}
+
+// Stores lane l of (a, b, c, d) as 4 consecutive floats at target + l * stride.
+W_ENGINE_TARGET("avx2,fma")
+static inline void Transpose4x8(__m256 a, __m256 b, __m256 c, __m256 d, float* target, size_t stride) {
+    const __m256 ab0 = _mm256_unpacklo_ps(a, b), ab1 = _mm256_unpackhi_ps(a, b);
+    const __m256 cd0 = _mm256_unpacklo_ps(c, d), cd1 = _mm256_unpackhi_ps(c, d);
+    const __m256 r0 = _mm256_shuffle_ps(ab0, cd0, 0x44), r1 = _mm256_shuffle_ps(ab0, cd0, 0xEE);
+    const __m256 r2 = _mm256_shuffle_ps(ab1, cd1, 0x44), r3 = _mm256_shuffle_ps(ab1, cd1, 0xEE);
+    const __m256 lanes[4] = { r0, r1, r2, r3 };
+    for (int l = 0; l < 4; l++) {
+        _mm_storeu_ps(target + l * stride, _mm256_castps256_ps128(lanes[l]));
+        _mm_storeu_ps(target + (l + 4) * stride, _mm256_extractf128_ps(lanes[l], 1));
+    }
+}
+
+template <Euler::Order O>
+W_ENGINE_TARGET("avx2,fma")
+static void ToMatricesFMA(const float* alpha, const float* beta, const float* gamma, Matrix4* out, size_t count) {
+    constexpr int a0 = EulerAngles<O>::first, a1 = EulerAngles<O>::second, a2 = EulerAngles<O>::third;
+    alignas(32) float block[8 * 16];
+    for (size_t i = 0; i < count; i += 8) {
+        const size_t lanes = count - i < 8 ? count - i : 8;
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(eulerTailMask + 8 - lanes));
+        __m256 c, s, m[9];
+        SinCosFMA(_mm256_maskload_ps(alpha + i, mask), s, c);
+        AxisMatrixFMA<a0>(c, s, m);
+        SinCosFMA(_mm256_maskload_ps(beta + i, mask), s, c);
+        RotateMatrixFMA<a1>(c, s, m);
+        SinCosFMA(_mm256_maskload_ps(gamma + i, mask), s, c);
+        RotateMatrixFMA<a2>(c, s, m);
+
+        // Every row (m[3r], m[3r + 1], m[3r + 2], 0) goes through a 4x8 transpose into 8 matrices, 16 floats apart.
+        float* target = lanes == 8 ? &out[i].m11 : block;
+        for (int r = 0; r < 3; r++) {
+            Transpose4x8(m[3 * r], m[3 * r + 1], m[3 * r + 2], _mm256_setzero_ps(), target + 4 * r, 16);
+        }
+        for (size_t l = 0; l < 8; l++) _mm_storeu_ps(target + 16 * l + 12, _mm_setr_ps(0, 0, 0, 1));
+        for (size_t l = 0; lanes < 8 && l < lanes; l++) {
+            const float* e = block + 16 * l;
+            out[i + l] = Matrix4(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7], e[8], e[9], e[10], e[11], e[12], e[13], e[14], e[15]);
+        }
+    }
+}
+
+template <Euler::Order O>
+W_ENGINE_TARGET("avx2,fma")
+static void ToQuaternionsFMA(const float* alpha, const float* beta, const float* gamma, Quaternion* out, QuaternionStream* stream, size_t count) {
+    constexpr int a0 = EulerAngles<O>::first, a1 = EulerAngles<O>::second, a2 = EulerAngles<O>::third;
+    const __m256 half = _mm256_set1_ps(0.5f);
+    for (size_t i = 0; i < count; i += 8) {
+        const size_t lanes = count - i < 8 ? count - i : 8;
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(eulerTailMask + 8 - lanes));
+        __m256 c, s, q[4];
+        SinCosFMA(_mm256_mul_ps(_mm256_maskload_ps(alpha + i, mask), half), s, c);
+        q[0] = c, q[1] = q[2] = q[3] = _mm256_setzero_ps();
+        q[1 + a0] = s;
+        SinCosFMA(_mm256_mul_ps(_mm256_maskload_ps(beta + i, mask), half), s, c);
+        RotateQuaternionFMA<a1>(c, s, q);
+        SinCosFMA(_mm256_mul_ps(_mm256_maskload_ps(gamma + i, mask), half), s, c);
+        RotateQuaternionFMA<a2>(c, s, q);
+
+        if (out == nullptr) {
+            _mm256_maskstore_ps(stream->w + i, mask, q[0]);
+            _mm256_maskstore_ps(stream->x + i, mask, q[1]);
+            _mm256_maskstore_ps(stream->y + i, mask, q[2]);
+            _mm256_maskstore_ps(stream->z + i, mask, q[3]);
             continue;
         }
 
-        try {
-            std::cout << "\n______________________________________________________________________________________\n" <<std::endl;
-            std::cout << "\nEnter alpha (degrees): ";
-            std::cin >> input;
-            float alphaDeg = std::stof(input);
-            std::cout << "Enter beta (degrees):  ";
-            std::cin >> input;
-            float betaDeg = std::stof(input);
-            std::cout << "Enter gamma (degrees): ";
-            std::cin >> input;
-            float gammaDeg = std::stof(input);
-            std::cout << "Enter order (xyz, xzy) ";
-            std::cin >> input;
-
-            float alpha = alphaDeg * rad;
-            float beta = betaDeg * rad;
-            float gamma = gammaDeg * rad;
-
-            Euler euler = Euler(alpha, beta, gamma, input);
-            Matrix4 rotationMatrix = euler.RotateXYZ();
-            std::cout << "Euler angles:\n" << std::endl;
-            euler.Print(3);
-
-            std::cout << "Rotation matrix:\n" << std::endl;
-            rotationMatrix.Print(3);
-
-            Euler::Order order = Euler::StringToOrder(input);
-
-            std::cout << "Current Euler order is " << Euler::OrderToString(order) << std::endl;
-
-            Euler resultEuler;
-            switch (order) {
-                case Euler::Order::XYZ:
-                    resultEuler = Euler::XYZ(rotationMatrix);
-                    break;
-                case Euler::Order::XZY:
-                    resultEuler = Euler::XZY(rotationMatrix);
-                    break;
-                case Euler::Order::YXZ:
-                    resultEuler = Euler::YXZ(rotationMatrix);
-                    break;
-                case Euler::Order::YZX:
-                    resultEuler = Euler::YZX(rotationMatrix);
-                    break;
-                case Euler::Order::ZXY:
-                    resultEuler = Euler::ZXY(rotationMatrix);
-                    break;
-                case Euler::Order::ZYX:
-                    resultEuler = Euler::ZYX(rotationMatrix);
-                    break;
-                default:
-                    throw std::invalid_argument("Unknown rotation order.");
-            }
+        alignas(32) float block[32];
+        float* target = lanes == 8 ? &out[i].w : block;
+        Transpose4x8(q[0], q[1], q[2], q[3], target, 4);
+        for (size_t l = 0; lanes < 8 && l < lanes; l++) {
+            out[i + l] = Quaternion(block[4 * l], block[4 * l + 1], block[4 * l + 2], block[4 * l + 3]);
+        }
+    }
+}
 
-            std::cout << Euler::OrderToString(resultEuler.order) << " computed angles:\n";
-            std::cout << "\n\talpha: " << resultEuler.alpha * deg << "\n\tbeta: " << resultEuler.beta * deg << "\n\tgamma: " << resultEuler.gamma * deg << "\n\torder: " << Euler::OrderToString(resultEuler.order) << "\n\n";
+// Cephes atanf on the ratio of the smaller to the larger magnitude, reduced once more by pi / 4 above tan(pi / 8), then
+// mirrored into the octant of (y, x). atan2(0, 0) is 0.
+W_ENGINE_TARGET("avx2,fma")
+static inline __m256 Atan2FMA(__m256 y, __m256 x) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 ax = _mm256_andnot_ps(signMask, x), ay = _mm256_andnot_ps(signMask, y);
+    const __m256 steep = _mm256_cmp_ps(ay, ax, _CMP_GT_OQ);
+    const __m256 large = _mm256_max_ps(ax, ay);
+    __m256 t = _mm256_div_ps(_mm256_min_ps(ax, ay), large);
+    t = _mm256_and_ps(t, _mm256_cmp_ps(large, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+    const __m256 reduce = _mm256_cmp_ps(t, _mm256_set1_ps(0.414213562373095f), _CMP_GT_OQ);
+    t = _mm256_blendv_ps(t, _mm256_div_ps(_mm256_sub_ps(t, _mm256_set1_ps(1.0f)), _mm256_add_ps(t, _mm256_set1_ps(1.0f))), reduce);
+    const __m256 z = _mm256_mul_ps(t, t);
+    __m256 p = _mm256_fmadd_ps(_mm256_set1_ps(8.05374449538e-2f), z, _mm256_set1_ps(-1.38776856032e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.99777106478e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33329491539e-1f));
+    __m256 r = _mm256_fmadd_ps(_mm256_mul_ps(p, z), t, t);
+    r = _mm256_add_ps(r, _mm256_and_ps(reduce, _mm256_set1_ps(0.785398163397448f)));
+
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.57079632679490f), r), steep);
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(3.14159265358979f), r), x);
+    return _mm256_or_ps(r, _mm256_and_ps(y, signMask));
+}
 
-            resultEuler.Print(3);
+// Reads 8 quaternions of 4 consecutive floats at source + l * 4 into SoA registers, the inverse of Transpose4x8.
+W_ENGINE_TARGET("avx2,fma")
+static inline void Load4x8(const float* source, __m256& w, __m256& x, __m256& y, __m256& z) {
+    __m256 rows[4];
+    for (int l = 0; l < 4; l++) {
+        rows[l] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(source + 4 * l)), _mm_loadu_ps(source + 4 * (l + 4)), 1);
+    }
+    const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]), t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]), t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+    w = _mm256_shuffle_ps(t0, t2, 0x44), x = _mm256_shuffle_ps(t0, t2, 0xEE);
+    y = _mm256_shuffle_ps(t1, t3, 0x44), z = _mm256_shuffle_ps(t1, t3, 0xEE);
+}
 
-            std::cout << "______________________________________________________________________________________\n" <<std::endl;
+// EulerAngles::FromQuaternion with both branches evaluated and the gimbal lock lanes blended in.
+template <Euler::Order O>
+W_ENGINE_TARGET("avx2,fma")
+static void FromQuaternionsFMA(const Quaternion* quaternions, const QuaternionStream* stream, float* alpha, float* beta, float* gamma,
+                               size_t count, float epsilon) {
+    constexpr int a0 = EulerAngles<O>::first, a1 = EulerAngles<O>::second, a2 = EulerAngles<O>::third;
+    const __m256 parity = _mm256_set1_ps(EulerAngles<O>::parity), two = _mm256_set1_ps(2.0f);
+    const __m256 halfPi = _mm256_set1_ps(static_cast<float>(M_PI_2)), signMask = _mm256_set1_ps(-0.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        const size_t lanes = count - i < 8 ? count - i : 8;
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(eulerTailMask + 8 - lanes));
+        __m256 w, v[3];
+        if (quaternions == nullptr) {
+            w = _mm256_maskload_ps(stream->w + i, mask);
+            v[0] = _mm256_maskload_ps(stream->x + i, mask);
+            v[1] = _mm256_maskload_ps(stream->y + i, mask);
+            v[2] = _mm256_maskload_ps(stream->z + i, mask);
+        } else if (lanes == 8) {
+            Load4x8(&quaternions[i].w, w, v[0], v[1], v[2]);
+        } else {
+            alignas(32) float block[32] = {};
+            for (size_t l = 0; l < lanes; l++) {
+                const Quaternion& q = quaternions[i + l];
+                block[4 * l] = q.w, block[4 * l + 1] = q.x, block[4 * l + 2] = q.y, block[4 * l + 3] = q.z;
+            }
+            Load4x8(block, w, v[0], v[1], v[2]);
+        }
+        const __m256 qi = v[a0], qj = v[a1], qk = v[a2];
+        const __m256 ii = _mm256_mul_ps(qi, qi), jj = _mm256_mul_ps(qj, qj), kk = _mm256_mul_ps(qk, qk);
+        const __m256 n = _mm256_fmadd_ps(w, w, _mm256_add_ps(ii, _mm256_add_ps(jj, kk)));
+        const __m256 ij = _mm256_mul_ps(parity, _mm256_mul_ps(qi, qj));
+        const __m256 ik = _mm256_mul_ps(parity, _mm256_mul_ps(qi, qk));
+        const __m256 jk = _mm256_mul_ps(parity, _mm256_mul_ps(qj, qk));
+
+        const __m256 sinBeta = _mm256_mul_ps(two, _mm256_fmadd_ps(w, qj, ik));
+        const __m256 mii = _mm256_fnmadd_ps(two, _mm256_add_ps(jj, kk), n);
+        const __m256 mij = _mm256_mul_ps(two, _mm256_fmsub_ps(w, qk, ij));
+        const __m256 cosBeta = _mm256_sqrt_ps(_mm256_fmadd_ps(mii, mii, _mm256_mul_ps(mij, mij)));
+        const __m256 gimbal = _mm256_cmp_ps(cosBeta, _mm256_mul_ps(_mm256_set1_ps(epsilon), n), _CMP_LE_OQ);
+
+        __m256 a = Atan2FMA(_mm256_mul_ps(two, _mm256_fmsub_ps(w, qi, jk)), _mm256_fnmadd_ps(two, _mm256_add_ps(ii, jj), n));
+        __m256 b = Atan2FMA(sinBeta, cosBeta);
+        __m256 g = Atan2FMA(mij, mii);
+        if (_mm256_movemask_ps(gimbal) != 0) {
+            const __m256 lockedGamma = Atan2FMA(
+                _mm256_mul_ps(two, _mm256_fmadd_ps(w, qk, ij)), _mm256_fnmadd_ps(two, _mm256_add_ps(ii, kk), n)
+            );
+            a = _mm256_andnot_ps(gimbal, a);
+            b = _mm256_blendv_ps(b, _mm256_or_ps(halfPi, _mm256_and_ps(sinBeta, signMask)), gimbal);
+            g = _mm256_blendv_ps(g, lockedGamma, gimbal);
+        }
+        _mm256_maskstore_ps(alpha + i, mask, a);
+        _mm256_maskstore_ps(beta + i, mask, b);
+        _mm256_maskstore_ps(gamma + i, mask, g);
+    }
+}
+#endif
+
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Euler::ToQuaternions stores quaternions as 4 packed floats.");
+static_assert(sizeof(Matrix4) == 16 * sizeof(float), "Euler::ToMatrices stores matrices as 16 packed floats.");
+
+void Euler::ToMatrices(const float* alpha, const float* beta, const float* gamma, Order order, Matrix4* out, size_t count) {
+    DispatchOrder(order, [&](auto o) {
+        switch (SIMD::Current()) {
+#if W_ENGINE_X86
+            case SIMD::Level::AVX512:
+            case SIMD::Level::FMA: return ToMatricesFMA<decltype(o)::value>(alpha, beta, gamma, out, count);
+#endif
+            default: return ToMatricesScalar<decltype(o)::value>(alpha, beta, gamma, out, 0, count);
+        }
+    });
+}
 
-        } catch (const std::invalid_argument&) {
-            std::cout << "\nInvalid input. Please enter a valid number, 'exit', or 'clear'.\n";
+static void ToQuaternionsDispatch(const float* alpha, const float* beta, const float* gamma, Euler::Order order, Quaternion* out,
+                                  QuaternionStream* stream, size_t count) {
+    DispatchOrder(order, [&](auto o) {
+        switch (SIMD::Current()) {
+#if W_ENGINE_X86
+            case SIMD::Level::AVX512:
+            case SIMD::Level::FMA: return ToQuaternionsFMA<decltype(o)::value>(alpha, beta, gamma, out, stream, count);
+#endif
+            default: return ToQuaternionsScalar<decltype(o)::value>(alpha, beta, gamma, out, stream, 0, count);
         }
+    });
+}
+
+void Euler::ToQuaternions(const float* alpha, const float* beta, const float* gamma, Order order, Quaternion* out, size_t count) {
+    ToQuaternionsDispatch(alpha, beta, gamma, order, out, nullptr, count);
+}
+
+void Euler::ToQuaternions(const float* alpha, const float* beta, const float* gamma, Order order, QuaternionStream& out, size_t count) {
+    if (count > out.count) {
+        throw std::out_of_range("Euler::ToQuaternions count exceeds the stream size.");
     }
-    return 0;
+    ToQuaternionsDispatch(alpha, beta, gamma, order, nullptr, &out, count);
 }
 
+static void FromQuaternionsDispatch(const Quaternion* q, const QuaternionStream* stream, Euler::Order order, float* alpha, float* beta,
+                                    float* gamma, size_t count, float epsilon) {
+    DispatchOrder(order, [&](auto o) {
+        switch (SIMD::Current()) {
+#if W_ENGINE_X86
+            case SIMD::Level::AVX512:
+            case SIMD::Level::FMA: return FromQuaternionsFMA<decltype(o)::value>(q, stream, alpha, beta, gamma, count, epsilon);
+#endif
+            default: return FromQuaternionsScalar<decltype(o)::value>(q, stream, alpha, beta, gamma, count, epsilon);
+        }
+    });
+}
 
+void Euler::FromQuaternions(const Quaternion* q, Order order, float* alpha, float* beta, float* gamma, size_t count, float epsilon) {
+    FromQuaternionsDispatch(q, nullptr, order, alpha, beta, gamma, count, epsilon);
+}
 
+void Euler::FromQuaternions(const QuaternionStream& q, Order order, float* alpha, float* beta, float* gamma, size_t count, float epsilon) {
+    if (count > q.count) {
+        throw std::out_of_range("Euler::FromQuaternions count exceeds the stream size.");
+    }
+    FromQuaternionsDispatch(nullptr, &q, order, alpha, beta, gamma, count, epsilon);
+}
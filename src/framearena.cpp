@@ -0,0 +1,83 @@
+#include "../include/framearena.h"
+#include <cstdint>
+#include <stdexcept>
+
+FrameArena::FrameArena(size_t blockSize): blockSize(blockSize) {
+    if (blockSize > 0) AddBlock(blockSize);
+}
+
+FrameArena& FrameArena::ForThread() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void FrameArena::AddBlock(size_t minimumSize) {
+    // Blocks of one frame grow geometrically, Reset merges them afterwards.
+    size_t size = blocks.empty() ? blockSize : 2 * blocks.back().size;
+    if (size < minimumSize) size = minimumSize;
+    blocks.push_back(Block{ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+    stats.heapAllocations++;
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        throw std::invalid_argument("FrameArena alignment must be a power of two.");
+    }
+    while (true) {
+        if (block < blocks.size()) {
+            Block& current = blocks[block];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(current.data.get());
+            const size_t start = static_cast<size_t>(((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+            if (start <= current.size && bytes <= current.size - start) {
+                stats.bytes += start + bytes - offset;
+                stats.allocations++;
+                offset = start + bytes;
+                return current.data.get() + start;
+            }
+            // The rest of the block stays unused until the arena is rewound before it.
+            stats.bytes += current.size - offset;
+            block++;
+            offset = 0;
+            if (block < blocks.size()) continue;
+        }
+        AddBlock(bytes + alignment);
+        block = blocks.size() - 1;
+    }
+}
+
+FrameArena::Marker FrameArena::Mark() const {
+    return Marker{ block, offset, stats.bytes };
+}
+
+void FrameArena::Rewind(const Marker& marker) {
+    if (marker.block > block || (marker.block == block && marker.offset > offset)) {
+        throw std::out_of_range("FrameArena marker is past the current position.");
+    }
+    block = marker.block;
+    offset = marker.offset;
+    stats.bytes = marker.bytes;
+}
+
+void FrameArena::Reset() {
+    if (stats.bytes > stats.peakBytes) stats.peakBytes = stats.bytes;
+    if (blocks.size() > 1) {
+        const size_t total = Capacity();
+        blocks.clear();
+        blockSize = total > blockSize ? total : blockSize;
+        AddBlock(total);
+    }
+    block = 0;
+    offset = 0;
+    stats.bytes = 0;
+    stats.allocations = 0;
+}
+
+const FrameArena::Stats& FrameArena::GetStats() const {
+    return stats;
+}
+
+size_t FrameArena::Capacity() const {
+    size_t total = 0;
+    for (const Block& b : blocks) total += b.size;
+    return total;
+}
@@ -0,0 +1,19 @@
+#include "../include/framebuffer.h"
+#include <algorithm>
+
+void Framebuffer::Clear(uint32_t color, float depth) {
+    for (int y = 0; y < height; y++) {
+        const size_t row = static_cast<size_t>(y) * pitch;
+        if (this->color) std::fill(this->color + row, this->color + row + width, color);
+        if (this->depth) std::fill(this->depth + row, this->depth + row + width, depth);
+    }
+}
+
+Framebuffer Framebuffer::Region(int x, int y, int width, int height) const {
+    const size_t offset = static_cast<size_t>(y) * pitch + x;
+    return Framebuffer(
+        color ? color + offset : nullptr,
+        depth ? depth + offset : nullptr,
+        width, height, pitch
+    );
+}
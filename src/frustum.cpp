@@ -0,0 +1,168 @@
+#include "../include/frustum.h"
+#include "../include/matrix4.h"
+#include "../include/vector4stream.h"
+#include "../include/simd.h"
+#include <cmath>
+#include <stdexcept>
+
+Frustum::Frustum(const Matrix4& m, Depth depth) {
+    const Vector4 row1(m.m11, m.m12, m.m13, m.m14);
+    const Vector4 row2(m.m21, m.m22, m.m23, m.m24);
+    const Vector4 row3(m.m31, m.m32, m.m33, m.m34);
+    const Vector4 row4(m.m41, m.m42, m.m43, m.m44);
+
+    // -w <= x, y <= w, and -w <= z <= w or 0 <= z <= w in clip space.
+    planes[0] = row4.Add(row1);
+    planes[1] = row4.Subtract(row1);
+    planes[2] = row4.Add(row2);
+    planes[3] = row4.Subtract(row2);
+    planes[4] = depth == Depth::NegativeOneToOne ? Vector4(row4.Add(row3)) : row3;
+    planes[5] = row4.Subtract(row3);
+
+    for (Vector4& plane : planes) {
+        const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0) plane = plane.Scale(1.0f / length);
+    }
+}
+
+Frustum::Result Frustum::TestSphere(const Vector4& sphere, uint8_t& planeMask) const {
+    uint8_t intersecting = 0;
+    for (int i = 0; i < 6; i++) {
+        if (!(planeMask & (1u << i))) continue;
+        const Vector4& p = planes[i];
+        const float distance = p.x * sphere.x + p.y * sphere.y + p.z * sphere.z + p.w;
+        if (distance < -sphere.w) return Result::Outside;
+        if (distance < sphere.w) intersecting |= 1u << i;
+    }
+    planeMask = intersecting;
+    return intersecting ? Result::Intersect : Result::Inside;
+}
+
+Frustum::Result Frustum::TestBox(const Vector4& center, const Vector4& extent, uint8_t& planeMask) const {
+    uint8_t intersecting = 0;
+    for (int i = 0; i < 6; i++) {
+        if (!(planeMask & (1u << i))) continue;
+        const Vector4& p = planes[i];
+        const float distance = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+        // Projection of the half size onto the plane normal.
+        const float radius = std::fabs(p.x) * extent.x + std::fabs(p.y) * extent.y + std::fabs(p.z) * extent.z;
+        if (distance < -radius) return Result::Outside;
+        if (distance < radius) intersecting |= 1u << i;
+    }
+    planeMask = intersecting;
+    return intersecting ? Result::Intersect : Result::Inside;
+}
+
+static size_t CullScalar(const Vector4* planes, uint8_t planeMask, const Vector4Stream& centers, const Vector4Stream* extents,
+                         uint32_t* visible, size_t count) {
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; p++) {
+            if (!(planeMask & (1u << p))) continue;
+            const Vector4& plane = planes[p];
+            const float distance = plane.x * centers.x[i] + plane.y * centers.y[i] + plane.z * centers.z[i] + plane.w;
+            const float radius = extents == nullptr
+                ? centers.w[i]
+                : std::fabs(plane.x) * extents->x[i] + std::fabs(plane.y) * extents->y[i] + std::fabs(plane.z) * extents->z[i];
+            inside = distance >= -radius;
+        }
+        if (inside) visible[written++] = static_cast<uint32_t>(i);
+    }
+    return written;
+}
+
+#if W_ENGINE_X86
+// Lane indices of the set bits of every 8-bit mask, packed to the front.
+struct CompressTable {
+    uint32_t lanes[256][8];
+
+    constexpr CompressTable(): lanes() {
+        for (int mask = 0; mask < 256; mask++) {
+            int n = 0;
+            for (int lane = 0; lane < 8; lane++) {
+                if (mask & (1 << lane)) lanes[mask][n++] = lane;
+            }
+        }
+    }
+};
+
+static constexpr CompressTable compressTable;
+
+static const int cullTailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+W_ENGINE_TARGET("avx2,fma")
+static size_t CullAVX2(const Vector4* planes, uint8_t planeMask, const Vector4Stream& centers, const Vector4Stream* extents,
+                       uint32_t* visible, size_t count) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    size_t written = 0;
+    for (size_t i = 0; i < count; i += 8) {
+        const size_t lanes = count - i < 8 ? count - i : 8;
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cullTailMask + 8 - lanes));
+        const __m256 x = _mm256_maskload_ps(centers.x + i, tail), y = _mm256_maskload_ps(centers.y + i, tail);
+        const __m256 z = _mm256_maskload_ps(centers.z + i, tail);
+        __m256 ex = _mm256_setzero_ps(), ey = _mm256_setzero_ps(), ez = _mm256_setzero_ps(), radius = _mm256_setzero_ps();
+        if (extents == nullptr) {
+            radius = _mm256_maskload_ps(centers.w + i, tail);
+        } else {
+            ex = _mm256_maskload_ps(extents->x + i, tail);
+            ey = _mm256_maskload_ps(extents->y + i, tail);
+            ez = _mm256_maskload_ps(extents->z + i, tail);
+        }
+
+        __m256 inside = _mm256_castsi256_ps(tail);
+        for (int p = 0; p < 6; p++) {
+            if (!(planeMask & (1u << p))) continue;
+            const __m256 a = _mm256_set1_ps(planes[p].x), b = _mm256_set1_ps(planes[p].y), c = _mm256_set1_ps(planes[p].z);
+            __m256 distance = _mm256_fmadd_ps(a, x, _mm256_set1_ps(planes[p].w));
+            distance = _mm256_fmadd_ps(b, y, distance);
+            distance = _mm256_fmadd_ps(c, z, distance);
+            __m256 r = radius;
+            if (extents != nullptr) {
+                r = _mm256_mul_ps(_mm256_and_ps(a, absMask), ex);
+                r = _mm256_fmadd_ps(_mm256_and_ps(b, absMask), ey, r);
+                r = _mm256_fmadd_ps(_mm256_and_ps(c, absMask), ez, r);
+            }
+            // distance + r >= 0, NaN compares false and culls the volume.
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, r), _mm256_setzero_ps(), _CMP_GE_OQ));
+            if (_mm256_testz_ps(inside, inside)) break;
+        }
+
+        const int mask = _mm256_movemask_ps(inside);
+        if (mask == 0) continue;
+        const int n = __builtin_popcount(mask);
+        const __m256i indices = _mm256_add_epi32(
+            _mm256_set1_epi32(static_cast<int>(i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compressTable.lanes[mask]))
+        );
+        const __m256i store = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cullTailMask + 8 - n));
+        _mm256_maskstore_epi32(reinterpret_cast<int*>(visible + written), store, indices);
+        written += n;
+    }
+    return written;
+}
+#endif
+
+size_t Frustum::CullSpheres(const Vector4Stream& spheres, uint32_t* visible, uint8_t planeMask) const {
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return CullAVX2(planes, planeMask, spheres, nullptr, visible, spheres.count);
+#endif
+        default: return CullScalar(planes, planeMask, spheres, nullptr, visible, spheres.count);
+    }
+}
+
+size_t Frustum::CullBoxes(const Vector4Stream& centers, const Vector4Stream& extents, uint32_t* visible, uint8_t planeMask) const {
+    if (extents.count < centers.count) {
+        throw std::out_of_range("CullBoxes extents are shorter than the centers.");
+    }
+
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return CullAVX2(planes, planeMask, centers, &extents, visible, centers.count);
+#endif
+        default: return CullScalar(planes, planeMask, centers, &extents, visible, centers.count);
+    }
+}
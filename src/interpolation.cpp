@@ -1,18 +1,64 @@
 #include "../include/interpolation.h"
+#include "../include/framearena.h"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
 
-std::vector<float> Interpolation::Linear(float xA, float yA, float xB, float yB, float step = 1) {
-    std::vector<float> values;
-    if (xA == xB) {
-        values.push_back(yA);
-        return values;
+size_t Interpolation::LinearCount(float xA, float xB, float step) {
+    if (!(step > 0.0f) || !std::isfinite(step) || !std::isfinite(xA) || !std::isfinite(xB)) {
+        throw std::invalid_argument("Interpolation requires finite coordinates and a positive finite step.");
+    }
+    if (xB < xA) return 0;
+    // Tolerance keeps the last sample when xB - xA is a multiple of a step that is not representable in float (0.1f).
+    const double intervals = std::floor((static_cast<double>(xB) - xA) / step + 1e-5);
+    if (intervals >= static_cast<double>(maxCount)) {
+        throw std::invalid_argument("Interpolation produces more than Interpolation::maxCount values.");
+    }
+    return static_cast<size_t>(intervals) + 1;
+}
+
+size_t Interpolation::Linear(float xA, float yA, float xB, float yB, float step, float* out, size_t capacity) {
+    const size_t count = LinearCount(xA, xB, step);
+    const size_t n = count < capacity ? count : capacity;
+    const float increment = xA == xB ? 0.0f : (yB - yA) / (xB - xA) * step;
+    // A 32-bit index converts to float in vector registers, size_t does not.
+    for (int32_t j = 0; j < static_cast<int32_t>(n); j++) {
+        out[j] = yA + static_cast<float>(j) * increment;
+    }
+    return count;
+}
+
+size_t Interpolation::LinearFixed(float xA, float yA, float xB, float yB, float step, int32_t* out, size_t capacity) {
+    if (!(std::fabs(yA) < 32768.0f) || !(std::fabs(yB) < 32768.0f)) {
+        throw std::invalid_argument("Interpolation::LinearFixed values must fit into 16.16 fixed point.");
+    }
+    const size_t count = LinearCount(xA, xB, step);
+    const size_t n = count < capacity ? count : capacity;
+    // With two or more values xB - xA is at least about a step, so the increment stays below 2^33.
+    const int64_t increment = count < 2 ? 0 : std::llround((static_cast<double>(yB) - yA) / (static_cast<double>(xB) - xA) * step * 65536.0);
+    const int64_t first = std::llround(yA * 65536.0);
+    const int64_t last = first + (n > 0 ? static_cast<int64_t>(n - 1) * increment : 0);
+    // The values are monotonic, so when the last one fits, all of them do and the 32-bit accumulation is exact.
+    // It is done in unsigned arithmetic, which wraps, so the addition past the last value is defined as well.
+    if (last >= INT32_MIN && last <= INT32_MAX) {
+        uint32_t value = static_cast<uint32_t>(first);
+        for (size_t j = 0; j < n; j++, value += static_cast<uint32_t>(increment)) {
+            out[j] = static_cast<int32_t>(value);
+        }
+        return count;
     }
-    float k = (yB - yA) / (xB - xA);
-    float b = yA;
-    for (float i = xA; i <= xB; i += step) {
-        values.push_back(b);
-        b += k;
+    // The rounding of the increment carried the last values past the 16.16 range.
+    int64_t value = first;
+    for (size_t j = 0; j < n; j++, value += increment) {
+        out[j] = static_cast<int32_t>(std::min<int64_t>(std::max<int64_t>(value, INT32_MIN), INT32_MAX));
     }
+    return count;
+}
+
+std::vector<float> Interpolation::Linear(float xA, float yA, float xB, float yB, float step = 1) {
+    std::vector<float> values(LinearCount(xA, xB, step));
+    Interpolation::Linear(xA, yA, xB, yB, step, values.data(), values.size());
     return values;
 }
 
@@ -23,4 +69,25 @@ std::vector<std::vector<float>> Interpolation::Edge(float xA, float yA, float xB
     ab.pop_back();
     ab.insert(ab.end(), bc.begin(), bc.end());
     return {ac, ab};
+}
+
+const float* Interpolation::Linear(float xA, float yA, float xB, float yB, float step, FrameArena& arena, size_t& count) {
+    count = LinearCount(xA, xB, step);
+    float* values = arena.Allocate<float>(count);
+    Interpolation::Linear(xA, yA, xB, yB, step, values, count);
+    return values;
+}
+
+Interpolation::EdgeValues Interpolation::Edge(float xA, float yA, float xB, float yB, float xC, float yC, float step, FrameArena& arena) {
+    EdgeValues edges;
+    edges.ac = Interpolation::Linear(yA, xA, yC, xC, step, arena, edges.acCount);
+    const size_t abCount = LinearCount(yA, yB, step), bcCount = LinearCount(yB, yC, step);
+    // The last value of AB is dropped, like the pop_back of the vector overload.
+    const size_t abKept = abCount > 0 ? abCount - 1 : 0;
+    float* abc = arena.Allocate<float>(abKept + bcCount);
+    Interpolation::Linear(yA, xA, yB, xB, step, abc, abKept);
+    Interpolation::Linear(yB, xB, yC, xC, step, abc + abKept, bcCount);
+    edges.abc = abc;
+    edges.abcCount = abKept + bcCount;
+    return edges;
 }
\ No newline at end of file
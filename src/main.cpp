@@ -0,0 +1,76 @@
+#include "../include/euler.h"
+#include "../include/matrix4.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <cstdlib>
+void clearConsole() {
+    system("cls");
+    std::cout << "\n" << std::endl;
+}
+#else
+void clearConsole() {
+    std::cout << "\033[2J\033[H\n" << std::endl;
+}
+#endif
+
+int main() {
+    float rad = M_PI / 180.0;
+    float deg = 180.0 / M_PI;
+    std::string input;
+
+    while (true) {
+        std::cout << "Type 'exit' to quit, 'clear' to clear console.\n";
+        
+        if (input == "exit") {
+            break;
+        } else if (input == "clear") {
+            clearConsole();
+            continue;
+        }
+
+        try {
+            std::cout << "\n______________________________________________________________________________________\n" <<std::endl;
+            std::cout << "\nEnter alpha (degrees): ";
+            std::cin >> input;
+            float alphaDeg = std::stof(input);
+            std::cout << "Enter beta (degrees):  ";
+            std::cin >> input;
+            float betaDeg = std::stof(input);
+            std::cout << "Enter gamma (degrees): ";
+            std::cin >> input;
+            float gammaDeg = std::stof(input);
+            std::cout << "Enter order (xyz, xzy) ";
+            std::cin >> input;
+
+            float alpha = alphaDeg * rad;
+            float beta = betaDeg * rad;
+            float gamma = gammaDeg * rad;
+
+            Euler euler = Euler(alpha, beta, gamma, input);
+            Matrix4 rotationMatrix = euler.RotateXYZ();
+            std::cout << "Euler angles:\n" << std::endl;
+            euler.Print(3);
+
+            std::cout << "Rotation matrix:\n" << std::endl;
+            rotationMatrix.Print(3);
+
+            Euler::Order order = Euler::StringToOrder(input);
+
+            std::cout << "Current Euler order is " << Euler::OrderToString(order) << std::endl;
+
+            Euler resultEuler = Euler::Decompose(rotationMatrix, order);
+
+            std::cout << Euler::OrderToString(resultEuler.order) << " computed angles:\n";
+            std::cout << "\n\talpha: " << resultEuler.alpha * deg << "\n\tbeta: " << resultEuler.beta * deg << "\n\tgamma: " << resultEuler.gamma * deg << "\n\torder: " << Euler::OrderToString(resultEuler.order) << "\n\n";
+
+            resultEuler.Print(3);
+
+            std::cout << "______________________________________________________________________________________\n" <<std::endl;
+
+        } catch (const std::invalid_argument&) {
+            std::cout << "\nInvalid input. Please enter a valid number, 'exit', or 'clear'.\n";
+        }
+    }
+    return 0;
+}
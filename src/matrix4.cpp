@@ -1,8 +1,14 @@
 
 #include "../include/matrix4.h"
 #include "../include/vector4.h"
+#include "../include/simd.h"
+#include "../include/vector4stream.h"
 #include <iomanip>    
 #include <iostream>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
 
 void Matrix4::Print(const int& precision = 6) const {
     std::cout << std::fixed << std::setprecision(precision) << "Matrix4[[ m11: " << m11 << " m12: " << m12 << " m13: " << m13 << " m14: " << m14 << " ]," << std::endl;
@@ -11,75 +17,250 @@ void Matrix4::Print(const int& precision = 6) const {
     std::cout << std::fixed << std::setprecision(precision) << "        [ m41: " << m41 << " m42: " << m42 << " m43: " << m43 << " m44: " << m44 << " ]]\n" << std::endl;
 }
 
-Matrix4  Matrix4::Clone() const {
-    return Matrix4(
-        m11, m12, m13, m14,
-        m21, m22, m23, m24,
-        m31, m32, m33, m34,
-        m41, m42, m43, m44
-    );
+static_assert(sizeof(Matrix4) == 16 * sizeof(float), "Matrix4 rows must be tightly packed.");
+static_assert(offsetof(Matrix4, m21) == 4 * sizeof(float), "Matrix4 rows must be contiguous.");
+static_assert(offsetof(Matrix4, m41) == 12 * sizeof(float), "Matrix4 rows must be contiguous.");
+
+// Compile-time checks of the constexpr arithmetic, constant transforms are folded through the scalar formulas.
+static constexpr Matrix4 checkTranslation(1, 0, 0, 5, 0, 1, 0, 6, 0, 0, 1, 7, 0, 0, 0, 1);
+static constexpr Matrix4 checkScale(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 0, 0, 0, 1);
+static_assert(checkScale.Determinant() == 24, "Matrix4::Determinant");
+static_assert(checkTranslation.Transpose().m41 == 5 && checkTranslation.Transpose().m14 == 0, "Matrix4::Transpose");
+static_assert(checkTranslation.MultiplyVector(Vector4(1, 2, 3, 1)).Equals(Vector4(6, 8, 10, 1)), "Matrix4::MultiplyVector");
+static_assert(checkTranslation.MultiplyMatrix(checkScale).MultiplyVector(Vector4(1, 1, 1, 1)).Equals(Vector4(7, 9, 11, 1)),
+              "Matrix4::MultiplyMatrix must apply the right operand first.");
+static_assert(checkScale.Add(checkScale).Subtract(checkScale.Scale(2)).Determinant() == 0, "Matrix4::Add, Subtract, Scale");
+
+// Every kernel sums the four products of a coefficient in the same left-to-right order as the
+// scalar code, so SSE2 and AVX2 reproduce it bit for bit (as long as the scalar build does not
+// contract a*b+c into fma). The FMA kernels round once per multiply-add and are only ulp-close.
+
+#if W_ENGINE_X86
+W_ENGINE_TARGET("sse2")
+static Matrix4 MultiplyMatrixSSE2(const Matrix4& a, const Matrix4& m) {
+    const __m128 b1 = _mm_load_ps(&m.m11);
+    const __m128 b2 = _mm_load_ps(&m.m21);
+    const __m128 b3 = _mm_load_ps(&m.m31);
+    const __m128 b4 = _mm_load_ps(&m.m41);
+    const float* rowsA[4] = { &a.m11, &a.m21, &a.m31, &a.m41 };
+
+    Matrix4 result;
+    float* rowsResult[4] = { &result.m11, &result.m21, &result.m31, &result.m41 };
+    for (int i = 0; i < 4; i++) {
+        const __m128 row = _mm_load_ps(rowsA[i]);
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b1);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b3));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b4));
+        _mm_store_ps(rowsResult[i], r);
+    }
+    return result;
 }
 
-Matrix4 Matrix4::Transpose() const {
-    return Matrix4(
-        m11, m21, m31, m41,
-        m12, m22, m32, m42,
-        m13, m23, m33, m43,
-        m14, m24, m34, m44
-    );
+W_ENGINE_TARGET("avx2")
+static Matrix4 MultiplyMatrixAVX2(const Matrix4& a, const Matrix4& m) {
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m11));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m21));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m31));
+    const __m256 b4 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m41));
+
+    Matrix4 result;
+    const float* rowsA[2] = { &a.m11, &a.m31 };
+    float* rowsResult[2] = { &result.m11, &result.m31 };
+    for (int i = 0; i < 2; i++) {
+        const __m256 rows = _mm256_loadu_ps(rowsA[i]);
+        __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b1);
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b2));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b3));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b4));
+        _mm256_storeu_ps(rowsResult[i], r);
+    }
+    return result;
 }
 
-float Matrix4::Determinant() const {
-    const float m3344_3443 = m33 * m44 - m34 * m43;
-    const float m3244_3442 = m32 * m44 - m34 * m42;
-    const float m3243_3342 = m32 * m43 - m33 * m42;
-    const float m3144_3441 = m31 * m44 - m34 * m41;
-    const float m3143_3341 = m31 * m43 - m33 * m41;
-    const float m3142_3241 = m31 * m42 - m32 * m41;
+W_ENGINE_TARGET("avx2,fma")
+static Matrix4 MultiplyMatrixFMA(const Matrix4& a, const Matrix4& m) {
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m11));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m21));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m31));
+    const __m256 b4 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.m41));
+
+    Matrix4 result;
+    const float* rowsA[2] = { &a.m11, &a.m31 };
+    float* rowsResult[2] = { &result.m11, &result.m31 };
+    for (int i = 0; i < 2; i++) {
+        const __m256 rows = _mm256_loadu_ps(rowsA[i]);
+        __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b1);
+        r = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, 0x55), b2, r);
+        r = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b3, r);
+        r = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b4, r);
+        _mm256_storeu_ps(rowsResult[i], r);
+    }
+    return result;
+}
+
+W_ENGINE_TARGET("sse2")
+static Vector4 MultiplyVectorSSE2(const Matrix4& a, const Vector4& v) {
+    __m128 c1 = _mm_load_ps(&a.m11);
+    __m128 c2 = _mm_load_ps(&a.m21);
+    __m128 c3 = _mm_load_ps(&a.m31);
+    __m128 c4 = _mm_load_ps(&a.m41);
+    _MM_TRANSPOSE4_PS(c1, c2, c3, c4);
+
+    __m128 r = _mm_mul_ps(c1, _mm_set1_ps(v.x));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v.y)));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v.z)));
+    r = _mm_add_ps(r, _mm_mul_ps(c4, _mm_set1_ps(v.w)));
 
-    return  m11 * (m22 * m3344_3443 - m23 * m3244_3442 + m24 * m3243_3342)-
-            m12 * (m21 * m3344_3443 - m23 * m3144_3441 + m24 * m3143_3341)+
-            m13 * (m21 * m3244_3442 - m22 * m3144_3441 + m24 * m3142_3241)-
-            m14 * (m21 * m3243_3342 - m22 * m3143_3341 + m23 * m3142_3241);
+    alignas(16) float result[4];
+    _mm_store_ps(result, r);
+    return Vector4(result[0], result[1], result[2], result[3]);
 }
 
-Matrix4 Matrix4::MultiplyMatrix(const Matrix4& m) const {
-    return Matrix4(
-        m11 * m.m11 + m12 * m.m21 + m13 * m.m31 + m14 * m.m41,
-        m11 * m.m12 + m12 * m.m22 + m13 * m.m32 + m14 * m.m42,
-        m11 * m.m13 + m12 * m.m23 + m13 * m.m33 + m14 * m.m43,
-        m11 * m.m14 + m12 * m.m24 + m13 * m.m34 + m14 * m.m44,
-        m21 * m.m11 + m22 * m.m21 + m23 * m.m31 + m24 * m.m41,
-        m21 * m.m12 + m22 * m.m22 + m23 * m.m32 + m24 * m.m42,
-        m21 * m.m13 + m22 * m.m23 + m23 * m.m33 + m24 * m.m43,
-        m21 * m.m14 + m22 * m.m24 + m23 * m.m34 + m24 * m.m44,
-        m31 * m.m11 + m32 * m.m21 + m33 * m.m31 + m34 * m.m41,
-        m31 * m.m12 + m32 * m.m22 + m33 * m.m32 + m34 * m.m42,
-        m31 * m.m13 + m32 * m.m23 + m33 * m.m33 + m34 * m.m43,
-        m31 * m.m14 + m32 * m.m24 + m33 * m.m34 + m34 * m.m44,
-        m41 * m.m11 + m42 * m.m21 + m43 * m.m31 + m44 * m.m41,
-        m41 * m.m12 + m42 * m.m22 + m43 * m.m32 + m44 * m.m42,
-        m41 * m.m13 + m42 * m.m23 + m43 * m.m33 + m44 * m.m43,
-        m41 * m.m14 + m42 * m.m24 + m43 * m.m34 + m44 * m.m44
-    );
+W_ENGINE_TARGET("avx2,fma")
+static Vector4 MultiplyVectorFMA(const Matrix4& a, const Vector4& v) {
+    __m128 c1 = _mm_load_ps(&a.m11);
+    __m128 c2 = _mm_load_ps(&a.m21);
+    __m128 c3 = _mm_load_ps(&a.m31);
+    __m128 c4 = _mm_load_ps(&a.m41);
+    _MM_TRANSPOSE4_PS(c1, c2, c3, c4);
+
+    __m128 r = _mm_mul_ps(c1, _mm_set1_ps(v.x));
+    r = _mm_fmadd_ps(c2, _mm_set1_ps(v.y), r);
+    r = _mm_fmadd_ps(c3, _mm_set1_ps(v.z), r);
+    r = _mm_fmadd_ps(c4, _mm_set1_ps(v.w), r);
+
+    alignas(16) float result[4];
+    _mm_store_ps(result, r);
+    return Vector4(result[0], result[1], result[2], result[3]);
 }
+#endif
 
-Vector4 Matrix4::MultiplyVector(const Vector4& v) const {
-    return Vector4(
-        m11 * v.x + m12 * v.y + m13 * v.z + m14 * v.w,
-        m21 * v.x + m22 * v.y + m23 * v.z + m24 * v.w,
-        m31 * v.x + m32 * v.y + m33 * v.z + m34 * v.w,
-        m41 * v.x + m42 * v.y + m43 * v.z + m44 * v.w
-    );
+Matrix4 Matrix4::MultiplyMatrixRuntime(const Matrix4& m) const {
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return MultiplyMatrixFMA(*this, m);
+        case SIMD::Level::AVX2: return MultiplyMatrixAVX2(*this, m);
+        case SIMD::Level::SSE2: return MultiplyMatrixSSE2(*this, m);
+#endif
+        default: return Mat<float, 4, 4>::MultiplyMatrix(m);
+    }
 }
 
-Matrix4 Matrix4::Scale(const float& scale) const {
-    return Matrix4(
-        m11 * scale, m12 * scale, m13 * scale, m14 * scale,
-        m21 * scale, m22 * scale, m23 * scale, m24 * scale,
-        m31 * scale, m32 * scale, m33 * scale, m34 * scale,
-        m41 * scale, m42 * scale, m43 * scale, m44 * scale
-    );
+Vector4 Matrix4::MultiplyVectorRuntime(const Vector4& v) const {
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return MultiplyVectorFMA(*this, v);
+        case SIMD::Level::AVX2:
+        case SIMD::Level::SSE2: return MultiplyVectorSSE2(*this, v);
+#endif
+        default: return Mat<float, 4, 4>::MultiplyVector(v);
+    }
+}
+
+static void TransformStreamScalar(const Matrix4& a, const Vector4Stream& in, Vector4Stream& out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const float x = in.x[i], y = in.y[i], z = in.z[i], w = in.w[i];
+        out.x[i] = a.m11 * x + a.m12 * y + a.m13 * z + a.m14 * w;
+        out.y[i] = a.m21 * x + a.m22 * y + a.m23 * z + a.m24 * w;
+        out.z[i] = a.m31 * x + a.m32 * y + a.m33 * z + a.m34 * w;
+        out.w[i] = a.m41 * x + a.m42 * y + a.m43 * z + a.m44 * w;
+    }
+}
+
+#if W_ENGINE_X86
+W_ENGINE_TARGET("sse2")
+static void TransformStreamSSE2(const Matrix4& a, const Vector4Stream& in, Vector4Stream& out, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(in.x + i), y = _mm_loadu_ps(in.y + i);
+        const __m128 z = _mm_loadu_ps(in.z + i), w = _mm_loadu_ps(in.w + i);
+        const float* rows[4] = { &a.m11, &a.m21, &a.m31, &a.m41 };
+        float* outs[4] = { out.x + i, out.y + i, out.z + i, out.w + i };
+        for (int r = 0; r < 4; r++) {
+            __m128 v = _mm_mul_ps(_mm_set1_ps(rows[r][0]), x);
+            v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(rows[r][1]), y));
+            v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(rows[r][2]), z));
+            v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(rows[r][3]), w));
+            _mm_storeu_ps(outs[r], v);
+        }
+    }
+    TransformStreamScalar(a, in, out, i, count);
+}
+
+static const int tailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+W_ENGINE_TARGET("avx2")
+static void TransformStreamAVX2(const Matrix4& a, const Vector4Stream& in, Vector4Stream& out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tailMask + 8 - (count - i < 8 ? count - i : 8)));
+        const __m256 x = _mm256_maskload_ps(in.x + i, mask), y = _mm256_maskload_ps(in.y + i, mask);
+        const __m256 z = _mm256_maskload_ps(in.z + i, mask), w = _mm256_maskload_ps(in.w + i, mask);
+        const float* rows[4] = { &a.m11, &a.m21, &a.m31, &a.m41 };
+        float* outs[4] = { out.x + i, out.y + i, out.z + i, out.w + i };
+        for (int r = 0; r < 4; r++) {
+            __m256 v = _mm256_mul_ps(_mm256_set1_ps(rows[r][0]), x);
+            v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_set1_ps(rows[r][1]), y));
+            v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_set1_ps(rows[r][2]), z));
+            v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_set1_ps(rows[r][3]), w));
+            _mm256_maskstore_ps(outs[r], mask, v);
+        }
+    }
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static void TransformStreamFMA(const Matrix4& a, const Vector4Stream& in, Vector4Stream& out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tailMask + 8 - (count - i < 8 ? count - i : 8)));
+        const __m256 x = _mm256_maskload_ps(in.x + i, mask), y = _mm256_maskload_ps(in.y + i, mask);
+        const __m256 z = _mm256_maskload_ps(in.z + i, mask), w = _mm256_maskload_ps(in.w + i, mask);
+        const float* rows[4] = { &a.m11, &a.m21, &a.m31, &a.m41 };
+        float* outs[4] = { out.x + i, out.y + i, out.z + i, out.w + i };
+        for (int r = 0; r < 4; r++) {
+            __m256 v = _mm256_mul_ps(_mm256_set1_ps(rows[r][0]), x);
+            v = _mm256_fmadd_ps(_mm256_set1_ps(rows[r][1]), y, v);
+            v = _mm256_fmadd_ps(_mm256_set1_ps(rows[r][2]), z, v);
+            v = _mm256_fmadd_ps(_mm256_set1_ps(rows[r][3]), w, v);
+            _mm256_maskstore_ps(outs[r], mask, v);
+        }
+    }
+}
+
+W_ENGINE_TARGET("avx512f")
+static void TransformStreamAVX512(const Matrix4& a, const Vector4Stream& in, Vector4Stream& out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        const __mmask16 mask = count - i < 16 ? static_cast<__mmask16>((1u << (count - i)) - 1) : static_cast<__mmask16>(0xFFFF);
+        const __m512 x = _mm512_maskz_loadu_ps(mask, in.x + i), y = _mm512_maskz_loadu_ps(mask, in.y + i);
+        const __m512 z = _mm512_maskz_loadu_ps(mask, in.z + i), w = _mm512_maskz_loadu_ps(mask, in.w + i);
+        const float* rows[4] = { &a.m11, &a.m21, &a.m31, &a.m41 };
+        float* outs[4] = { out.x + i, out.y + i, out.z + i, out.w + i };
+        for (int r = 0; r < 4; r++) {
+            __m512 v = _mm512_mul_ps(_mm512_set1_ps(rows[r][0]), x);
+            v = _mm512_fmadd_ps(_mm512_set1_ps(rows[r][1]), y, v);
+            v = _mm512_fmadd_ps(_mm512_set1_ps(rows[r][2]), z, v);
+            v = _mm512_fmadd_ps(_mm512_set1_ps(rows[r][3]), w, v);
+            _mm512_mask_storeu_ps(outs[r], mask, v);
+        }
+    }
+}
+#endif
+
+void Matrix4::TransformStream(const Vector4Stream& in, Vector4Stream& out, size_t count) const {
+    if (count > in.count || count > out.count) {
+        throw std::out_of_range("TransformStream count exceeds the stream size.");
+    }
+
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512: return TransformStreamAVX512(*this, in, out, count);
+        case SIMD::Level::FMA: return TransformStreamFMA(*this, in, out, count);
+        case SIMD::Level::AVX2: return TransformStreamAVX2(*this, in, out, count);
+        case SIMD::Level::SSE2: return TransformStreamSSE2(*this, in, out, count);
+#endif
+        default: return TransformStreamScalar(*this, in, out, 0, count);
+    }
 }
 
 std::optional<Matrix4> Matrix4::Inverse() const {
@@ -133,9 +314,53 @@ std::optional<Matrix4> Matrix4::Inverse() const {
     );
 }
 
+static Matrix4 RigidDegree(const Matrix4& m, long long degree) {
+    const double tx = m.m14, ty = m.m24, tz = m.m34;
+    const double sx = m.m32 - m.m23, sy = m.m13 - m.m31, sz = m.m21 - m.m12;
+    const double cosTheta = 0.5 * (m.m11 + m.m22 + m.m33 - 1.0);
+    const double sinTheta = 0.5 * std::sqrt(sx * sx + sy * sy + sz * sz);
+    const double n = static_cast<double>(degree);
+
+    if (sinTheta < 1e-7 && cosTheta > 0.0) {
+        return Matrix4(
+            1, 0, 0, static_cast<float>(n * tx),
+            0, 1, 0, static_cast<float>(n * ty),
+            0, 0, 1, static_cast<float>(n * tz),
+            0, 0, 0, 1
+        );
+    }
+
+    // Screw decomposition: x -> R(x - c) + c + t_parallel, where c is the point on the rotation axis
+    // closest to the origin and t_parallel is the slide along the axis. Then M^n x = R^n (x - c) + c + n * t_parallel.
+    const double theta = std::atan2(sinTheta, cosTheta);
+    const double multiplier = 1.0 / (2.0 * sinTheta);
+    const double ax = sx * multiplier, ay = sy * multiplier, az = sz * multiplier;
+
+    const double along = ax * tx + ay * ty + az * tz;
+    const double px = tx - along * ax, py = ty - along * ay, pz = tz - along * az;
+
+    // (I - R)^-1 on the plane perpendicular to the axis is 0.5 * (I + cot(theta / 2) * [axis]x).
+    const double cotHalf = 1.0 / std::tan(0.5 * theta);
+    const double cx = 0.5 * (px + cotHalf * (ay * pz - az * py));
+    const double cy = 0.5 * (py + cotHalf * (az * px - ax * pz));
+    const double cz = 0.5 * (pz + cotHalf * (ax * py - ay * px));
+
+    const double angle = std::fmod(n * theta, 6.283185307179586);
+    const double c = std::cos(angle), s = std::sin(angle), k = 1.0 - c;
+    const double r11 = c + ax * ax * k,      r12 = ax * ay * k - az * s, r13 = ax * az * k + ay * s;
+    const double r21 = ay * ax * k + az * s, r22 = c + ay * ay * k,      r23 = ay * az * k - ax * s;
+    const double r31 = az * ax * k - ay * s, r32 = az * ay * k + ax * s, r33 = c + az * az * k;
+
+    return Matrix4(
+        static_cast<float>(r11), static_cast<float>(r12), static_cast<float>(r13), static_cast<float>(cx - (r11 * cx + r12 * cy + r13 * cz) + n * along * ax),
+        static_cast<float>(r21), static_cast<float>(r22), static_cast<float>(r23), static_cast<float>(cy - (r21 * cx + r22 * cy + r23 * cz) + n * along * ay),
+        static_cast<float>(r31), static_cast<float>(r32), static_cast<float>(r33), static_cast<float>(cz - (r31 * cx + r32 * cy + r33 * cz) + n * along * az),
+        0, 0, 0, 1
+    );
+}
+
 Matrix4 Matrix4::Degree(int degree) const {
-    if (degree <= 0) {
-        std::cout << "Degree must be greater than 0." << std::endl;
+    if (degree == 0) {
         return Matrix4();
     }
 
@@ -143,27 +368,51 @@ Matrix4 Matrix4::Degree(int degree) const {
         return *this;
     }
 
-    Matrix4 result = this->MultiplyMatrix(*this);
-    for (int i = 3; i <= degree; i++) {
-        result = this->MultiplyMatrix(result);
+    long long power = degree;
+    Matrix4 base = *this;
+
+    if (power < 0) {
+        const std::optional<Matrix4> inverse = this->Inverse();
+        if (!inverse) {
+            std::cout << "Matrix is singular, negative degree is undefined." << std::endl;
+            return Matrix4();
+        }
+        base = *inverse;
+        power = -power;
+    }
+
+    // The closed form costs about as much as ten products, so small powers stay on the generic path.
+    // Near a half turn the axis cannot be recovered from the skew-symmetric part, those use it too.
+    if (power >= 32 && base.IsRigid() && base.m11 + base.m22 + base.m33 > -0.999f) {
+        return RigidDegree(base, power);
+    }
+
+    Matrix4 result;
+    bool first = true;
+    while (power > 0) {
+        if (power & 1) {
+            result = first ? base : result.MultiplyMatrix(base);
+            first = false;
+        }
+        power >>= 1;
+        if (power > 0) base = base.MultiplyMatrix(base);
     }
     return result;
 }
 
-Matrix4 Matrix4::Add(const Matrix4& m) const {
-    return Matrix4(
-        m11 + m.m11, m12 + m.m12, m13 + m.m13, m14 + m.m14,
-        m21 + m.m21, m22 + m.m22, m23 + m.m23, m24 + m.m24,
-        m31 + m.m31, m32 + m.m32, m33 + m.m33, m34 + m.m34,
-        m41 + m.m41, m42 + m.m42, m43 + m.m43, m44 + m.m44
-    );
-}
+bool Matrix4::IsRigid(float epsilon) const {
+    if (std::fabs(m41) > epsilon || std::fabs(m42) > epsilon || std::fabs(m43) > epsilon || std::fabs(m44 - 1.0f) > epsilon) {
+        return false;
+    }
 
-Matrix4 Matrix4::Subtract(const Matrix4& m) const {
-    return Matrix4(
-        m11 - m.m11, m12 - m.m12, m13 - m.m13, m14 - m.m14,
-        m21 - m.m21, m22 - m.m22, m23 - m.m23, m24 - m.m24,
-        m31 - m.m31, m32 - m.m32, m33 - m.m33, m34 - m.m34,
-        m41 - m.m41, m42 - m.m42, m43 - m.m43, m44 - m.m44
-    );
-}
\ No newline at end of file
+    const float columns[3][3] = { { m11, m21, m31 }, { m12, m22, m32 }, { m13, m23, m33 } };
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            const float dot = columns[i][0] * columns[j][0] + columns[i][1] * columns[j][1] + columns[i][2] * columns[j][2];
+            if (std::fabs(dot - (i == j ? 1.0f : 0.0f)) > epsilon) return false;
+        }
+    }
+
+    const float determinant = m11 * (m22 * m33 - m23 * m32) - m12 * (m21 * m33 - m23 * m31) + m13 * (m21 * m32 - m22 * m31);
+    return determinant > 0.0f;
+}
@@ -0,0 +1,279 @@
+#include "../include/mesh.h"
+#include "../include/matrix4.h"
+#include "../include/framearena.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+static constexpr uint32_t noTriangle = 0xFFFFFFFFu;
+
+Mesh::Mesh(const Vector4* vertices, size_t vertexCount, const uint32_t* indices, size_t triangleCount):
+    vertices(vertices, vertices + vertexCount), indices(indices, indices + 3 * triangleCount) {
+    if (triangleCount >= noTriangle) {
+        throw std::out_of_range("Mesh supports less than 2^32 - 1 triangles.");
+    }
+    for (uint32_t index : this->indices) {
+        if (index >= vertexCount) throw std::out_of_range("Mesh triangle index is out of the vertex range.");
+    }
+}
+
+const std::vector<Vector4>& Mesh::Vertices() const {
+    return vertices;
+}
+
+const std::vector<uint32_t>& Mesh::Indices() const {
+    return indices;
+}
+
+size_t Mesh::TriangleCount() const {
+    return indices.size() / 3;
+}
+
+static constexpr uint32_t noVertex = 0xFFFFFFFFu;
+
+// Both caches find a vertex through entryOf: the vertex is cached when its entry still holds it. Loading takes the
+// entry after the previous one, so the oldest loaded vertex is replaced and hits do not refresh a vertex.
+class FifoCache {
+public:
+    FifoCache(FrameArena& arena, size_t vertexCount, size_t size):
+        vertices(arena.Allocate<uint32_t>(size)), entryOf(arena.Allocate<uint32_t>(vertexCount)), size(size) {
+        std::fill(vertices, vertices + size, noVertex);
+        std::fill(entryOf, entryOf + vertexCount, 0u);
+    }
+
+    bool Lookup(uint32_t vertex, size_t& entry) {
+        entry = entryOf[vertex];
+        if (vertices[entry] == vertex) return true;
+        entry = next;
+        next = next + 1 < size ? next + 1 : 0;
+        vertices[entry] = vertex;
+        entryOf[vertex] = static_cast<uint32_t>(entry);
+        return false;
+    }
+
+private:
+    uint32_t* vertices;
+    uint32_t* entryOf;
+    size_t size;
+    size_t next = 0;
+};
+
+// Entries form a list from the most to the least recently used one. Hits move their entry to the front, loading
+// replaces the vertex of the last entry.
+class LruCache {
+public:
+    LruCache(FrameArena& arena, size_t vertexCount, size_t size):
+        vertices(arena.Allocate<uint32_t>(size)), entryOf(arena.Allocate<uint32_t>(vertexCount)),
+        previous(arena.Allocate<uint32_t>(size)), next(arena.Allocate<uint32_t>(size)) {
+        std::fill(vertices, vertices + size, noVertex);
+        std::fill(entryOf, entryOf + vertexCount, 0u);
+        for (size_t e = 0; e < size; e++) {
+            previous[e] = static_cast<uint32_t>(e == 0 ? size - 1 : e - 1);
+            next[e] = static_cast<uint32_t>(e + 1 == size ? 0 : e + 1);
+        }
+    }
+
+    bool Lookup(uint32_t vertex, size_t& entry) {
+        entry = entryOf[vertex];
+        const bool hit = vertices[entry] == vertex;
+        if (!hit) {
+            // The list is circular, the entry before the front is the least recently used one.
+            entry = previous[front];
+            vertices[entry] = vertex;
+            entryOf[vertex] = static_cast<uint32_t>(entry);
+        }
+        if (entry != front) {
+            const uint32_t e = static_cast<uint32_t>(entry);
+            next[previous[e]] = next[e];
+            previous[next[e]] = previous[e];
+            next[e] = front;
+            previous[e] = previous[front];
+            next[previous[front]] = e;
+            previous[front] = e;
+            front = e;
+        }
+        return hit;
+    }
+
+private:
+    uint32_t* vertices;
+    uint32_t* entryOf;
+    uint32_t* previous;
+    uint32_t* next;
+    uint32_t front = 0;
+};
+
+// Walks the indices through the cache, transforming misses into out when transform is set. The cache state lives
+// in the arena only for the duration of the call.
+template <typename Cache, bool transform>
+static Mesh::CacheStats RunCache(const std::vector<Vector4>& vertices, const std::vector<uint32_t>& indices, size_t cacheSize,
+                                 const Matrix4* m, Vector4* out, FrameArena& arena) {
+    const FrameArena::Scope scope(arena);
+    Cache cache(arena, vertices.size(), cacheSize);
+    Vector4* cached = transform ? arena.Allocate<Vector4>(cacheSize) : nullptr;
+    uint8_t* referenced = arena.Allocate<uint8_t>(vertices.size());
+    std::fill(referenced, referenced + vertices.size(), uint8_t(0));
+    Mesh::CacheStats stats;
+    stats.triangles = indices.size() / 3;
+    for (size_t i = 0; i < indices.size(); i++) {
+        const uint32_t v = indices[i];
+        size_t entry;
+        if (cache.Lookup(v, entry)) {
+            if (transform) out[i] = cached[entry];
+        } else {
+            stats.transforms++;
+            if (transform) out[i] = cached[entry] = m->MultiplyVector(vertices[v]);
+        }
+        stats.vertices += referenced[v] == 0;
+        referenced[v] = 1;
+    }
+    return stats;
+}
+
+static Mesh::CacheStats Dispatch(const std::vector<Vector4>& vertices, const std::vector<uint32_t>& indices, size_t cacheSize,
+                                 Mesh::CachePolicy policy, const Matrix4* m, Vector4* out, FrameArena* arena) {
+    if (cacheSize == 0) {
+        throw std::invalid_argument("Mesh cache must hold at least one vertex.");
+    }
+    if (arena == nullptr) {
+        // Without a caller arena the scratch memory of RunCache is one exactly sized block.
+        FrameArena local(vertices.size() * (sizeof(uint32_t) + 1) + cacheSize * (3 * sizeof(uint32_t) + sizeof(Vector4)) + 64);
+        return Dispatch(vertices, indices, cacheSize, policy, m, out, &local);
+    }
+    if (m == nullptr) {
+        return policy == Mesh::CachePolicy::FIFO
+            ? RunCache<FifoCache, false>(vertices, indices, cacheSize, m, out, *arena)
+            : RunCache<LruCache, false>(vertices, indices, cacheSize, m, out, *arena);
+    }
+    return policy == Mesh::CachePolicy::FIFO
+        ? RunCache<FifoCache, true>(vertices, indices, cacheSize, m, out, *arena)
+        : RunCache<LruCache, true>(vertices, indices, cacheSize, m, out, *arena);
+}
+
+Mesh::CacheStats Mesh::SimulateCache(size_t cacheSize, CachePolicy policy) const {
+    return Dispatch(vertices, indices, cacheSize, policy, nullptr, nullptr, nullptr);
+}
+
+Mesh::CacheStats Mesh::Transform(const Matrix4& m, Vector4* out, size_t cacheSize, CachePolicy policy) const {
+    return Dispatch(vertices, indices, cacheSize, policy, &m, out, nullptr);
+}
+
+Mesh::CacheStats Mesh::Transform(const Matrix4& m, Vector4* out, size_t cacheSize, CachePolicy policy, FrameArena& arena) const {
+    return Dispatch(vertices, indices, cacheSize, policy, &m, out, &arena);
+}
+
+// Vertex scores of Forsyth's "Linear-Speed Vertex Cache Optimisation" with the constants of the article: the three
+// vertices of the last triangle get a fixed score, older cache positions decay with power 1.5, and vertices with few
+// remaining triangles are boosted so that they are finished instead of left behind.
+class ForsythScore {
+public:
+    static constexpr size_t valenceTableSize = 32;
+
+    explicit ForsythScore(size_t cacheSize) {
+        for (size_t p = 0; p < cacheSize; p++) {
+            position[p] = p < 3 ? 0.75f : std::pow(1.0f - float(p - 3) / float(cacheSize - 3), 1.5f);
+        }
+        for (size_t r = 1; r < valenceTableSize; r++) valence[r] = 2.0f / std::sqrt(float(r));
+    }
+
+    float operator()(int cachePosition, uint32_t remaining) const {
+        if (remaining == 0) return -1.0f;
+        const float boost = remaining < valenceTableSize ? valence[remaining] : 2.0f / std::sqrt(float(remaining));
+        return (cachePosition >= 0 ? position[cachePosition] : 0.0f) + boost;
+    }
+
+private:
+    float position[64] = {};
+    float valence[valenceTableSize] = {};
+};
+
+void Mesh::OptimizeVertexCache(size_t cacheSize) {
+    if (cacheSize < 4 || cacheSize > 64) {
+        throw std::invalid_argument("Mesh vertex cache optimization supports cache sizes between 4 and 64.");
+    }
+    const size_t triangleCount = TriangleCount(), vertexCount = vertices.size();
+    if (triangleCount == 0) return;
+    const ForsythScore score(cacheSize);
+
+    // Triangles of every vertex, the first remaining[v] entries of its range are the ones not emitted yet.
+    std::vector<uint32_t> remaining(vertexCount, 0), offsets(vertexCount + 1, 0), adjacency(indices.size());
+    for (uint32_t v : indices) remaining[v]++;
+    for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount), triangleScore(triangleCount);
+    for (size_t v = 0; v < vertexCount; v++) vertexScore[v] = score(-1, remaining[v]);
+    uint32_t best = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScore[t] = vertexScore[indices[3 * t]] + vertexScore[indices[3 * t + 1]] + vertexScore[indices[3 * t + 2]];
+        if (triangleScore[t] > triangleScore[best]) best = static_cast<uint32_t>(t);
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indices.size());
+    // The vertices of the new triangle are pushed in front of the cache, entries past cacheSize fall out.
+    std::vector<uint32_t> cache, next;
+    cache.reserve(cacheSize + 3);
+    next.reserve(cacheSize + 3);
+    size_t cursor = 0;
+
+    for (size_t n = 0; n < triangleCount; n++) {
+        if (best == noTriangle) {
+            // Dead end: no cached vertex has triangles left, continue with the next triangle in input order.
+            while (emitted[cursor]) cursor++;
+            best = static_cast<uint32_t>(cursor);
+        }
+        emitted[best] = 1;
+        const uint32_t* triangle = &indices[3 * best];
+        reordered.insert(reordered.end(), triangle, triangle + 3);
+
+        next.clear();
+        for (int k = 0; k < 3; k++) {
+            const uint32_t v = triangle[k];
+            uint32_t* active = &adjacency[offsets[v]];
+            for (uint32_t i = 0; i < remaining[v]; i++) {
+                if (active[i] == best) {
+                    active[i] = active[--remaining[v]];
+                    break;
+                }
+            }
+            if (cachePosition[v] != -2) next.push_back(v);
+            // Marks the vertex as queued, degenerate triangles repeat vertices.
+            cachePosition[v] = -2;
+        }
+        for (uint32_t v : cache) {
+            if (cachePosition[v] != -2) next.push_back(v);
+        }
+
+        for (size_t i = 0; i < next.size(); i++) {
+            const uint32_t v = next[i];
+            cachePosition[v] = i < cacheSize ? static_cast<int>(i) : -1;
+            vertexScore[v] = score(cachePosition[v], remaining[v]);
+        }
+
+        best = noTriangle;
+        float bestScore = -std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < next.size(); i++) {
+            const uint32_t v = next[i];
+            const uint32_t* active = &adjacency[offsets[v]];
+            for (uint32_t j = 0; j < remaining[v]; j++) {
+                const uint32_t t = active[j];
+                const uint32_t* corners = &indices[3 * t];
+                triangleScore[t] = vertexScore[corners[0]] + vertexScore[corners[1]] + vertexScore[corners[2]];
+                if (i < cacheSize && triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+
+        if (next.size() > cacheSize) next.resize(cacheSize);
+        std::swap(cache, next);
+    }
+
+    indices.swap(reordered);
+}
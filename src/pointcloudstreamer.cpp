@@ -0,0 +1,162 @@
+#include "../include/pointcloudstreamer.h"
+#include "../include/quaternion.h"
+#include "../include/vector4.h"
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <future>
+#include <stdexcept>
+#include <filesystem>
+
+using Clock = std::chrono::steady_clock;
+
+static double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+using File = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+static File OpenFile(const std::string& path, const char* mode) {
+    File file(std::fopen(path.c_str(), mode), &std::fclose);
+    if (!file) throw std::runtime_error("Cannot open " + path + ".");
+    return file;
+}
+
+// Reads up to count points, fewer only at the end of the file.
+static size_t ReadPoints(std::FILE* file, float* points, size_t count, const std::string& path) {
+    const size_t bytes = std::fread(points, 1, 3 * sizeof(float) * count, file);
+    if (bytes < 3 * sizeof(float) * count && std::ferror(file)) throw std::runtime_error("Cannot read " + path + ".");
+    if (bytes % (3 * sizeof(float)) != 0) {
+        throw std::invalid_argument(path + " does not contain whole x, y, z triples.");
+    }
+    return bytes / (3 * sizeof(float));
+}
+
+static void WritePoints(std::FILE* file, const float* points, size_t count, const std::string& path) {
+    if (std::fwrite(points, 3 * sizeof(float), count, file) != count) throw std::runtime_error("Cannot write " + path + ".");
+}
+
+// Checked before the buffers are allocated. Visible indices of a chunk are 32-bit.
+static size_t CheckedChunkSize(size_t chunkSize) {
+    if (chunkSize == 0 || chunkSize > 0xFFFFFFFFu) {
+        throw std::invalid_argument("PointCloudStreamer chunk size must be between 1 and 2^32 - 1.");
+    }
+    return chunkSize;
+}
+
+PointCloudStreamer::PointCloudStreamer(size_t chunkSize):
+    chunkSize(CheckedChunkSize(chunkSize)), work(chunkSize), radii(chunkSize, 0.0f), visible(chunkSize) {
+    std::fill(work.w, work.w + chunkSize, 1.0f);
+    for (int b = 0; b < 2; b++) {
+        inBuffers[b].resize(3 * chunkSize);
+        outBuffers[b].resize(3 * chunkSize);
+    }
+}
+
+void PointCloudStreamer::SetTransform(const Matrix4& m) {
+    transform = m;
+}
+
+void PointCloudStreamer::SetTransform(const Quaternion& rotation, const Vector4& translation) {
+    // ToRotationMatrix is laid out for row-vectors, the stream transform multiplies column-vectors.
+    transform = rotation.ToRotationMatrix().Transpose();
+    transform.m14 = translation.x;
+    transform.m24 = translation.y;
+    transform.m34 = translation.z;
+}
+
+void PointCloudStreamer::SetCulling(const Frustum& frustum) {
+    this->frustum = frustum;
+}
+
+void PointCloudStreamer::ClearCulling() {
+    frustum.reset();
+}
+
+void PointCloudStreamer::ProcessChunk(const float* in, size_t count, float* out, size_t& written) {
+    for (size_t i = 0; i < count; i++) {
+        work.x[i] = in[3 * i];
+        work.y[i] = in[3 * i + 1];
+        work.z[i] = in[3 * i + 2];
+    }
+    // TransformStream overwrites w in place, it is set back to 1 for the next chunk.
+    Vector4Stream points = Vector4Stream::View(work.x, work.y, work.z, work.w, count);
+    transform.TransformStream(points, points, count);
+    std::fill(work.w, work.w + count, 1.0f);
+
+    if (!frustum) {
+        for (size_t i = 0; i < count; i++) {
+            out[3 * i] = work.x[i];
+            out[3 * i + 1] = work.y[i];
+            out[3 * i + 2] = work.z[i];
+        }
+        written = count;
+        return;
+    }
+    // Points are spheres of radius zero.
+    const Vector4Stream spheres = Vector4Stream::View(work.x, work.y, work.z, radii.data(), count);
+    written = frustum->CullSpheres(spheres, visible.data());
+    for (size_t k = 0; k < written; k++) {
+        const uint32_t i = visible[k];
+        out[3 * k] = work.x[i];
+        out[3 * k + 1] = work.y[i];
+        out[3 * k + 2] = work.z[i];
+    }
+}
+
+PointCloudStreamer::Stats PointCloudStreamer::Process(const std::string& input, const std::string& output) {
+    const Clock::time_point start = Clock::now();
+    Stats stats;
+    // Opening the output truncates it, which would destroy the input before the first read. A missing file is
+    // not equivalent to anything, OpenFile reports it.
+    std::error_code error;
+    if (std::filesystem::equivalent(input, output, error)) {
+        throw std::invalid_argument("PointCloudStreamer output " + output + " is the input file.");
+    }
+    File in = OpenFile(input, "rb");
+    File out = OpenFile(output, "wb");
+
+    // Every task adds its own time, the futures order the updates with the reads of the stats.
+    auto read = [&](size_t buffer) {
+        const Clock::time_point begin = Clock::now();
+        const size_t count = ReadPoints(in.get(), inBuffers[buffer].data(), chunkSize, input);
+        stats.readSeconds += SecondsSince(begin);
+        return count;
+    };
+    auto write = [&](size_t buffer, size_t count) {
+        const Clock::time_point begin = Clock::now();
+        WritePoints(out.get(), outBuffers[buffer].data(), count, output);
+        stats.writeSeconds += SecondsSince(begin);
+    };
+
+    std::future<size_t> reading = std::async(std::launch::async, read, 0);
+    std::future<void> writing;
+    for (size_t buffer = 0;; buffer ^= 1) {
+        Clock::time_point waitStart = Clock::now();
+        const size_t count = reading.get();
+        stats.waitSeconds += SecondsSince(waitStart);
+        if (count == 0) break;
+        // A short chunk is the last one, no need to ask the file again.
+        if (count == chunkSize) reading = std::async(std::launch::async, read, buffer ^ 1);
+
+        const Clock::time_point processStart = Clock::now();
+        size_t written = 0;
+        ProcessChunk(inBuffers[buffer].data(), count, outBuffers[buffer].data(), written);
+        stats.processSeconds += SecondsSince(processStart);
+        stats.chunks++;
+        stats.pointsRead += count;
+        stats.pointsWritten += written;
+
+        // Writes stay in order, and waiting for the previous one frees its buffer for the next chunk.
+        waitStart = Clock::now();
+        if (writing.valid()) writing.get();
+        stats.waitSeconds += SecondsSince(waitStart);
+        writing = std::async(std::launch::async, write, buffer, written);
+        if (count < chunkSize) break;
+    }
+    if (writing.valid()) writing.get();
+    if (std::fflush(out.get()) != 0) throw std::runtime_error("Cannot write " + output + ".");
+    stats.seconds = SecondsSince(start);
+    return stats;
+}
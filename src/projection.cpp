@@ -0,0 +1,40 @@
+#include "../include/projection.h"
+#include <cmath>
+#include <stdexcept>
+
+Matrix4 Projection::Perspective(float fovY, float aspect, float near, float far, Frustum::Depth depth) {
+    if (!(fovY > 0 && fovY < 3.14159265f) || !(aspect > 0)) {
+        throw std::invalid_argument("Perspective field of view must lie in (0, pi) and aspect must be positive.");
+    }
+    if (!(near > 0 && far > near)) {
+        throw std::invalid_argument("Perspective planes must satisfy 0 < near < far.");
+    }
+
+    const float f = 1.0f / std::tan(0.5f * fovY);
+    const float range = 1.0f / (far - near);
+    // z = -near maps to -1 or 0, z = -far maps to 1.
+    const float m33 = depth == Frustum::Depth::NegativeOneToOne ? -(far + near) * range : -far * range;
+    const float m34 = depth == Frustum::Depth::NegativeOneToOne ? -2 * far * near * range : -far * near * range;
+    return Matrix4(
+        f / aspect, 0, 0,   0,
+        0,          f, 0,   0,
+        0,          0, m33, m34,
+        0,          0, -1,  0
+    );
+}
+
+Matrix4 Projection::Orthographic(float left, float right, float bottom, float top, float near, float far, Frustum::Depth depth) {
+    if (right == left || top == bottom || far == near) {
+        throw std::invalid_argument("Orthographic box must have non-zero size.");
+    }
+
+    const float width = 1.0f / (right - left), height = 1.0f / (top - bottom), range = 1.0f / (far - near);
+    const float m33 = depth == Frustum::Depth::NegativeOneToOne ? -2 * range : -range;
+    const float m34 = depth == Frustum::Depth::NegativeOneToOne ? -(far + near) * range : -near * range;
+    return Matrix4(
+        2 * width, 0,          0,   -(right + left) * width,
+        0,         2 * height, 0,   -(top + bottom) * height,
+        0,         0,          m33, m34,
+        0,         0,          0,   1
+    );
+}
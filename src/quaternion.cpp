@@ -1,15 +1,16 @@
 #include "../include/quaternion.h"
+#include "../include/vector3.h"
 #include "../include/vector4.h"
+#include "../include/vector4stream.h"
 #include "../include/matrix4.h"
+#include "../include/quaternionstream.h"
+#include "../include/simd.h"
+#include <stdexcept>
 
 void Quaternion::Print(const int& precision = 6) const {
     std::cout << std::fixed << std::setprecision(precision) << "Quaternion( w: " << w << " x: " << x << " y: " << y << " z: " << z << " )\n" << std::endl;
 }
 
-Quaternion Quaternion::Clone() const {
-    return Quaternion(w, x, y, z);
-}
-
 bool Quaternion::Equals(const Quaternion& q, const float& precision) const {
     return fabs(w - q.w) < precision && 
            fabs(x - q.x) < precision &&
@@ -29,41 +30,11 @@ Quaternion Quaternion::Normalize() const {
     return Quaternion(w / length, x / length, y / length, z / length);
 }
 
-Quaternion& Quaternion::Conjugate(){
-    x = -x, y = -y, z = -z;
-    return *this;
-}
-
 Quaternion Quaternion::Inverse() const {
     const float lengthSquared = this->Length() * this->Length();
     return Quaternion(w / lengthSquared, -x / lengthSquared, -y / lengthSquared, -z / lengthSquared);
 }
 
-Quaternion Quaternion::Add(const Quaternion& q) const {
-    return Quaternion(w + q.w, x + q.x, y + q.y, z + q.z);
-}
-
-Quaternion Quaternion::Subtract(const Quaternion q) const {
-    return Quaternion(w - q.w, x - q.x, y - q.y, z - q.z);
-}
-
-Quaternion Quaternion::Scale(const float& scale) const {
-    return Quaternion(w * scale, x * scale, y * scale, z * scale);
-}
-
-Quaternion Quaternion::Multiply(const Quaternion& q) const {
-    return Quaternion(
-        w * q.w - x * q.x - y * q.y - z * q.z,
-        w * q.x + x * q.w + y * q.z - z * q.y,
-        w * q.y - x * q.z + y * q.w + z * q.x,
-        w * q.z + x * q.y - y * q.x + z * q.w
-    );
-}
-
-float Quaternion::Dot(const Quaternion& q) const {
-    return w * q.w + x * q.x + y * q.y + z * q.z;
-}
-
 float Quaternion::Angle(const Quaternion& q, const bool& degrees) const {
     const float lengths = this->Length() * q.Length();
 
@@ -111,34 +82,178 @@ Matrix4 Quaternion::ToRotationMatrix() const {
 }
 
 Vector4 Quaternion::ApplyToVector(const Vector4& v) const {
-    const Quaternion qVector = Quaternion(0, v.x, v.y, v.z);
-    const Quaternion qInverse = this->Clone().Inverse();
-    const Quaternion qResult = this->Multiply(qVector).Multiply(qInverse);
-    return Vector4(qResult.x, qResult.y, qResult.z, 0.0f);
+    // q * v * conjugate(q) expanded for a pure quaternion v, divided by |q|^2 instead of computing the inverse.
+    const float lengthSquared = w * w + x * x + y * y + z * z;
+    const float scalar = w * w - x * x - y * y - z * z;
+    const float dot = 2 * (x * v.x + y * v.y + z * v.z);
+    const float cx = 2 * w * (y * v.z - z * v.y);
+    const float cy = 2 * w * (z * v.x - x * v.z);
+    const float cz = 2 * w * (x * v.y - y * v.x);
+    return Vector4(
+        (scalar * v.x + dot * x + cx) / lengthSquared,
+        (scalar * v.y + dot * y + cy) / lengthSquared,
+        (scalar * v.z + dot * z + cz) / lengthSquared,
+        0.0f
+    );
+}
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 arrays must be tightly packed.");
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 arrays must be tightly packed.");
+
+static void RotateStreamScalar(const Quaternion& q, const Vector4Stream& in, Vector4Stream& out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const float vx = in.x[i], vy = in.y[i], vz = in.z[i];
+        const float tx = 2 * (q.y * vz - q.z * vy);
+        const float ty = 2 * (q.z * vx - q.x * vz);
+        const float tz = 2 * (q.x * vy - q.y * vx);
+        out.x[i] = vx + q.w * tx + (q.y * tz - q.z * ty);
+        out.y[i] = vy + q.w * ty + (q.z * tx - q.x * tz);
+        out.z[i] = vz + q.w * tz + (q.x * ty - q.y * tx);
+        out.w[i] = in.w[i];
+    }
+}
+
+#if W_ENGINE_X86
+W_ENGINE_TARGET("sse2")
+static inline void RotateSSE2(const Quaternion& q, __m128& x, __m128& y, __m128& z) {
+    const __m128 qx = _mm_set1_ps(q.x), qy = _mm_set1_ps(q.y), qz = _mm_set1_ps(q.z), qw = _mm_set1_ps(q.w);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)));
+    const __m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)));
+    const __m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)));
+    x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+    y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+    z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+}
+
+static const int rotateTailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+W_ENGINE_TARGET("avx2,fma")
+static void RotateStreamFMA(const Quaternion& q, const Vector4Stream& in, Vector4Stream& out, size_t count) {
+    const __m256 qx = _mm256_set1_ps(q.x), qy = _mm256_set1_ps(q.y), qz = _mm256_set1_ps(q.z), qw = _mm256_set1_ps(q.w);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rotateTailMask + 8 - (count - i < 8 ? count - i : 8)));
+        const __m256 x = _mm256_maskload_ps(in.x + i, mask), y = _mm256_maskload_ps(in.y + i, mask);
+        const __m256 z = _mm256_maskload_ps(in.z + i, mask), w = _mm256_maskload_ps(in.w + i, mask);
+        const __m256 tx = _mm256_mul_ps(two, _mm256_fmsub_ps(qy, z, _mm256_mul_ps(qz, y)));
+        const __m256 ty = _mm256_mul_ps(two, _mm256_fmsub_ps(qz, x, _mm256_mul_ps(qx, z)));
+        const __m256 tz = _mm256_mul_ps(two, _mm256_fmsub_ps(qx, y, _mm256_mul_ps(qy, x)));
+        _mm256_maskstore_ps(out.x + i, mask, _mm256_add_ps(_mm256_fmadd_ps(qw, tx, x), _mm256_fmsub_ps(qy, tz, _mm256_mul_ps(qz, ty))));
+        _mm256_maskstore_ps(out.y + i, mask, _mm256_add_ps(_mm256_fmadd_ps(qw, ty, y), _mm256_fmsub_ps(qz, tx, _mm256_mul_ps(qx, tz))));
+        _mm256_maskstore_ps(out.z + i, mask, _mm256_add_ps(_mm256_fmadd_ps(qw, tz, z), _mm256_fmsub_ps(qx, ty, _mm256_mul_ps(qy, tx))));
+        _mm256_maskstore_ps(out.w + i, mask, w);
+    }
+}
+
+W_ENGINE_TARGET("sse2")
+static size_t RotateVectorsSSE2(const Quaternion& q, const Vector4* in, Vector4* out, size_t count) {
+    const float* source = &in->x;
+    float* target = &out->x;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(source + 4 * i), y = _mm_loadu_ps(source + 4 * i + 4);
+        __m128 z = _mm_loadu_ps(source + 4 * i + 8), w = _mm_loadu_ps(source + 4 * i + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        RotateSSE2(q, x, y, z);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        _mm_storeu_ps(target + 4 * i, x);
+        _mm_storeu_ps(target + 4 * i + 4, y);
+        _mm_storeu_ps(target + 4 * i + 8, z);
+        _mm_storeu_ps(target + 4 * i + 12, w);
+    }
+    return i;
 }
 
-Quaternion Quaternion::Slerp(Quaternion& q, const float& t) const {
+W_ENGINE_TARGET("sse2")
+static size_t RotateVectorsSSE2(const Quaternion& q, const Vector3* in, Vector3* out, size_t count) {
+    const float* source = &in->x;
+    float* target = &out->x;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3.
+        const __m128 a = _mm_loadu_ps(source + 3 * i), b = _mm_loadu_ps(source + 3 * i + 4), c = _mm_loadu_ps(source + 3 * i + 8);
+        const __m128 b2c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+        const __m128 a1b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+        const __m128 b3c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+        const __m128 a2b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+        __m128 x = _mm_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0));
+        __m128 y = _mm_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 z = _mm_shuffle_ps(a2b1, c, _MM_SHUFFLE(3, 0, 2, 0));
+
+        RotateSSE2(q, x, y, z);
+
+        const __m128 x0y0 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 z0x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+        const __m128 y1z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 x2y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 z2x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+        const __m128 y3z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+        _mm_storeu_ps(target + 3 * i, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(target + 3 * i + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(target + 3 * i + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+    return i;
+}
+#endif
+
+void Quaternion::RotateStream(const Vector4Stream& in, Vector4Stream& out, size_t count) const {
+    if (count > in.count || count > out.count) {
+        throw std::out_of_range("RotateStream count exceeds the stream size.");
+    }
+
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return RotateStreamFMA(*this, in, out, count);
+#endif
+        default: return RotateStreamScalar(*this, in, out, 0, count);
+    }
+}
+
+void Quaternion::RotateVectors(const Vector4* in, Vector4* out, size_t count) const {
+    size_t i = 0;
+#if W_ENGINE_X86
+    if (SIMD::Current() >= SIMD::Level::SSE2) i = RotateVectorsSSE2(*this, in, out, count);
+#endif
+    for (; i < count; i++) out[i] = RotateVector(in[i]);
+}
+
+void Quaternion::RotateVectors(const Vector3* in, Vector3* out, size_t count) const {
+    size_t i = 0;
+#if W_ENGINE_X86
+    if (SIMD::Current() >= SIMD::Level::SSE2) i = RotateVectorsSSE2(*this, in, out, count);
+#endif
+    for (; i < count; i++) {
+        const Vector4 v = RotateVector(Vector4(in[i].x, in[i].y, in[i].z, 0.0f));
+        out[i] = Vector3(v.x, v.y, v.z);
+    }
+}
+
+Quaternion Quaternion::Slerp(const Quaternion& q, const float& t) const {
     if (t <= 0) { return *this; }
     if (t >= 1) { return q; }
 
+    Quaternion target = q;
     float cosTheta = this->Dot(q);
 
+    // q and -q are the same rotation, negating takes the shorter arc.
     if (cosTheta < 0) {
-        q = q.Inverse();
+        target = q.Scale(-1.0f);
         cosTheta = -cosTheta;
     }
 
-    if (abs(cosTheta) >= 1) { return q; }
+    if (abs(cosTheta) >= 1) { return target; }
 
     const float theta = acos(cosTheta);
     const float sinTheta = sqrt(1 - cosTheta * cosTheta);
 
     if (abs(sinTheta) < 1e-3) {
         return Quaternion(
-            0.5 * w + 0.5 * q.w,
-            0.5 * x + 0.5 * q.x,
-            0.5 * y + 0.5 * q.y,
-            0.5 * z + 0.5 * q.z
+            (1 - t) * w + t * target.w,
+            (1 - t) * x + t * target.x,
+            (1 - t) * y + t * target.y,
+            (1 - t) * z + t * target.z
         );
     }
 
@@ -146,13 +261,176 @@ Quaternion Quaternion::Slerp(Quaternion& q, const float& t) const {
     const float ratioB = sin(t * theta) / sinTheta;
 
     return Quaternion(
-        ratioA * w + ratioB * q.w,
-        ratioA * x + ratioB * q.x,
-        ratioA * y + ratioB * q.y,
-        ratioA * z + ratioB * q.z
+        ratioA * w + ratioB * target.w,
+        ratioA * x + ratioB * target.x,
+        ratioA * y + ratioB * target.y,
+        ratioA * z + ratioB * target.z
     );
 }
 
+// D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP": sin(t * theta) / sin(theta) expanded as a
+// polynomial in cos(theta) - 1 with 8 terms, the last one adjusted by 1 + mu to minimize the maximum error.
+static const float slerpOnePlusMu = 1.90110745351730037f;
+static const float slerpU[8] = {
+    1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9),
+    1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), slerpOnePlusMu / (8 * 17)
+};
+static const float slerpV[8] = {
+    1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+    5.0f / 11, 6.0f / 13, 7.0f / 15, slerpOnePlusMu * 8 / 17
+};
+
+static inline float SlerpCoefficient(float t, float xm1) {
+    const float sqr = t * t;
+    float c = 1.0f;
+    for (int i = 7; i >= 0; i--) {
+        c = 1.0f + (slerpU[i] * sqr - slerpV[i]) * xm1 * c;
+    }
+    return t * c;
+}
+
+static void SlerpStreamScalar(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        float dot = a.w[i] * b.w[i] + a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+        const float sign = dot < 0 ? -1.0f : 1.0f;
+        dot *= sign;
+        const float cA = SlerpCoefficient(1.0f - t[i], dot - 1.0f);
+        const float cB = SlerpCoefficient(t[i], dot - 1.0f) * sign;
+        out.w[i] = cA * a.w[i] + cB * b.w[i];
+        out.x[i] = cA * a.x[i] + cB * b.x[i];
+        out.y[i] = cA * a.y[i] + cB * b.y[i];
+        out.z[i] = cA * a.z[i] + cB * b.z[i];
+    }
+}
+
+static void NlerpStreamScalar(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const float dot = a.w[i] * b.w[i] + a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+        const float cA = 1.0f - t[i];
+        const float cB = dot < 0 ? -t[i] : t[i];
+        const float w = cA * a.w[i] + cB * b.w[i], x = cA * a.x[i] + cB * b.x[i];
+        const float y = cA * a.y[i] + cB * b.y[i], z = cA * a.z[i] + cB * b.z[i];
+        const float inverseLength = 1.0f / std::sqrt(w * w + x * x + y * y + z * z);
+        out.w[i] = w * inverseLength, out.x[i] = x * inverseLength;
+        out.y[i] = y * inverseLength, out.z[i] = z * inverseLength;
+    }
+}
+
+#if W_ENGINE_X86
+static const int slerpTailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+W_ENGINE_TARGET("avx2,fma")
+static inline __m256 SlerpCoefficientFMA(__m256 t, __m256 xm1) {
+    const __m256 sqr = _mm256_mul_ps(t, t);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 c = one;
+    for (int i = 7; i >= 0; i--) {
+        const __m256 term = _mm256_mul_ps(_mm256_fmsub_ps(_mm256_set1_ps(slerpU[i]), sqr, _mm256_set1_ps(slerpV[i])), xm1);
+        c = _mm256_fmadd_ps(term, c, one);
+    }
+    return _mm256_mul_ps(t, c);
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static void SlerpStreamFMA(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(slerpTailMask + 8 - (count - i < 8 ? count - i : 8)));
+        const __m256 aw = _mm256_maskload_ps(a.w + i, mask), ax = _mm256_maskload_ps(a.x + i, mask);
+        const __m256 ay = _mm256_maskload_ps(a.y + i, mask), az = _mm256_maskload_ps(a.z + i, mask);
+        const __m256 bw = _mm256_maskload_ps(b.w + i, mask), bx = _mm256_maskload_ps(b.x + i, mask);
+        const __m256 by = _mm256_maskload_ps(b.y + i, mask), bz = _mm256_maskload_ps(b.z + i, mask);
+        const __m256 ti = _mm256_maskload_ps(t + i, mask);
+
+        __m256 dot = _mm256_mul_ps(aw, bw);
+        dot = _mm256_fmadd_ps(ax, bx, dot);
+        dot = _mm256_fmadd_ps(ay, by, dot);
+        dot = _mm256_fmadd_ps(az, bz, dot);
+        const __m256 sign = _mm256_and_ps(dot, signBit);
+        const __m256 xm1 = _mm256_sub_ps(_mm256_xor_ps(dot, sign), one);
+
+        const __m256 cA = SlerpCoefficientFMA(_mm256_sub_ps(one, ti), xm1);
+        const __m256 cB = _mm256_xor_ps(SlerpCoefficientFMA(ti, xm1), sign);
+        _mm256_maskstore_ps(out.w + i, mask, _mm256_fmadd_ps(cA, aw, _mm256_mul_ps(cB, bw)));
+        _mm256_maskstore_ps(out.x + i, mask, _mm256_fmadd_ps(cA, ax, _mm256_mul_ps(cB, bx)));
+        _mm256_maskstore_ps(out.y + i, mask, _mm256_fmadd_ps(cA, ay, _mm256_mul_ps(cB, by)));
+        _mm256_maskstore_ps(out.z + i, mask, _mm256_fmadd_ps(cA, az, _mm256_mul_ps(cB, bz)));
+    }
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static void NlerpStreamFMA(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(slerpTailMask + 8 - (count - i < 8 ? count - i : 8)));
+        const __m256 aw = _mm256_maskload_ps(a.w + i, mask), ax = _mm256_maskload_ps(a.x + i, mask);
+        const __m256 ay = _mm256_maskload_ps(a.y + i, mask), az = _mm256_maskload_ps(a.z + i, mask);
+        const __m256 bw = _mm256_maskload_ps(b.w + i, mask), bx = _mm256_maskload_ps(b.x + i, mask);
+        const __m256 by = _mm256_maskload_ps(b.y + i, mask), bz = _mm256_maskload_ps(b.z + i, mask);
+        const __m256 ti = _mm256_maskload_ps(t + i, mask);
+
+        __m256 dot = _mm256_mul_ps(aw, bw);
+        dot = _mm256_fmadd_ps(ax, bx, dot);
+        dot = _mm256_fmadd_ps(ay, by, dot);
+        dot = _mm256_fmadd_ps(az, bz, dot);
+        const __m256 cA = _mm256_sub_ps(one, ti);
+        const __m256 cB = _mm256_xor_ps(ti, _mm256_and_ps(dot, signBit));
+
+        const __m256 w = _mm256_fmadd_ps(cA, aw, _mm256_mul_ps(cB, bw));
+        const __m256 x = _mm256_fmadd_ps(cA, ax, _mm256_mul_ps(cB, bx));
+        const __m256 y = _mm256_fmadd_ps(cA, ay, _mm256_mul_ps(cB, by));
+        const __m256 z = _mm256_fmadd_ps(cA, az, _mm256_mul_ps(cB, bz));
+        __m256 length = _mm256_mul_ps(w, w);
+        length = _mm256_fmadd_ps(x, x, length);
+        length = _mm256_fmadd_ps(y, y, length);
+        length = _mm256_fmadd_ps(z, z, length);
+        // Masked lanes are zero, the division result there is never stored.
+        const __m256 inverseLength = _mm256_div_ps(one, _mm256_sqrt_ps(length));
+        _mm256_maskstore_ps(out.w + i, mask, _mm256_mul_ps(w, inverseLength));
+        _mm256_maskstore_ps(out.x + i, mask, _mm256_mul_ps(x, inverseLength));
+        _mm256_maskstore_ps(out.y + i, mask, _mm256_mul_ps(y, inverseLength));
+        _mm256_maskstore_ps(out.z + i, mask, _mm256_mul_ps(z, inverseLength));
+    }
+}
+#endif
+
+static void CheckStreamCount(const QuaternionStream& a, const QuaternionStream& b, const QuaternionStream& out, size_t count) {
+    if (count > a.count || count > b.count || count > out.count) {
+        throw std::out_of_range("Quaternion stream count exceeds the stream size.");
+    }
+}
+
+void Quaternion::SlerpStream(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t count, Precision precision) {
+    CheckStreamCount(a, b, out, count);
+
+    if (precision == Precision::Exact) {
+        for (size_t i = 0; i < count; i++) out.Set(i, a.Get(i).Slerp(b.Get(i), t[i]));
+        return;
+    }
+
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return SlerpStreamFMA(a, b, t, out, count);
+#endif
+        default: return SlerpStreamScalar(a, b, t, out, 0, count);
+    }
+}
+
+void Quaternion::NlerpStream(const QuaternionStream& a, const QuaternionStream& b, const float* t, QuaternionStream& out, size_t count) {
+    CheckStreamCount(a, b, out, count);
+
+    switch (SIMD::Current()) {
+#if W_ENGINE_X86
+        case SIMD::Level::AVX512:
+        case SIMD::Level::FMA: return NlerpStreamFMA(a, b, t, out, count);
+#endif
+        default: return NlerpStreamScalar(a, b, t, out, 0, count);
+    }
+}
+
 Quaternion Quaternion::FromAngleAxis(const float& angleRadians, const Vector4& axis) {
     const float sinTheta = sin(angleRadians / 2);
     return Quaternion(cos(angleRadians / 2), axis.x * sinTheta, axis.y * sinTheta, axis.z * sinTheta);
@@ -168,4 +446,9 @@ Quaternion Quaternion::FromRotationMatrix(const Matrix4& m) {
     const float y = 0.5f * pow((-m.m11 + m.m22 - m.m33 + 1), 2) * ySign;
     const float z = 0.5f * pow((-m.m11 - m.m22 + m.m33 + 1), 2) * zSign;
     return Quaternion(w, x, y, z);
-}
\ No newline at end of file
+}
+
+// Compile-time checks of the constexpr arithmetic. i * j = k, 180 degrees about z maps x to -x.
+static_assert(Quaternion(0, 1, 0, 0).Multiply(Quaternion(0, 0, 1, 0)).Dot(Quaternion(0, 0, 0, 1)) == 1, "Quaternion::Multiply");
+static_assert(Quaternion(0, 0, 0, 1).RotateVector(Vector4(1, 0, 0, 1)).Equals(Vector4(-1, 0, 0, 1)), "Quaternion::RotateVector");
+static_assert(Quaternion(1, 2, 3, 4).Clone().Conjugate().Add(Quaternion(1, 2, 3, 4)).Dot(Quaternion(1, 1, 1, 1)) == 2, "Quaternion::Conjugate");
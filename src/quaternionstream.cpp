@@ -0,0 +1,23 @@
+#include "../include/quaternionstream.h"
+#include "../include/quaternion.h"
+
+QuaternionStream::QuaternionStream(size_t count): SoA4Storage(count) {}
+
+QuaternionStream QuaternionStream::View(float* w, float* x, float* y, float* z, size_t count) {
+    QuaternionStream stream;
+    stream.w = w, stream.x = x, stream.y = y, stream.z = z;
+    stream.count = count;
+    return stream;
+}
+
+QuaternionStream QuaternionStream::Slice(size_t offset, size_t count) const {
+    return View(w + offset, x + offset, y + offset, z + offset, count);
+}
+
+Quaternion QuaternionStream::Get(size_t i) const {
+    return Quaternion(w[i], x[i], y[i], z[i]);
+}
+
+void QuaternionStream::Set(size_t i, const Quaternion& q) {
+    w[i] = q.w, x[i] = q.x, y[i] = q.y, z[i] = q.z;
+}
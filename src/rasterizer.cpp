@@ -0,0 +1,117 @@
+#include "../include/rasterizer.h"
+#include "../include/framebuffer.h"
+#include "../include/vector4.h"
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+static const int subpixelBits = 4;
+static const int subpixel = 1 << subpixelBits;
+
+static inline int64_t Snap(float coordinate) {
+    return std::lround(coordinate * subpixel);
+}
+
+// Division rounding towards negative and positive infinity, divisor is positive.
+static inline int64_t FloorDiv(int64_t a, int64_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static inline int64_t CeilDiv(int64_t a, int64_t b) {
+    return -FloorDiv(-a, b);
+}
+
+static inline void FillSpan(const Framebuffer& framebuffer, int y, int x0, int x1, float zRow, float dzdx, uint32_t color, size_t& written) {
+    uint32_t* colorRow = framebuffer.color + static_cast<size_t>(y) * framebuffer.pitch;
+    if (framebuffer.depth == nullptr) {
+        std::fill(colorRow + x0, colorRow + x1, color);
+        written += x1 - x0;
+        return;
+    }
+
+    float* depthRow = framebuffer.depth + static_cast<size_t>(y) * framebuffer.pitch;
+    for (int x = x0; x < x1; x++) {
+        // Evaluated per pixel like in TiledRasterizer, so both write the same depth.
+        const float z = zRow + (x + 0.5f) * dzdx;
+        if (z < depthRow[x]) {
+            depthRow[x] = z;
+            colorRow[x] = color;
+            written++;
+        }
+    }
+}
+
+size_t Rasterizer::DrawTriangle(Framebuffer& framebuffer, const Vector4& a, const Vector4& b, const Vector4& c, uint32_t color) {
+    const Vector4* v[3] = { &a, &b, &c };
+    for (const Vector4* p : v) {
+        // Also rejects NaN.
+        if (!(std::fabs(p->x) <= coordinateLimit && std::fabs(p->y) <= coordinateLimit)) return 0;
+    }
+
+    int64_t x[3] = { Snap(a.x), Snap(b.x), Snap(c.x) };
+    int64_t y[3] = { Snap(a.y), Snap(b.y), Snap(c.y) };
+    const int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0) return 0;
+    if (area < 0) {
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(v[1], v[2]);
+    }
+
+    // Edge functions ea * px + eb * py + ec in 1/16 pixel units, not negative inside. Samples exactly on an
+    // edge that is neither top nor left are moved outside by the bias, same as in TiledRasterizer.
+    int64_t ea[3], eb[3], ec[3];
+    for (int i = 0; i < 3; i++) {
+        const int j = (i + 1) % 3;
+        ea[i] = y[i] - y[j];
+        eb[i] = x[j] - x[i];
+        const bool topLeft = ea[i] > 0 || (ea[i] == 0 && eb[i] > 0);
+        ec[i] = x[i] * y[j] - y[i] * x[j] - (topLeft ? 0 : 1);
+    }
+
+    // Depth plane z(x, y) = zOrigin + x * dzdx + y * dzdy.
+    const Vector4& p0 = *v[0];
+    const Vector4& p1 = *v[1];
+    const Vector4& p2 = *v[2];
+    const float planeArea = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+    float dzdx = 0.0f, dzdy = 0.0f, zOrigin = p0.z;
+    if (planeArea != 0.0f) {
+        dzdx = ((p1.z - p0.z) * (p2.y - p0.y) - (p2.z - p0.z) * (p1.y - p0.y)) / planeArea;
+        dzdy = ((p2.z - p0.z) * (p1.x - p0.x) - (p1.z - p0.z) * (p2.x - p0.x)) / planeArea;
+        zOrigin = p0.z - p0.x * dzdx - p0.y * dzdy;
+    }
+
+    // Rows whose centers may be covered.
+    const int64_t minY = std::min({ y[0], y[1], y[2] }), maxY = std::max({ y[0], y[1], y[2] });
+    const int y0 = static_cast<int>(std::max<int64_t>(0, (minY - subpixel / 2) >> subpixelBits));
+    const int y1 = static_cast<int>(std::min<int64_t>(framebuffer.height - 1, (maxY - subpixel / 2) >> subpixelBits));
+
+    size_t written = 0;
+    for (int row = y0; row <= y1; row++) {
+        const int64_t center = int64_t(row) * subpixel + subpixel / 2;
+        // Each edge is a * column + r >= 0 over the pixel columns, solved exactly for the covered span.
+        int64_t first = 0, last = framebuffer.width - 1;
+        for (int e = 0; e < 3; e++) {
+            const int64_t slope = ea[e] * subpixel;
+            const int64_t r = ea[e] * (subpixel / 2) + eb[e] * center + ec[e];
+            if (slope > 0) {
+                first = std::max(first, CeilDiv(-r, slope));
+            } else if (slope < 0) {
+                last = std::min(last, FloorDiv(r, -slope));
+            } else if (r < 0) {
+                last = -1;
+            }
+        }
+        if (first > last) continue;
+        FillSpan(framebuffer, row, static_cast<int>(first), static_cast<int>(last) + 1, zOrigin + (row + 0.5f) * dzdy, dzdx, color, written);
+    }
+    return written;
+}
+
+size_t Rasterizer::DrawTriangles(Framebuffer& framebuffer, const Vector4* vertices, const uint32_t* indices, size_t triangleCount, uint32_t color) {
+    size_t written = 0;
+    for (size_t i = 0; i < triangleCount; i++) {
+        written += DrawTriangle(framebuffer, vertices[indices[3 * i]], vertices[indices[3 * i + 1]], vertices[indices[3 * i + 2]], color);
+    }
+    return written;
+}
@@ -0,0 +1,263 @@
+#include "../include/scenefile.h"
+#include "../include/matrix4.h"
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static constexpr char magic[8] = { 'W', 'S', 'C', 'E', 'N', 'E', '\0', '\0' };
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t fileSize;
+    uint8_t reserved[40];
+};
+
+struct SectionEntry {
+    uint32_t type;
+    uint32_t components;
+    uint64_t count;
+    uint64_t offset;
+    uint64_t stride;
+};
+
+static_assert(sizeof(FileHeader) == 64, "SceneFile header must be 64 bytes.");
+static_assert(sizeof(SectionEntry) == 32, "SceneFile section entry must be 32 bytes.");
+static_assert(sizeof(Matrix4) == 64, "SceneFile stores Matrix4 as 16 packed floats.");
+
+static constexpr uint32_t sectionTypes = 5;
+
+// Component arrays and element size of every section type.
+static void LayoutOf(uint32_t type, uint32_t& components, size_t& elementSize) {
+    switch (static_cast<SceneFile::Section>(type)) {
+        case SceneFile::Section::Indices: components = 1; elementSize = sizeof(uint32_t); return;
+        case SceneFile::Section::Matrices: components = 1; elementSize = sizeof(Matrix4); return;
+        default: components = 4; elementSize = sizeof(float); return;
+    }
+}
+
+static size_t AlignUp(size_t value) {
+    return (value + SceneFile::alignment - 1) / SceneFile::alignment * SceneFile::alignment;
+}
+
+// The sections are the in-memory arrays, so the format is only readable and writable by little-endian hosts.
+static void CheckLittleEndian() {
+    const uint32_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    if (first != 1) throw std::runtime_error("SceneFile requires a little-endian host.");
+}
+
+static void Unmap(unsigned char* data, size_t size) {
+    if (data == nullptr) return;
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+// Copy-on-write mapping of the whole file, so that the non-owning streams may be written without touching the file.
+static unsigned char* Map(const std::string& path, size_t& size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path + ".");
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader))) {
+        CloseHandle(file);
+        throw std::invalid_argument(path + " is not a scene file.");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+    if (mapping != nullptr) CloseHandle(mapping);
+    CloseHandle(file);
+    if (view == nullptr) throw std::runtime_error("Cannot map " + path + ".");
+    size = static_cast<size_t>(length.QuadPart);
+    return static_cast<unsigned char*>(view);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) throw std::runtime_error("Cannot open " + path + ".");
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(file);
+        throw std::invalid_argument(path + " is not a scene file.");
+    }
+    size = static_cast<size_t>(status.st_size);
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) throw std::runtime_error("Cannot map " + path + ".");
+    return static_cast<unsigned char*>(view);
+#endif
+}
+
+SceneFile::SceneFile(const std::string& path) {
+    CheckLittleEndian();
+    data = Map(path, size);
+    try {
+        FileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+            throw std::invalid_argument(path + " is not a scene file.");
+        }
+        if (header.version != version) {
+            throw std::invalid_argument(path + " has unsupported scene file version " + std::to_string(header.version) + ".");
+        }
+        if (header.fileSize != size || (size - sizeof(FileHeader)) / sizeof(SectionEntry) < header.sectionCount) {
+            throw std::invalid_argument(path + " is truncated.");
+        }
+        for (uint32_t s = 0; s < header.sectionCount; s++) {
+            SectionEntry entry;
+            std::memcpy(&entry, data + sizeof(FileHeader) + s * sizeof(SectionEntry), sizeof(entry));
+            if (entry.type == 0 || entry.type > sectionTypes) continue;
+
+            uint32_t components;
+            size_t elementSize;
+            LayoutOf(entry.type, components, elementSize);
+            if (entry.components != components || entry.offset % alignment != 0 || entry.stride % alignment != 0 ||
+                entry.count > entry.stride / elementSize || entry.offset > size || (size - entry.offset) / components < entry.stride) {
+                throw std::invalid_argument(path + " has a corrupted section table.");
+            }
+            Mapped& mapped = sections[entry.type - 1];
+            if (mapped.data != nullptr) {
+                throw std::invalid_argument(path + " contains a section twice.");
+            }
+            mapped.data = data + entry.offset;
+            mapped.count = static_cast<size_t>(entry.count);
+            mapped.stride = static_cast<size_t>(entry.stride);
+        }
+    } catch (...) {
+        Unmap(data, size);
+        throw;
+    }
+}
+
+SceneFile::SceneFile(SceneFile&& file) noexcept: data(file.data), size(file.size) {
+    for (uint32_t s = 0; s < sectionTypes; s++) sections[s] = file.sections[s];
+    file.data = nullptr;
+    file.size = 0;
+}
+
+SceneFile::~SceneFile() {
+    Unmap(data, size);
+}
+
+void SceneFile::Write(const std::string& path, const Contents& contents) {
+    CheckLittleEndian();
+    struct Source {
+        SectionEntry entry;
+        const void* arrays[4];
+    };
+    Source sources[sectionTypes];
+    uint32_t sectionCount = 0;
+    auto add = [&](Section section, size_t count, const void* a, const void* b = nullptr, const void* c = nullptr, const void* d = nullptr) {
+        Source& source = sources[sectionCount++];
+        size_t elementSize;
+        source.entry.type = static_cast<uint32_t>(section);
+        LayoutOf(source.entry.type, source.entry.components, elementSize);
+        source.entry.count = count;
+        source.entry.stride = AlignUp(count * elementSize);
+        source.arrays[0] = a, source.arrays[1] = b, source.arrays[2] = c, source.arrays[3] = d;
+    };
+    if (contents.positions) add(Section::Positions, contents.positions->count, contents.positions->x, contents.positions->y, contents.positions->z, contents.positions->w);
+    if (contents.normals) add(Section::Normals, contents.normals->count, contents.normals->x, contents.normals->y, contents.normals->z, contents.normals->w);
+    if (contents.indices) add(Section::Indices, contents.indexCount, contents.indices);
+    if (contents.matrices) add(Section::Matrices, contents.matrixCount, contents.matrices);
+    if (contents.quaternions) add(Section::Quaternions, contents.quaternions->count, contents.quaternions->w, contents.quaternions->x, contents.quaternions->y, contents.quaternions->z);
+
+    size_t offset = AlignUp(sizeof(FileHeader) + sectionCount * sizeof(SectionEntry));
+    for (uint32_t s = 0; s < sectionCount; s++) {
+        sources[s].entry.offset = offset;
+        offset += sources[s].entry.components * sources[s].entry.stride;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.sectionCount = sectionCount;
+    header.fileSize = offset;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("Cannot open " + path + " for writing.");
+    static const char zeros[alignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (uint32_t s = 0; s < sectionCount; s++) {
+        file.write(reinterpret_cast<const char*>(&sources[s].entry), sizeof(SectionEntry));
+    }
+    const size_t tableEnd = sizeof(FileHeader) + sectionCount * sizeof(SectionEntry);
+    file.write(zeros, AlignUp(tableEnd) - tableEnd);
+    for (uint32_t s = 0; s < sectionCount; s++) {
+        const SectionEntry& entry = sources[s].entry;
+        uint32_t components;
+        size_t elementSize;
+        LayoutOf(entry.type, components, elementSize);
+        const size_t bytes = static_cast<size_t>(entry.count) * elementSize;
+        for (uint32_t c = 0; c < components; c++) {
+            file.write(static_cast<const char*>(sources[s].arrays[c]), bytes);
+            file.write(zeros, entry.stride - bytes);
+        }
+    }
+    if (!file) throw std::runtime_error("Cannot write " + path + ".");
+}
+
+const SceneFile::Mapped& SceneFile::Get(Section section) const {
+    return sections[static_cast<uint32_t>(section) - 1];
+}
+
+float* SceneFile::Component(Section section, size_t component) const {
+    const Mapped& mapped = Get(section);
+    return reinterpret_cast<float*>(mapped.data + component * mapped.stride);
+}
+
+bool SceneFile::Has(Section section) const {
+    return Get(section).data != nullptr;
+}
+
+Vector4Stream SceneFile::Positions() const {
+    if (!Has(Section::Positions)) return Vector4Stream();
+    return Vector4Stream::View(Component(Section::Positions, 0), Component(Section::Positions, 1),
+                               Component(Section::Positions, 2), Component(Section::Positions, 3), Get(Section::Positions).count);
+}
+
+Vector4Stream SceneFile::Normals() const {
+    if (!Has(Section::Normals)) return Vector4Stream();
+    return Vector4Stream::View(Component(Section::Normals, 0), Component(Section::Normals, 1),
+                               Component(Section::Normals, 2), Component(Section::Normals, 3), Get(Section::Normals).count);
+}
+
+QuaternionStream SceneFile::Quaternions() const {
+    if (!Has(Section::Quaternions)) return QuaternionStream();
+    return QuaternionStream::View(Component(Section::Quaternions, 0), Component(Section::Quaternions, 1),
+                                  Component(Section::Quaternions, 2), Component(Section::Quaternions, 3), Get(Section::Quaternions).count);
+}
+
+const uint32_t* SceneFile::Indices() const {
+    return reinterpret_cast<const uint32_t*>(Get(Section::Indices).data);
+}
+
+size_t SceneFile::IndexCount() const {
+    return Get(Section::Indices).count;
+}
+
+const Matrix4* SceneFile::Matrices() const {
+    return reinterpret_cast<const Matrix4*>(Get(Section::Matrices).data);
+}
+
+size_t SceneFile::MatrixCount() const {
+    return Get(Section::Matrices).count;
+}
+
+size_t SceneFile::Size() const {
+    return size;
+}
@@ -0,0 +1,39 @@
+#include "../include/simd.h"
+
+SIMD::Level SIMD::Detect() {
+#if W_ENGINE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Level::FMA;
+    if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+    if (__builtin_cpu_supports("sse2")) return Level::SSE2;
+#endif
+    return Level::Scalar;
+}
+
+std::atomic<SIMD::Level>& SIMD::Active() {
+    static std::atomic<Level> level{ Detect() };
+    return level;
+}
+
+SIMD::Level SIMD::Current() {
+    return Active().load(std::memory_order_relaxed);
+}
+
+SIMD::Level SIMD::SetLevel(Level level) {
+    const Level detected = Detect();
+    const Level clamped = level > detected ? detected : level;
+    Active().store(clamped, std::memory_order_relaxed);
+    return clamped;
+}
+
+const char* SIMD::LevelToString(Level level) {
+    switch (level) {
+        case Level::Scalar: return "Scalar";
+        case Level::SSE2: return "SSE2";
+        case Level::AVX2: return "AVX2";
+        case Level::FMA: return "FMA";
+        case Level::AVX512: return "AVX512";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,332 @@
+#include "../include/skinning.h"
+#include "../include/threadpool.h"
+#include "../include/vector4stream.h"
+#include "../include/matrix4.h"
+#include "../include/simd.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+Skinning::Skinning(ThreadPool& pool, size_t chunkSize):
+    pool(pool), chunkSize((chunkSize + 15) / 16 * 16) {
+    if (this->chunkSize == 0) this->chunkSize = 16;
+}
+
+void Skinning::Validate(size_t jointCount, const Influences& influences, const Vector4Stream& positions, const Vector4Stream& outPositions,
+                        const Vector4Stream* normals, const Vector4Stream* outNormals) const {
+    if (jointCount == 0 || jointCount > 0x10000) {
+        throw std::invalid_argument("Skinning palette must hold between 1 and 65536 joints.");
+    }
+    if (influences.count == 0 || influences.count > maxInfluences) {
+        throw std::invalid_argument("Skinning supports between 1 and 8 influences per vertex.");
+    }
+    if (influences.stride < positions.count) {
+        throw std::out_of_range("Skinning influence stride is shorter than the vertex count.");
+    }
+    if (outPositions.count < positions.count) {
+        throw std::out_of_range("Skinning output positions are shorter than the input.");
+    }
+    if ((normals == nullptr) != (outNormals == nullptr)) {
+        throw std::invalid_argument("Skinning normals and output normals must be given together.");
+    }
+    if (normals != nullptr && (normals->count < positions.count || outNormals->count < positions.count)) {
+        throw std::out_of_range("Skinning normal streams are shorter than the positions.");
+    }
+    // Every 16-bit index is inside a full palette of 65536 joints.
+    if (jointCount == 0x10000) return;
+    // A maximum without early exit vectorizes, the scan stays small next to the skinning itself.
+    uint16_t largest = 0;
+    for (size_t k = 0; k < influences.count; k++) {
+        const uint16_t* joints = influences.joints + k * influences.stride;
+        for (size_t v = 0; v < positions.count; v++) largest = std::max(largest, joints[v]);
+    }
+    if (largest >= jointCount) {
+        throw std::out_of_range("Skinning joint index is out of the palette range.");
+    }
+}
+
+// Linear blend: 12 floats per joint, rows of the upper 3x4 block.
+
+static void LinearBlendScalar(const float* joints, const Skinning::Influences& influences, const Vector4Stream& positions, Vector4Stream& outPositions,
+                              const Vector4Stream* normals, Vector4Stream* outNormals, size_t begin, size_t end) {
+    for (size_t v = begin; v < end; v++) {
+        float m[12] = {};
+        for (size_t k = 0; k < influences.count; k++) {
+            const float weight = influences.weights[k * influences.stride + v];
+            const float* joint = joints + 12 * influences.joints[k * influences.stride + v];
+            for (int e = 0; e < 12; e++) m[e] += weight * joint[e];
+        }
+
+        const float x = positions.x[v], y = positions.y[v], z = positions.z[v], w = positions.w[v];
+        outPositions.x[v] = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+        outPositions.y[v] = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+        outPositions.z[v] = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+        outPositions.w[v] = w;
+
+        if (normals == nullptr) continue;
+        const float nx = normals->x[v], ny = normals->y[v], nz = normals->z[v];
+        const float rx = m[0] * nx + m[1] * ny + m[2] * nz;
+        const float ry = m[4] * nx + m[5] * ny + m[6] * nz;
+        const float rz = m[8] * nx + m[9] * ny + m[10] * nz;
+        const float inverseLength = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz);
+        outNormals->x[v] = rx * inverseLength;
+        outNormals->y[v] = ry * inverseLength;
+        outNormals->z[v] = rz * inverseLength;
+        outNormals->w[v] = normals->w[v];
+    }
+}
+
+// Dual quaternion: 8 floats per joint, real part w, x, y, z followed by dual part w, x, y, z.
+
+static void DualQuaternionScalar(const float* joints, const Skinning::Influences& influences, const Vector4Stream& positions, Vector4Stream& outPositions,
+                                 const Vector4Stream* normals, Vector4Stream* outNormals, size_t begin, size_t end) {
+    for (size_t v = begin; v < end; v++) {
+        float b[8] = {};
+        const float* pivot = joints + 8 * influences.joints[v];
+        for (size_t k = 0; k < influences.count; k++) {
+            const float* joint = joints + 8 * influences.joints[k * influences.stride + v];
+            float weight = influences.weights[k * influences.stride + v];
+            if (pivot[0] * joint[0] + pivot[1] * joint[1] + pivot[2] * joint[2] + pivot[3] * joint[3] < 0) weight = -weight;
+            for (int e = 0; e < 8; e++) b[e] += weight * joint[e];
+        }
+
+        const float inverseLength = 1.0f / std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+        const float rw = b[0] * inverseLength, rx = b[1] * inverseLength, ry = b[2] * inverseLength, rz = b[3] * inverseLength;
+        const float dw = b[4] * inverseLength, dx = b[5] * inverseLength, dy = b[6] * inverseLength, dz = b[7] * inverseLength;
+        // Translation 2 * dual * conjugate(real).
+        const float tx = 2 * (rw * dx - dw * rx + ry * dz - rz * dy);
+        const float ty = 2 * (rw * dy - dw * ry + rz * dx - rx * dz);
+        const float tz = 2 * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+        const float x = positions.x[v], y = positions.y[v], z = positions.z[v], w = positions.w[v];
+        const float cx = 2 * (ry * z - rz * y), cy = 2 * (rz * x - rx * z), cz = 2 * (rx * y - ry * x);
+        outPositions.x[v] = x + rw * cx + (ry * cz - rz * cy) + tx * w;
+        outPositions.y[v] = y + rw * cy + (rz * cx - rx * cz) + ty * w;
+        outPositions.z[v] = z + rw * cz + (rx * cy - ry * cx) + tz * w;
+        outPositions.w[v] = w;
+
+        if (normals == nullptr) continue;
+        const float nx = normals->x[v], ny = normals->y[v], nz = normals->z[v];
+        const float ex = 2 * (ry * nz - rz * ny), ey = 2 * (rz * nx - rx * nz), ez = 2 * (rx * ny - ry * nx);
+        outNormals->x[v] = nx + rw * ex + (ry * ez - rz * ey);
+        outNormals->y[v] = ny + rw * ey + (rz * ex - rx * ez);
+        outNormals->z[v] = nz + rw * ez + (rx * ey - ry * ex);
+        outNormals->w[v] = normals->w[v];
+    }
+}
+
+#if W_ENGINE_X86
+// Loads 4 consecutive floats at offset of the joints of 8 vertices and transposes them into 4 registers of 8 lanes.
+// Unaligned 128-bit loads and in-lane shuffles are cheaper than one gather per element.
+W_ENGINE_TARGET("avx2,fma")
+static inline void LoadJointColumns(const float* joints, const uint16_t* indices, size_t stride, size_t offset, __m256 out[4]) {
+    __m256 r[4];
+    for (int i = 0; i < 4; i++) {
+        const __m128 low = _mm_loadu_ps(joints + indices[i] * stride + offset);
+        const __m128 high = _mm_loadu_ps(joints + indices[i + 4] * stride + offset);
+        r[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+    }
+    const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpacklo_ps(r[2], r[3]);
+    const __m256 t2 = _mm256_unpackhi_ps(r[0], r[1]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    out[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    out[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    out[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    out[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static size_t LinearBlendFMA(const float* joints, const Skinning::Influences& influences, const Vector4Stream& positions, Vector4Stream& outPositions,
+                             const Vector4Stream* normals, Vector4Stream* outNormals, size_t begin, size_t end) {
+    size_t v = begin;
+    for (; v + 8 <= end; v += 8) {
+        __m256 m[12];
+        for (int e = 0; e < 12; e++) m[e] = _mm256_setzero_ps();
+        for (size_t k = 0; k < influences.count; k++) {
+            const __m256 weight = _mm256_loadu_ps(influences.weights + k * influences.stride + v);
+            const uint16_t* indices = influences.joints + k * influences.stride + v;
+            for (int row = 0; row < 3; row++) {
+                __m256 columns[4];
+                LoadJointColumns(joints, indices, 12, 4 * row, columns);
+                for (int e = 0; e < 4; e++) m[4 * row + e] = _mm256_fmadd_ps(weight, columns[e], m[4 * row + e]);
+            }
+        }
+
+        const __m256 x = _mm256_loadu_ps(positions.x + v), y = _mm256_loadu_ps(positions.y + v);
+        const __m256 z = _mm256_loadu_ps(positions.z + v), w = _mm256_loadu_ps(positions.w + v);
+        float* outs[3] = { outPositions.x + v, outPositions.y + v, outPositions.z + v };
+        for (int r = 0; r < 3; r++) {
+            __m256 p = _mm256_mul_ps(m[4 * r], x);
+            p = _mm256_fmadd_ps(m[4 * r + 1], y, p);
+            p = _mm256_fmadd_ps(m[4 * r + 2], z, p);
+            _mm256_storeu_ps(outs[r], _mm256_fmadd_ps(m[4 * r + 3], w, p));
+        }
+        _mm256_storeu_ps(outPositions.w + v, w);
+
+        if (normals == nullptr) continue;
+        const __m256 nx = _mm256_loadu_ps(normals->x + v), ny = _mm256_loadu_ps(normals->y + v);
+        const __m256 nz = _mm256_loadu_ps(normals->z + v), nw = _mm256_loadu_ps(normals->w + v);
+        __m256 n[3];
+        for (int r = 0; r < 3; r++) {
+            n[r] = _mm256_mul_ps(m[4 * r], nx);
+            n[r] = _mm256_fmadd_ps(m[4 * r + 1], ny, n[r]);
+            n[r] = _mm256_fmadd_ps(m[4 * r + 2], nz, n[r]);
+        }
+        __m256 length = _mm256_mul_ps(n[0], n[0]);
+        length = _mm256_fmadd_ps(n[1], n[1], length);
+        length = _mm256_fmadd_ps(n[2], n[2], length);
+        const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(length));
+        _mm256_storeu_ps(outNormals->x + v, _mm256_mul_ps(n[0], inverseLength));
+        _mm256_storeu_ps(outNormals->y + v, _mm256_mul_ps(n[1], inverseLength));
+        _mm256_storeu_ps(outNormals->z + v, _mm256_mul_ps(n[2], inverseLength));
+        _mm256_storeu_ps(outNormals->w + v, nw);
+    }
+    return v;
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static inline __m256 Cross(__m256 ay, __m256 az, __m256 by, __m256 bz) {
+    return _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by));
+}
+
+W_ENGINE_TARGET("avx2,fma")
+static size_t DualQuaternionFMA(const float* joints, const Skinning::Influences& influences, const Vector4Stream& positions, Vector4Stream& outPositions,
+                                const Vector4Stream* normals, Vector4Stream* outNormals, size_t begin, size_t end) {
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    size_t v = begin;
+    for (; v + 8 <= end; v += 8) {
+        __m256 b[8] = {}, pivot[4] = {};
+        for (size_t k = 0; k < influences.count; k++) {
+            __m256 weight = _mm256_loadu_ps(influences.weights + k * influences.stride + v);
+            const uint16_t* indices = influences.joints + k * influences.stride + v;
+            __m256 q[8];
+            LoadJointColumns(joints, indices, 8, 0, q);
+            LoadJointColumns(joints, indices, 8, 4, q + 4);
+            if (k == 0) {
+                for (int e = 0; e < 4; e++) pivot[e] = q[e];
+                for (int e = 0; e < 8; e++) b[e] = _mm256_mul_ps(weight, q[e]);
+                continue;
+            }
+            __m256 dot = _mm256_mul_ps(pivot[0], q[0]);
+            dot = _mm256_fmadd_ps(pivot[1], q[1], dot);
+            dot = _mm256_fmadd_ps(pivot[2], q[2], dot);
+            dot = _mm256_fmadd_ps(pivot[3], q[3], dot);
+            weight = _mm256_xor_ps(weight, _mm256_and_ps(dot, signBit));
+            for (int e = 0; e < 8; e++) b[e] = _mm256_fmadd_ps(weight, q[e], b[e]);
+        }
+
+        __m256 length = _mm256_mul_ps(b[0], b[0]);
+        length = _mm256_fmadd_ps(b[1], b[1], length);
+        length = _mm256_fmadd_ps(b[2], b[2], length);
+        length = _mm256_fmadd_ps(b[3], b[3], length);
+        const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(length));
+        const __m256 rw = _mm256_mul_ps(b[0], inverseLength), rx = _mm256_mul_ps(b[1], inverseLength);
+        const __m256 ry = _mm256_mul_ps(b[2], inverseLength), rz = _mm256_mul_ps(b[3], inverseLength);
+        const __m256 dw = _mm256_mul_ps(b[4], inverseLength), dx = _mm256_mul_ps(b[5], inverseLength);
+        const __m256 dy = _mm256_mul_ps(b[6], inverseLength), dz = _mm256_mul_ps(b[7], inverseLength);
+        const __m256 tx = _mm256_mul_ps(two, _mm256_add_ps(_mm256_fmsub_ps(rw, dx, _mm256_mul_ps(dw, rx)), Cross(ry, rz, dy, dz)));
+        const __m256 ty = _mm256_mul_ps(two, _mm256_add_ps(_mm256_fmsub_ps(rw, dy, _mm256_mul_ps(dw, ry)), Cross(rz, rx, dz, dx)));
+        const __m256 tz = _mm256_mul_ps(two, _mm256_add_ps(_mm256_fmsub_ps(rw, dz, _mm256_mul_ps(dw, rz)), Cross(rx, ry, dx, dy)));
+
+        const __m256 x = _mm256_loadu_ps(positions.x + v), y = _mm256_loadu_ps(positions.y + v);
+        const __m256 z = _mm256_loadu_ps(positions.z + v), w = _mm256_loadu_ps(positions.w + v);
+        const __m256 cx = _mm256_mul_ps(two, Cross(ry, rz, y, z));
+        const __m256 cy = _mm256_mul_ps(two, Cross(rz, rx, z, x));
+        const __m256 cz = _mm256_mul_ps(two, Cross(rx, ry, x, y));
+        _mm256_storeu_ps(outPositions.x + v, _mm256_fmadd_ps(tx, w, _mm256_add_ps(_mm256_fmadd_ps(rw, cx, x), Cross(ry, rz, cy, cz))));
+        _mm256_storeu_ps(outPositions.y + v, _mm256_fmadd_ps(ty, w, _mm256_add_ps(_mm256_fmadd_ps(rw, cy, y), Cross(rz, rx, cz, cx))));
+        _mm256_storeu_ps(outPositions.z + v, _mm256_fmadd_ps(tz, w, _mm256_add_ps(_mm256_fmadd_ps(rw, cz, z), Cross(rx, ry, cx, cy))));
+        _mm256_storeu_ps(outPositions.w + v, w);
+
+        if (normals == nullptr) continue;
+        const __m256 nx = _mm256_loadu_ps(normals->x + v), ny = _mm256_loadu_ps(normals->y + v);
+        const __m256 nz = _mm256_loadu_ps(normals->z + v), nw = _mm256_loadu_ps(normals->w + v);
+        const __m256 ex = _mm256_mul_ps(two, Cross(ry, rz, ny, nz));
+        const __m256 ey = _mm256_mul_ps(two, Cross(rz, rx, nz, nx));
+        const __m256 ez = _mm256_mul_ps(two, Cross(rx, ry, nx, ny));
+        _mm256_storeu_ps(outNormals->x + v, _mm256_add_ps(_mm256_fmadd_ps(rw, ex, nx), Cross(ry, rz, ey, ez)));
+        _mm256_storeu_ps(outNormals->y + v, _mm256_add_ps(_mm256_fmadd_ps(rw, ey, ny), Cross(rz, rx, ez, ex)));
+        _mm256_storeu_ps(outNormals->z + v, _mm256_add_ps(_mm256_fmadd_ps(rw, ez, nz), Cross(rx, ry, ex, ey)));
+        _mm256_storeu_ps(outNormals->w + v, nw);
+    }
+    return v;
+}
+#endif
+
+void Skinning::LinearBlend(const Matrix4* palette, size_t jointCount, const Influences& influences,
+                           const Vector4Stream& positions, Vector4Stream& outPositions,
+                           const Vector4Stream* normals, Vector4Stream* outNormals) {
+    Validate(jointCount, influences, positions, outPositions, normals, outNormals);
+
+    joints.resize(12 * jointCount);
+    for (size_t j = 0; j < jointCount; j++) {
+        const Matrix4& m = palette[j];
+        const float rows[12] = { m.m11, m.m12, m.m13, m.m14, m.m21, m.m22, m.m23, m.m24, m.m31, m.m32, m.m33, m.m34 };
+        std::copy(rows, rows + 12, joints.begin() + 12 * j);
+    }
+
+    const float* packed = joints.data();
+    const size_t count = positions.count;
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    pool.Run(chunks, [&](size_t chunk, size_t) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        size_t v = begin;
+#if W_ENGINE_X86
+        if (SIMD::Current() >= SIMD::Level::FMA) v = LinearBlendFMA(packed, influences, positions, outPositions, normals, outNormals, begin, end);
+#endif
+        LinearBlendScalar(packed, influences, positions, outPositions, normals, outNormals, v, end);
+    });
+}
+
+// Rotation part of a column-vector matrix as a unit quaternion, branch on the largest diagonal term for stability.
+static void RotationQuaternion(const Matrix4& m, float* q) {
+    const float trace = m.m11 + m.m22 + m.m33;
+    if (trace > 0) {
+        const float s = 2 * std::sqrt(trace + 1);
+        q[0] = 0.25f * s, q[1] = (m.m32 - m.m23) / s, q[2] = (m.m13 - m.m31) / s, q[3] = (m.m21 - m.m12) / s;
+    } else if (m.m11 > m.m22 && m.m11 > m.m33) {
+        const float s = 2 * std::sqrt(1 + m.m11 - m.m22 - m.m33);
+        q[0] = (m.m32 - m.m23) / s, q[1] = 0.25f * s, q[2] = (m.m12 + m.m21) / s, q[3] = (m.m13 + m.m31) / s;
+    } else if (m.m22 > m.m33) {
+        const float s = 2 * std::sqrt(1 + m.m22 - m.m11 - m.m33);
+        q[0] = (m.m13 - m.m31) / s, q[1] = (m.m12 + m.m21) / s, q[2] = 0.25f * s, q[3] = (m.m23 + m.m32) / s;
+    } else {
+        const float s = 2 * std::sqrt(1 + m.m33 - m.m11 - m.m22);
+        q[0] = (m.m21 - m.m12) / s, q[1] = (m.m13 + m.m31) / s, q[2] = (m.m23 + m.m32) / s, q[3] = 0.25f * s;
+    }
+    const float inverseLength = 1.0f / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int e = 0; e < 4; e++) q[e] *= inverseLength;
+}
+
+void Skinning::DualQuaternion(const Matrix4* palette, size_t jointCount, const Influences& influences,
+                              const Vector4Stream& positions, Vector4Stream& outPositions,
+                              const Vector4Stream* normals, Vector4Stream* outNormals) {
+    Validate(jointCount, influences, positions, outPositions, normals, outNormals);
+
+    joints.resize(8 * jointCount);
+    for (size_t j = 0; j < jointCount; j++) {
+        const Matrix4& m = palette[j];
+        float* q = joints.data() + 8 * j;
+        RotationQuaternion(m, q);
+        // Dual part 0.5 * (0, t) * real.
+        const float tx = m.m14, ty = m.m24, tz = m.m34;
+        q[4] = -0.5f * (tx * q[1] + ty * q[2] + tz * q[3]);
+        q[5] = 0.5f * (tx * q[0] + ty * q[3] - tz * q[2]);
+        q[6] = 0.5f * (-tx * q[3] + ty * q[0] + tz * q[1]);
+        q[7] = 0.5f * (tx * q[2] - ty * q[1] + tz * q[0]);
+    }
+
+    const float* packed = joints.data();
+    const size_t count = positions.count;
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    pool.Run(chunks, [&](size_t chunk, size_t) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        size_t v = begin;
+#if W_ENGINE_X86
+        if (SIMD::Current() >= SIMD::Level::FMA) v = DualQuaternionFMA(packed, influences, positions, outPositions, normals, outNormals, begin, end);
+#endif
+        DualQuaternionScalar(packed, influences, positions, outPositions, normals, outNormals, v, end);
+    });
+}
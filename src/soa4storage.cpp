@@ -0,0 +1,63 @@
+#include "../include/soa4storage.h"
+#include <new>
+#include <utility>
+#include <algorithm>
+
+static size_t PaddedCount(size_t count) {
+    const size_t lanes = SoA4Storage::alignment / sizeof(float);
+    return (count + lanes - 1) / lanes * lanes;
+}
+
+SoA4Storage::SoA4Storage(size_t count): x(nullptr), y(nullptr), z(nullptr), w(nullptr), count(count), data(nullptr) {
+    if (count == 0) return;
+    const size_t stride = PaddedCount(count);
+    data = static_cast<float*>(::operator new(4 * stride * sizeof(float), std::align_val_t(alignment)));
+    std::fill(data, data + 4 * stride, 0.0f);
+    x = data;
+    y = data + stride;
+    z = data + 2 * stride;
+    w = data + 3 * stride;
+}
+
+SoA4Storage::SoA4Storage(const SoA4Storage& storage): SoA4Storage(storage.count) {
+    std::copy(storage.x, storage.x + count, x);
+    std::copy(storage.y, storage.y + count, y);
+    std::copy(storage.z, storage.z + count, z);
+    std::copy(storage.w, storage.w + count, w);
+}
+
+SoA4Storage::SoA4Storage(SoA4Storage&& storage) noexcept:
+    x(storage.x), y(storage.y), z(storage.z), w(storage.w), count(storage.count), data(storage.data) {
+    storage.x = storage.y = storage.z = storage.w = nullptr;
+    storage.count = 0;
+    storage.data = nullptr;
+}
+
+SoA4Storage& SoA4Storage::operator=(const SoA4Storage& storage) {
+    SoA4Storage copy(storage);
+    Swap(copy);
+    return *this;
+}
+
+SoA4Storage& SoA4Storage::operator=(SoA4Storage&& storage) noexcept {
+    SoA4Storage moved(std::move(storage));
+    Swap(moved);
+    return *this;
+}
+
+void SoA4Storage::Swap(SoA4Storage& storage) noexcept {
+    std::swap(x, storage.x);
+    std::swap(y, storage.y);
+    std::swap(z, storage.z);
+    std::swap(w, storage.w);
+    std::swap(count, storage.count);
+    std::swap(data, storage.data);
+}
+
+SoA4Storage::~SoA4Storage() {
+    if (data) ::operator delete(data, std::align_val_t(alignment));
+}
+
+bool SoA4Storage::Owns() const {
+    return data != nullptr;
+}
@@ -0,0 +1,104 @@
+#include "../include/threadpool.h"
+
+ThreadPool::ThreadPool(size_t threads) {
+    size = threads != 0 ? threads : std::thread::hardware_concurrency();
+    if (size == 0) size = 1;
+
+    queues.reset(new Queue[size]);
+    for (size_t worker = 1; worker < size; worker++) {
+        this->threads.emplace_back(&ThreadPool::Loop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::Size() const {
+    return size;
+}
+
+void ThreadPool::Run(size_t jobs, const std::function<void(size_t job, size_t worker)>& task) {
+    if (jobs == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        error = nullptr;
+        remaining.store(jobs);
+        for (size_t worker = 0; worker < size; worker++) {
+            std::lock_guard<std::mutex> queueLock(queues[worker].mutex);
+            for (size_t job = jobs * worker / size; job < jobs * (worker + 1) / size; job++) {
+                queues[worker].jobs.push_back(job);
+            }
+        }
+        generation++;
+    }
+    wake.notify_all();
+
+    Work(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return remaining.load() == 0; });
+    this->task = nullptr;
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::Loop(size_t worker) {
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        Work(worker);
+    }
+}
+
+void ThreadPool::Work(size_t worker) {
+    size_t job;
+    while (Pop(worker, job)) {
+        // The task pointer is published before the jobs are queued, so it is current for any popped job.
+        try {
+            (*task)(job, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+        if (remaining.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            done.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::Pop(size_t worker, size_t& job) {
+    {
+        Queue& own = queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < size; i++) {
+        Queue& victim = queues[(worker + i) % size];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
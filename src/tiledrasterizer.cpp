@@ -0,0 +1,237 @@
+#include "../include/tiledrasterizer.h"
+#include "../include/framebuffer.h"
+#include "../include/threadpool.h"
+#include "../include/vector4.h"
+#include "../include/simd.h"
+#include <cmath>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+
+static const int subpixelBits = 4;
+static const int subpixel = 1 << subpixelBits;
+
+static inline int32_t Snap(float coordinate) {
+    return static_cast<int32_t>(std::lround(coordinate * subpixel));
+}
+
+static bool SetupTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Framebuffer& framebuffer, TiledRasterizer::Setup& s) {
+    s.minX = 0, s.maxX = -1, s.minY = 0, s.maxY = -1;
+
+    const float limit = TiledRasterizer::coordinateLimit;
+    const Vector4* v[3] = { &v0, &v1, &v2 };
+    for (const Vector4* p : v) {
+        if (!(std::fabs(p->x) <= limit && std::fabs(p->y) <= limit)) return false;
+    }
+
+    int64_t x[3] = { Snap(v0.x), Snap(v1.x), Snap(v2.x) };
+    int64_t y[3] = { Snap(v0.y), Snap(v1.y), Snap(v2.y) };
+    int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0) return false;
+    if (area < 0) {
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(v[1], v[2]);
+        area = -area;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        const int j = (i + 1) % 3;
+        const int64_t a = y[i] - y[j];
+        const int64_t b = x[j] - x[i];
+        // Top-left rule: samples exactly on other edges are outside.
+        const bool topLeft = a > 0 || (a == 0 && b > 0);
+        s.a[i] = static_cast<int32_t>(a);
+        s.b[i] = static_cast<int32_t>(b);
+        s.c[i] = x[i] * y[j] - y[i] * x[j] - (topLeft ? 0 : 1);
+    }
+
+    // Bounding box of pixels whose centers may be covered.
+    const int64_t minX = std::min({ x[0], x[1], x[2] }), maxX = std::max({ x[0], x[1], x[2] });
+    const int64_t minY = std::min({ y[0], y[1], y[2] }), maxY = std::max({ y[0], y[1], y[2] });
+    s.minX = std::max<int64_t>(0, (minX - subpixel / 2) >> subpixelBits);
+    s.minY = std::max<int64_t>(0, (minY - subpixel / 2) >> subpixelBits);
+    s.maxX = std::min<int64_t>(framebuffer.width - 1, (maxX - subpixel / 2) >> subpixelBits);
+    s.maxY = std::min<int64_t>(framebuffer.height - 1, (maxY - subpixel / 2) >> subpixelBits);
+
+    const Vector4& p0 = *v[0];
+    const Vector4& p1 = *v[1];
+    const Vector4& p2 = *v[2];
+    const float planeArea = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+    if (planeArea == 0.0f) {
+        s.dzdx = s.dzdy = 0.0f;
+        s.zOrigin = p0.z;
+    } else {
+        s.dzdx = ((p1.z - p0.z) * (p2.y - p0.y) - (p2.z - p0.z) * (p1.y - p0.y)) / planeArea;
+        s.dzdy = ((p2.z - p0.z) * (p1.x - p0.x) - (p1.z - p0.z) * (p2.x - p0.x)) / planeArea;
+        s.zOrigin = p0.z - p0.x * s.dzdx - p0.y * s.dzdy;
+    }
+    return s.minX <= s.maxX && s.minY <= s.maxY;
+}
+
+static inline int64_t EdgeAt(const TiledRasterizer::Setup& s, int edge, int x, int y) {
+    return s.a[edge] * (int64_t(x) * subpixel + subpixel / 2) + s.b[edge] * (int64_t(y) * subpixel + subpixel / 2) + s.c[edge];
+}
+
+// Block covers pixels [x0, x0 + 8) x [y0, y0 + 8) clipped to xEnd, yEnd. partial[e] is the edge value at
+// the center of pixel (x0, y0) for edges crossing the block, or INT32_MIN for edges accepting the whole block.
+static size_t ShadeBlockScalar(const Framebuffer& framebuffer, const TiledRasterizer::Setup& s, int x0, int y0, int xEnd, int yEnd, const int32_t partial[3], uint32_t color) {
+    size_t written = 0;
+    for (int y = y0; y < yEnd; y++) {
+        uint32_t* colorRow = framebuffer.color + static_cast<size_t>(y) * framebuffer.pitch;
+        float* depthRow = framebuffer.depth ? framebuffer.depth + static_cast<size_t>(y) * framebuffer.pitch : nullptr;
+        const float zRow = s.zOrigin + (y + 0.5f) * s.dzdy;
+        for (int x = x0; x < xEnd; x++) {
+            bool inside = true;
+            for (int e = 0; e < 3; e++) {
+                if (partial[e] == INT32_MIN) continue;
+                const int32_t value = partial[e] + s.a[e] * subpixel * (x - x0) + s.b[e] * subpixel * (y - y0);
+                inside &= value >= 0;
+            }
+            if (!inside) continue;
+
+            const float z = zRow + (x + 0.5f) * s.dzdx;
+            if (depthRow) {
+                if (!(z < depthRow[x])) continue;
+                depthRow[x] = z;
+            }
+            colorRow[x] = color;
+            written++;
+        }
+    }
+    return written;
+}
+
+#if W_ENGINE_X86
+W_ENGINE_TARGET("avx2")
+static size_t ShadeBlockAVX2(const Framebuffer& framebuffer, const TiledRasterizer::Setup& s, int x0, int y0, int xEnd, int yEnd, const int32_t partial[3], uint32_t color) {
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i columns = _mm256_cmpgt_epi32(_mm256_set1_epi32(xEnd - x0), lane);
+    const __m256 laneCenters = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(lane, _mm256_set1_epi32(x0))), _mm256_set1_ps(0.5f));
+    const __m256 zColumns = _mm256_mul_ps(laneCenters, _mm256_set1_ps(s.dzdx));
+    const __m256i colorLanes = _mm256_set1_epi32(static_cast<int32_t>(color));
+
+    __m256i edgeRow[3];
+    __m256i edgeRowStep[3];
+    for (int e = 0; e < 3; e++) {
+        if (partial[e] == INT32_MIN) continue;
+        edgeRow[e] = _mm256_add_epi32(_mm256_set1_epi32(partial[e]), _mm256_mullo_epi32(lane, _mm256_set1_epi32(s.a[e] * subpixel)));
+        edgeRowStep[e] = _mm256_set1_epi32(s.b[e] * subpixel);
+    }
+
+    size_t written = 0;
+    for (int y = y0; y < yEnd; y++) {
+        __m256i mask = columns;
+        for (int e = 0; e < 3; e++) {
+            if (partial[e] == INT32_MIN) continue;
+            mask = _mm256_and_si256(mask, _mm256_cmpgt_epi32(edgeRow[e], _mm256_set1_epi32(-1)));
+            edgeRow[e] = _mm256_add_epi32(edgeRow[e], edgeRowStep[e]);
+        }
+        if (_mm256_testz_si256(mask, mask)) continue;
+
+        const size_t row = static_cast<size_t>(y) * framebuffer.pitch + x0;
+        if (framebuffer.depth) {
+            const __m256 z = _mm256_add_ps(zColumns, _mm256_set1_ps(s.zOrigin + (y + 0.5f) * s.dzdy));
+            const __m256 stored = _mm256_maskload_ps(framebuffer.depth + row, mask);
+            mask = _mm256_and_si256(mask, _mm256_castps_si256(_mm256_cmp_ps(z, stored, _CMP_LT_OQ)));
+            _mm256_maskstore_ps(framebuffer.depth + row, mask, z);
+        }
+        _mm256_maskstore_epi32(reinterpret_cast<int*>(framebuffer.color + row), mask, colorLanes);
+        written += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    }
+    return written;
+}
+#endif
+
+static size_t RasterizeInTile(const Framebuffer& framebuffer, const TiledRasterizer::Setup& s, int tileX, int tileY, uint32_t color, bool avx2) {
+    const int bs = TiledRasterizer::blockSize;
+    const int xBegin = std::max(s.minX, tileX) / bs * bs;
+    const int yBegin = std::max(s.minY, tileY) / bs * bs;
+    const int xLast = std::min(s.maxX, std::min(tileX + TiledRasterizer::tileSize, framebuffer.width) - 1);
+    const int yLast = std::min(s.maxY, std::min(tileY + TiledRasterizer::tileSize, framebuffer.height) - 1);
+
+    size_t written = 0;
+    for (int y0 = yBegin; y0 <= yLast; y0 += bs) {
+        const int yEnd = std::min(y0 + bs, yLast + 1);
+        for (int x0 = xBegin; x0 <= xLast; x0 += bs) {
+            const int xEnd = std::min(x0 + bs, xLast + 1);
+
+            int32_t partial[3];
+            bool rejected = false;
+            for (int e = 0; e < 3 && !rejected; e++) {
+                const int64_t corners[4] = {
+                    EdgeAt(s, e, x0, y0), EdgeAt(s, e, xEnd - 1, y0),
+                    EdgeAt(s, e, x0, yEnd - 1), EdgeAt(s, e, xEnd - 1, yEnd - 1)
+                };
+                const int64_t low = std::min({ corners[0], corners[1], corners[2], corners[3] });
+                const int64_t high = std::max({ corners[0], corners[1], corners[2], corners[3] });
+                if (high < 0) {
+                    rejected = true;
+                } else if (low >= 0) {
+                    partial[e] = INT32_MIN;
+                } else {
+                    // The edge crosses the block, so its values here are bounded by gradient times block diagonal.
+                    partial[e] = static_cast<int32_t>(corners[0]);
+                }
+            }
+            if (rejected) continue;
+
+#if W_ENGINE_X86
+            if (avx2) {
+                written += ShadeBlockAVX2(framebuffer, s, x0, y0, xEnd, yEnd, partial, color);
+                continue;
+            }
+#endif
+            written += ShadeBlockScalar(framebuffer, s, x0, y0, xEnd, yEnd, partial, color);
+        }
+    }
+    return written;
+}
+
+TiledRasterizer::TiledRasterizer(ThreadPool& pool): pool(pool) {}
+
+size_t TiledRasterizer::DrawTriangles(Framebuffer& framebuffer, const Vector4* vertices, const uint32_t* indices, size_t triangleCount, uint32_t color) {
+    if (triangleCount == 0 || framebuffer.width <= 0 || framebuffer.height <= 0) return 0;
+
+    const int tilesX = (framebuffer.width + tileSize - 1) / tileSize;
+    const int tilesY = (framebuffer.height + tileSize - 1) / tileSize;
+    const size_t tiles = static_cast<size_t>(tilesX) * tilesY;
+    const size_t chunks = std::min(pool.Size(), triangleCount);
+
+    setups.resize(triangleCount);
+    bins.resize(chunks);
+    for (std::vector<std::vector<uint32_t>>& chunkBins : bins) {
+        chunkBins.resize(tiles);
+        for (std::vector<uint32_t>& bin : chunkBins) bin.clear();
+    }
+
+    pool.Run(chunks, [&](size_t chunk, size_t) {
+        const size_t begin = triangleCount * chunk / chunks;
+        const size_t end = triangleCount * (chunk + 1) / chunks;
+        for (size_t i = begin; i < end; i++) {
+            Setup& s = setups[i];
+            if (!SetupTriangle(vertices[indices[3 * i]], vertices[indices[3 * i + 1]], vertices[indices[3 * i + 2]], framebuffer, s)) continue;
+
+            for (int ty = s.minY / tileSize; ty <= s.maxY / tileSize; ty++) {
+                for (int tx = s.minX / tileSize; tx <= s.maxX / tileSize; tx++) {
+                    bins[chunk][static_cast<size_t>(ty) * tilesX + tx].push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    });
+
+    const bool avx2 = SIMD::Current() >= SIMD::Level::AVX2;
+    std::atomic<size_t> written{0};
+    pool.Run(tiles, [&](size_t tile, size_t) {
+        const int tileX = static_cast<int>(tile % tilesX) * tileSize;
+        const int tileY = static_cast<int>(tile / tilesX) * tileSize;
+        size_t local = 0;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (uint32_t i : bins[chunk][tile]) {
+                local += RasterizeInTile(framebuffer, setups[i], tileX, tileY, color, avx2);
+            }
+        }
+        written += local;
+    });
+    return written;
+}
@@ -0,0 +1,152 @@
+#include "../include/transformhierarchy.h"
+#include <cstring>
+#include <algorithm>
+
+TransformHierarchy::Node TransformHierarchy::AddNode(Node parent, const Vector4& translation, const Quaternion& rotation, const Vector4& scale) {
+    const uint32_t slot = static_cast<uint32_t>(parents.size());
+    // Appending keeps every parent before its children, Update only needs the breadth-first sort for locality.
+    parents.push_back(parent == none ? none : slots[parent]);
+    translations.push_back(translation);
+    rotations.push_back(rotation);
+    scales.push_back(scale);
+    worlds.push_back(Matrix4());
+    dirty.push_back(0);
+
+    const Node node = static_cast<Node>(nodes.size());
+    slots.push_back(slot);
+    nodes.push_back(node);
+
+    MarkDirty(slot);
+    unsorted = true;
+    return node;
+}
+
+size_t TransformHierarchy::Size() const {
+    return parents.size();
+}
+
+void TransformHierarchy::SetTranslation(Node node, const Vector4& translation) {
+    translations[slots[node]] = translation;
+    MarkDirty(slots[node]);
+}
+
+void TransformHierarchy::SetRotation(Node node, const Quaternion& rotation) {
+    rotations[slots[node]] = rotation;
+    MarkDirty(slots[node]);
+}
+
+void TransformHierarchy::SetScale(Node node, const Vector4& scale) {
+    scales[slots[node]] = scale;
+    MarkDirty(slots[node]);
+}
+
+TransformHierarchy::Node TransformHierarchy::Parent(Node node) const {
+    const uint32_t parent = parents[slots[node]];
+    return parent == none ? none : nodes[parent];
+}
+
+static Matrix4 ComposeTRS(const Vector4& t, const Quaternion& q, const Vector4& s) {
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    return Matrix4(
+        (1 - 2 * (yy + zz)) * s.x, 2 * (xy - wz) * s.y,       2 * (xz + wy) * s.z,       t.x,
+        2 * (xy + wz) * s.x,       (1 - 2 * (xx + zz)) * s.y, 2 * (yz - wx) * s.z,       t.y,
+        2 * (xz - wy) * s.x,       2 * (yz + wx) * s.y,       (1 - 2 * (xx + yy)) * s.z, t.z,
+        0,                         0,                         0,                         1
+    );
+}
+
+Matrix4 TransformHierarchy::Local(Node node) const {
+    const uint32_t slot = slots[node];
+    return ComposeTRS(translations[slot], rotations[slot], scales[slot]);
+}
+
+const Matrix4& TransformHierarchy::World(Node node) const {
+    return worlds[slots[node]];
+}
+
+size_t TransformHierarchy::Update() {
+    if (unsorted) SortBreadthFirst();
+
+    const size_t count = parents.size();
+    size_t updated = 0;
+    for (size_t i = firstDirty; i < count; i++) {
+        const uint32_t parent = parents[i];
+        if (!dirty[i] && (parent == none || !dirty[parent])) continue;
+
+        const Matrix4 local = ComposeTRS(translations[i], rotations[i], scales[i]);
+        worlds[i] = parent == none ? local : worlds[parent].MultiplyMatrix(local);
+        dirty[i] = 1;
+        updated++;
+    }
+
+    if (firstDirty < count) {
+        std::memset(dirty.data() + firstDirty, 0, count - firstDirty);
+    }
+    firstDirty = count;
+    return updated;
+}
+
+void TransformHierarchy::MarkDirty(uint32_t slot) {
+    dirty[slot] = 1;
+    firstDirty = std::min<size_t>(firstDirty, slot);
+}
+
+void TransformHierarchy::SortBreadthFirst() {
+    const size_t count = parents.size();
+
+    // Children of every slot as a compressed adjacency list.
+    std::vector<uint32_t> offsets(count + 1, 0);
+    for (size_t i = 0; i < count; i++) {
+        if (parents[i] != none) offsets[parents[i] + 1]++;
+    }
+    for (size_t i = 0; i < count; i++) offsets[i + 1] += offsets[i];
+    std::vector<uint32_t> children(offsets[count]);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < count; i++) {
+        if (parents[i] != none) children[cursor[parents[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (parents[i] == none) order.push_back(static_cast<uint32_t>(i));
+    }
+    for (size_t head = 0; head < order.size(); head++) {
+        const uint32_t slot = order[head];
+        order.insert(order.end(), children.begin() + offsets[slot], children.begin() + offsets[slot + 1]);
+    }
+
+    std::vector<uint32_t> newSlot(count);
+    for (size_t i = 0; i < count; i++) newSlot[order[i]] = static_cast<uint32_t>(i);
+
+    std::vector<uint32_t> sortedParents(count);
+    std::vector<Vector4> sortedTranslations(count), sortedScales(count);
+    std::vector<Quaternion> sortedRotations(count);
+    std::vector<Matrix4> sortedWorlds(count);
+    std::vector<uint8_t> sortedDirty(count);
+    std::vector<Node> sortedNodes(count);
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t old = order[i];
+        sortedParents[i] = parents[old] == none ? none : newSlot[parents[old]];
+        sortedTranslations[i] = translations[old];
+        sortedRotations[i] = rotations[old];
+        sortedScales[i] = scales[old];
+        sortedWorlds[i] = worlds[old];
+        sortedDirty[i] = dirty[old];
+        sortedNodes[i] = nodes[old];
+        slots[nodes[old]] = static_cast<uint32_t>(i);
+    }
+
+    parents.swap(sortedParents);
+    translations.swap(sortedTranslations);
+    rotations.swap(sortedRotations);
+    scales.swap(sortedScales);
+    worlds.swap(sortedWorlds);
+    dirty.swap(sortedDirty);
+    nodes.swap(sortedNodes);
+
+    firstDirty = 0;
+    unsorted = false;
+}
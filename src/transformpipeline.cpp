@@ -0,0 +1,72 @@
+#include "../include/transformpipeline.h"
+#include "../include/threadpool.h"
+#include "../include/vector4stream.h"
+#include "../include/vector4.h"
+#include "../include/matrix4.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+TransformPipeline::TransformPipeline(ThreadPool& pool, size_t chunkSize):
+    pool(pool), chunkSize((chunkSize + 15) / 16 * 16), stats(pool.Size()) {
+    if (this->chunkSize == 0) this->chunkSize = 16;
+}
+
+void TransformPipeline::Transform(const Matrix4& m, const Vector4Stream& in, Vector4Stream& out) {
+    if (out.count < in.count) {
+        throw std::out_of_range("TransformPipeline output stream is shorter than the input.");
+    }
+
+    const size_t count = in.count;
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    pool.Run(chunks, [&](size_t chunk, size_t worker) {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t begin = chunk * chunkSize;
+        const size_t size = begin + chunkSize < count ? chunkSize : count - begin;
+
+        Vector4Stream target = out.Slice(begin, size);
+        m.TransformStream(in.Slice(begin, size), target, size);
+
+        WorkerStats& s = stats[worker];
+        s.chunks++;
+        s.vectors += size;
+        s.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    });
+}
+
+void TransformPipeline::Transform(const Matrix4& m, const Vector4* in, Vector4* out, size_t count, Convention convention) {
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    pool.Run(chunks, [&](size_t chunk, size_t worker) {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t begin = chunk * chunkSize;
+        const size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+
+        if (convention == Convention::ColumnVector) {
+            for (size_t i = begin; i < end; i++) out[i] = m.MultiplyVector(in[i]);
+        } else {
+            for (size_t i = begin; i < end; i++) out[i] = in[i].MultiplyMatrix(m);
+        }
+
+        WorkerStats& s = stats[worker];
+        s.chunks++;
+        s.vectors += end - begin;
+        s.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    });
+}
+
+const std::vector<TransformPipeline::WorkerStats>& TransformPipeline::Stats() const {
+    return stats;
+}
+
+void TransformPipeline::ResetStats() {
+    stats.assign(pool.Size(), WorkerStats());
+}
+
+void TransformPipeline::PrintStats(const int& precision) const {
+    for (size_t worker = 0; worker < stats.size(); worker++) {
+        const WorkerStats& s = stats[worker];
+        std::cout << std::fixed << std::setprecision(precision) << "Worker " << worker << ": chunks: " << s.chunks << " vectors: " << s.vectors
+                  << " seconds: " << s.seconds << " Mvectors/s: " << s.VectorsPerSecond() * 1e-6 << std::endl;
+    }
+}
@@ -1,85 +1,19 @@
 #include "../include/vector3.h"
+#include <type_traits>
 
-void Vector3::Print() {
+void Vector3::Print() const {
     std::cout << "Vector3(x: " << x << " y: " << y << " z: " << z << ")" << std::endl;
 }
 
-Vector3 Vector3::Clone() const {
-    return Vector3(x, y, z);
-}
-
-bool Vector3::Equals(const Vector3& v) const {
-    return x == v.x && y == v.y && z == v.z;
-}
-
-Vector3& Vector3::Negate() {
-    x = -x;
-    y = -y;
-    z = -z;
-    return *this;
-}
-
-float Vector3::Length() const {
-    return sqrt(x * x + y * y + z * z);
-}
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must stay three packed floats.");
 
-Vector3 Vector3::Normalize() {
-    float length = this->Length();
-    if (length == 0) {
-        return Vector3(0.0f, 0.0f, 0.0f);
-    } else {
-        return Vector3(x /= length, y /= length, z /= length);
-    }
-}
-
-Vector3 Vector3::Scale(const float& scale) const {
-    return Vector3(x * scale, y * scale, z * scale);
-}
-
-
-Vector3 Vector3::Add(const Vector3& v) {
-    return  Vector3(x + v.x, y + v.y, z + v.z);
-}
-
-Vector3 Vector3::Subtract(const Vector3& v) {
-    return Vector3(x - v.x, y - v.y, z - v.z);
-}
-
-float Vector3::Dot(const Vector3& v) {
-    return x * v.x + y * v.y + z * v.z;
-}
-
-Vector3 Vector3::Cross(const Vector3& v) {
-    return Vector3(
-        y * v.z - v.y * z,
-      -(z * v.x - v.z * x),
-        x * v.y - v.x * y
-    );
-}
-
-float Vector3::Project(const Vector3& v) {
-    float length = v.Length();
-    if (length == 0) {
-        return 0.0f;
-    } else {
-        return this->Dot(v) / length;
-    }
-}
-
-float Vector3::Angle(const Vector3& v, bool degrees) {
-    const float lengths = this->Length() * v.Length();
-    if (lengths == 0) {
-        return 0.0f;
-    } else {
-        const float angle = this->Dot(v) / lengths;
-        if (degrees) {
-            return acos(angle) * radDeg;
-        } else {
-            return acos(angle);
-        }
-    }
-}
-
-Vector3 Vector3::Reflect(const Vector3& normal) {
-    return this->Subtract(normal.Scale(2 * this->Dot(normal)));
-}
+// Compile-time checks of the constexpr arithmetic.
+static_assert(Vector3(1, 2, 3).Add(Vector3(4, 5, 6)).Equals(Vector3(5, 7, 9)), "Vector3::Add");
+static_assert(Vector3(1, 0, 0).Cross(Vector3(0, 1, 0)).Equals(Vector3(0, 0, 1)), "Vector3::Cross must be right-handed.");
+static_assert(Vector3(0, 0, 1).Cross(Vector3(1, 0, 0)).Equals(Vector3(0, 1, 0)), "Vector3::Cross must be right-handed.");
+static_assert(Vector3(1, 2, 3).Cross(Vector3(4, 5, 6)).Equals(Vector3(-3, 6, -3)), "Vector3::Cross");
+static_assert(Vector3(1, 2, 3).Dot(Vector3(4, 5, 6)) == 32, "Vector3::Dot");
+static_assert(Vector3(1, -1, 0).Reflect(Vector3(0, 1, 0)).Equals(Vector3(1, 1, 0)), "Vector3::Reflect");
+static_assert(std::is_same<decltype(Vector3().Add(Vector3()).Scale(2).Cross(Vector3())), Vector3>::value,
+              "Arithmetic of Vector3 must return Vector3, so that calls such as a.Add(b).Print() chain.");
+static_assert(std::is_same<decltype(Vector3().Negate()), Vector3&>::value, "Vector3::Negate must return Vector3&.");
@@ -1,90 +1,21 @@
 #include "../include/vector4.h"
 #include "../include/matrix4.h"
+#include <type_traits>
 
-void Vector4::Print() {
+void Vector4::Print() const {
     std::cout << "Vector4(x: " << x << " y: " << y << " z: " << z << " w: " << w << ")" << std::endl;
 }
 
-Vector4 Vector4::Clone() const {
-    return Vector4(x, y, z, w);
-}
-
-bool Vector4::Equals(const Vector4& v) const {
-    return x == v.x && y == v.y && z == v.z && w == v.w;
-}
-
-Vector4& Vector4::Negate() {
-    x = -x, y = -y, z = -z, w = -w;
-    return *this;
-}
-
-float Vector4::Length() const {
-    return sqrt(x * x + y * y + z * z + w * w);
-}
-
-Vector4 Vector4::Normalize() const {
-    float length = this->Length();
-
-    if (length == 0) return Vector4(0.0f, 0.0f, 0.0f, 0.0f);
-    
-    return Vector4(x / length, y / length, z / length, w / length);
-}
-
-Vector4 Vector4::Scale(const float& scale) const {
-    return Vector4(x * scale, y * scale, z * scale, w * scale);
-}
-
-Vector4 Vector4::MultiplyMatrix(const Matrix4& m) const {
-    return Vector4(
-        x * m.m11 + y * m.m21 + z * m.m31 + w * m.m41,
-        x * m.m12 + y * m.m22 + z * m.m32 + w * m.m42,
-        x * m.m13 + y * m.m23 + z * m.m33 + w * m.m43,
-        x * m.m14 + y * m.m24 + z * m.m34 + w * m.m44
-    );
-}
-
-Vector4 Vector4::Add(const Vector4& v) const {
-    return  Vector4(x + v.x, y + v.y, z + v.z, w + v.w);
-}
-
-Vector4 Vector4::Subtract(const Vector4& v) const {
-    return Vector4(x - v.x, y - v.y, z - v.z, w - v.w);
-}
-
-float Vector4::Dot(const Vector4& v) const {
-    return x * v.x + y * v.y + z * v.z + w * v.w;
-}
-
-Vector4 Vector4::Cross(const Vector4& v) {
-    return Vector4(
-        y * v.z - v.y * z,
-      -(z * v.x - v.z * x),
-        x * v.y - v.x * y,
-        0.0f
-    );
-}
-
-float Vector4::Project(const Vector4& v) {
-    float length = v.Length();
-    if (length == 0) {
-        return 0.0f;
-    }
-    return this->Dot(v) / length;
-}
-
-float Vector4::Angle(const Vector4& v, bool degrees) {
-    const float lengths = this->Length() * v.Length();
-    if (lengths == 0) {
-        return 0.0f;
-    }
-    const float angle = this->Dot(v) / lengths;
-    if (degrees) {
-        return acos(angle) * radDeg;
-    } else {
-        return acos(angle);
-    }
-}
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 must stay four packed floats.");
 
-Vector4 Vector4::Reflect(const Vector4& normal) {
-    return this->Subtract(normal.Scale(2 * this->Dot(normal)));
-}
\ No newline at end of file
+// Compile-time checks of the constexpr arithmetic.
+static_assert(Vector4(1, 2, 3, 4).Subtract(Vector4(1, 1, 1, 1)).Equals(Vector4(0, 1, 2, 3)), "Vector4::Subtract");
+static_assert(Vector4(0, 1, 0).Cross(Vector4(0, 0, 1)).Equals(Vector4(1, 0, 0, 0)), "Vector4::Cross must be right-handed.");
+static_assert(Vector4(0, 0, 1).Cross(Vector4(1, 0, 0)).Equals(Vector4(0, 1, 0, 0)), "Vector4::Cross must be right-handed.");
+static_assert(Vector4(1, 2, 3).Cross(Vector4(4, 5, 6)).Equals(Vector4(-3, 6, -3, 0)), "Vector4::Cross");
+static_assert(Vector4(1, 2, 3, 4).Scale(0.5f).Dot(Vector4(2, 2, 2, 2)) == 10, "Vector4::Scale, Vector4::Dot");
+static_assert(Vector4(1, 2, 3, 1).MultiplyMatrix(Matrix4(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1)).Equals(Vector4(6, 8, 10, 1)),
+              "Vector4::MultiplyMatrix must use the last row as translation for row-vectors.");
+static_assert(std::is_same<decltype(Vector4().Add(Vector4()).Scale(2).Cross(Vector4())), Vector4>::value,
+              "Arithmetic of Vector4 must return Vector4, so that calls such as a.Add(b).Print() chain.");
+static_assert(std::is_same<decltype(Vector4().Negate()), Vector4&>::value, "Vector4::Negate must return Vector4&.");
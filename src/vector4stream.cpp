@@ -0,0 +1,23 @@
+#include "../include/vector4stream.h"
+#include "../include/vector4.h"
+
+Vector4Stream::Vector4Stream(size_t count): SoA4Storage(count) {}
+
+Vector4Stream Vector4Stream::View(float* x, float* y, float* z, float* w, size_t count) {
+    Vector4Stream stream;
+    stream.x = x, stream.y = y, stream.z = z, stream.w = w;
+    stream.count = count;
+    return stream;
+}
+
+Vector4Stream Vector4Stream::Slice(size_t offset, size_t count) const {
+    return View(x + offset, y + offset, z + offset, w + offset, count);
+}
+
+Vector4 Vector4Stream::Get(size_t i) const {
+    return Vector4(x[i], y[i], z[i], w[i]);
+}
+
+void Vector4Stream::Set(size_t i, const Vector4& v) {
+    x[i] = v.x, y[i] = v.y, z[i] = v.z, w[i] = v.w;
+}
@@ -0,0 +1,124 @@
+#include "bvh.h"
+#include "vector3.h"
+#include "threadpool.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+
+// Ray queries of BVH against brute force over all triangles, with axis-parallel rays whose origins lie on the faces
+// of the node boxes. Returns non-zero when any check fails, which is what CTest looks at.
+
+static int failures = 0;
+
+static void Check(bool passed, const std::string& what) {
+    if (passed) return;
+    failures++;
+    std::cerr << "FAILED " << what << std::endl;
+}
+
+static const float infinity = std::numeric_limits<float>::infinity();
+
+// Quad grid in the y = height(x, z) surface with vertices at integer x and z, two triangles per quad.
+struct Grid {
+    std::vector<Vector3> vertices;
+    std::vector<uint32_t> indices;
+
+    Grid(size_t size, float (*height)(float, float)) {
+        for (size_t z = 0; z <= size; z++) {
+            for (size_t x = 0; x <= size; x++) vertices.push_back(Vector3(float(x), height(float(x), float(z)), float(z)));
+        }
+        for (size_t z = 0; z < size; z++) {
+            for (size_t x = 0; x < size; x++) {
+                const uint32_t i = static_cast<uint32_t>(z * (size + 1) + x), j = i + static_cast<uint32_t>(size + 1);
+                indices.insert(indices.end(), { i, j, i + 1, i + 1, j, j + 1 });
+            }
+        }
+    }
+
+    size_t TriangleCount() const { return indices.size() / 3; }
+
+    // Closest hit and amount of hit triangles by testing every triangle.
+    size_t BruteForce(const Vector3& origin, const Vector3& direction, float& closest) const {
+        size_t hits = 0;
+        closest = infinity;
+        for (size_t i = 0; i < TriangleCount(); i++) {
+            float t, u, v;
+            if (BVH::IntersectTriangle(origin, direction, vertices[indices[3 * i]], vertices[indices[3 * i + 1]],
+                                       vertices[indices[3 * i + 2]], infinity, t, u, v)) {
+                hits++;
+                closest = std::fmin(closest, t);
+            }
+        }
+        return hits;
+    }
+};
+
+static float Flat(float, float) { return 0.0f; }
+
+static float Rolling(float x, float z) { return std::sin(0.7f * x) * std::cos(0.5f * z); }
+
+static void TestIntersectBox() {
+    const Vector3 min(0, 0, 0), max(1, 1, 1);
+    float tNear = -1;
+    // Straight down with the origin on the x and z faces of the box.
+    for (float x : { 0.0f, 1.0f }) {
+        for (float z : { 0.0f, 0.5f, 1.0f }) {
+            const bool hit = BVH::IntersectBox(Vector3(x, 5, z), Vector3(infinity, -1, infinity), min, max, infinity, tNear);
+            Check(hit && tNear == 4, "IntersectBox with the origin on a face of a parallel slab");
+        }
+    }
+    Check(BVH::IntersectBox(Vector3(0.5f, 5, 0), Vector3(-infinity, -1, -infinity), min, max, 10, tNear) && tNear == 4,
+          "IntersectBox with -0 direction components");
+    Check(!BVH::IntersectBox(Vector3(1.0001f, 5, 0.5f), Vector3(infinity, -1, infinity), min, max, infinity, tNear),
+          "IntersectBox outside a parallel slab");
+    Check(!BVH::IntersectBox(Vector3(0.5f, 5, -0.0001f), Vector3(infinity, -1, infinity), min, max, infinity, tNear),
+          "IntersectBox outside a parallel slab");
+    Check(!BVH::IntersectBox(Vector3(0.5f, 5, 0.5f), Vector3(infinity, -1, infinity), min, max, 3.9f, tNear),
+          "IntersectBox beyond tMax");
+    // A flat box, as the leaves of a flat mesh are, with the origin in its plane.
+    Check(BVH::IntersectBox(Vector3(0, 0, 0.5f), Vector3(1, infinity, infinity), Vector3(0, 0, 0), Vector3(1, 0, 1), infinity, tNear),
+          "IntersectBox along a flat box");
+}
+
+// Vertical rays at every grid vertex and quad center, the case of picking straight down at integer coordinates.
+static void TestVerticalRays(const char* name, size_t size, float (*height)(float, float), size_t maxLeafSize) {
+    ThreadPool pool(2);
+    const Grid grid(size, height);
+    BVH bvh(pool);
+    bvh.Build(grid.vertices.data(), grid.vertices.size(), grid.indices.data(), grid.TriangleCount(), maxLeafSize);
+
+    for (size_t step = 0; step <= 4 * size + 4; step++) {
+        for (size_t k = 0; k <= 4 * size + 4; k++) {
+            const float x = 0.5f * step - 1, z = 0.5f * k - 1;
+            for (float dy : { -1.0f, 1.0f }) {
+                const Vector3 origin(x, dy < 0 ? 5.0f : -5.0f, z), direction(0, dy, 0);
+                float closest;
+                const bool expected = grid.BruteForce(origin, direction, closest) != 0;
+                BVH::Hit hit;
+                const bool found = bvh.Intersect(origin, direction, hit);
+                const std::string what = std::string(name) + " ray at (" + std::to_string(x) + ", " + std::to_string(z) + ")";
+                Check(found == expected, what + ": Intersect disagrees with brute force");
+                Check(!found || hit.t == closest, what + ": Intersect does not return the closest hit");
+                Check(bvh.Occluded(origin, direction) == expected, what + ": Occluded disagrees with brute force");
+            }
+        }
+    }
+}
+
+int main() {
+    TestIntersectBox();
+    TestVerticalRays("flat 2 x 2", 2, Flat, 1);
+    TestVerticalRays("flat 2 x 2", 2, Flat, 4);
+    TestVerticalRays("rolling 16 x 16", 16, Rolling, 1);
+    TestVerticalRays("rolling 16 x 16", 16, Rolling, 4);
+    if (failures != 0) {
+        std::cerr << failures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All BVH checks passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include "euler.h"
+#include "eulerangles.h"
+#include "matrix4.h"
+#include "quaternion.h"
+#include "quaternionstream.h"
+#include "simd.h"
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+
+// Euler angles in all six orders: composition against the product of the single-axis rotations, round trips through
+// matrix and quaternion decomposition, gimbal lock, and the batch conversions at every SIMD level. Returns non-zero
+// when any check fails, which is what CTest looks at.
+
+static int failures = 0;
+
+static void Check(bool passed, const std::string& what, const char* order, double error, double tolerance) {
+    if (passed) return;
+    failures++;
+    std::cerr << "FAILED " << what << " " << order << ": error " << error << " > " << tolerance << std::endl;
+}
+
+// Deterministic angles, the same on every run and platform.
+class Random {
+public:
+    explicit Random(uint32_t seed): state(seed) {}
+
+    float Uniform(float min, float max) {
+        state = state * 1664525u + 1013904223u;
+        return min + (max - min) * static_cast<float>(state >> 8) / 16777216.0f;
+    }
+
+private:
+    uint32_t state;
+};
+
+static double MaxDifference(const Matrix4& a, const Matrix4& b) {
+    double error = 0.0;
+    for (size_t r = 0; r < 3; r++) {
+        for (size_t c = 0; c < 3; c++) error = std::fmax(error, std::fabs(a.Element(r, c) - b.Element(r, c)));
+    }
+    return error;
+}
+
+// Difference of two angles modulo 2 pi, alpha and gamma of +pi and -pi are the same rotation.
+static double AngleDifference(float a, float b) {
+    return std::fabs(std::remainder(static_cast<double>(a) - b, 2.0 * M_PI));
+}
+
+static const float pi = static_cast<float>(M_PI);
+
+// Rotation about one axis from the single-axis matrices of Euler, which do not share any code with EulerAngles.
+static Matrix4 AxisRotation(int axis, float angle) {
+    switch (axis) {
+        case 0: return Euler(angle, 0, 0).RotateX();
+        case 1: return Euler(0, angle, 0).RotateY();
+        default: return Euler(0, 0, angle).RotateZ();
+    }
+}
+
+// Alpha rotates about the first axis of the order, beta about the second and gamma about the third. The axes are read
+// from the name of the order, not from the tables of EulerAngles.
+static void TestReference(Euler::Order order) {
+    const std::string name = Euler::OrderToString(order);
+    const int first = name[0] - 'X', second = name[1] - 'X', third = name[2] - 'X';
+    Random random(2024);
+    double matrixError = 0.0, quaternionError = 0.0;
+    for (int n = 0; n < 20000; n++) {
+        const float alpha = random.Uniform(-pi, pi), beta = random.Uniform(-pi, pi), gamma = random.Uniform(-pi, pi);
+        const Matrix4 reference = AxisRotation(first, alpha).MultiplyMatrix(AxisRotation(second, beta)).MultiplyMatrix(AxisRotation(third, gamma));
+        const Euler e(alpha, beta, gamma, order);
+        matrixError = std::fmax(matrixError, MaxDifference(e.RotateXYZ(), reference));
+        // ToRotationMatrix is laid out for row-vectors.
+        quaternionError = std::fmax(quaternionError, MaxDifference(e.ToQuaternion().ToRotationMatrix().Transpose(), reference));
+    }
+    Check(matrixError <= 5e-7, "ToMatrix vs product of RotateX, RotateY, RotateZ", name.c_str(), matrixError, 5e-7);
+    Check(quaternionError <= 1e-6, "ToQuaternion vs product of RotateX, RotateY, RotateZ", name.c_str(), quaternionError, 1e-6);
+}
+
+// Decomposes and recomposes, so the check does not depend on which of the equivalent angle triples comes back.
+template <Euler::Order O>
+static void TestRoundTrip(const char* name) {
+    Random random(12345);
+    double matrixError[2] = {}, quaternionError[2] = {};
+    for (int n = 0; n < 20000; n++) {
+        const EulerAngles<O> e(random.Uniform(-pi, pi), random.Uniform(-1.5f, 1.5f), random.Uniform(-pi, pi));
+        const Matrix4 m = e.ToMatrix();
+        const size_t range = std::fabs(e.beta) < 1.2f ? 0 : 1;
+        matrixError[range] = std::fmax(matrixError[range], MaxDifference(EulerAngles<O>::FromMatrix(m).ToMatrix(), m));
+        quaternionError[range] = std::fmax(quaternionError[range],
+                                           MaxDifference(EulerAngles<O>::FromQuaternion(e.ToQuaternion()).ToMatrix(), m));
+    }
+    Check(matrixError[0] <= 8e-7, "ToMatrix -> FromMatrix, |beta| < 1.2,", name, matrixError[0], 8e-7);
+    Check(matrixError[1] <= 2.5e-6, "ToMatrix -> FromMatrix, |beta| < 1.5,", name, matrixError[1], 2.5e-6);
+    Check(quaternionError[0] <= 8e-7, "ToQuaternion -> FromQuaternion, |beta| < 1.2,", name, quaternionError[0], 8e-7);
+    Check(quaternionError[1] <= 2.5e-6, "ToQuaternion -> FromQuaternion, |beta| < 1.5,", name, quaternionError[1], 2.5e-6);
+}
+
+// Beta of exactly +-pi / 2: the first and third axes line up and only alpha + gamma or alpha - gamma is defined.
+template <Euler::Order O>
+static void TestGimbalLock(const char* name) {
+    Random random(777);
+    double matrixError = 0.0, quaternionError = 0.0;
+    for (int n = 0; n < 2000; n++) {
+        const float beta = n % 2 == 0 ? static_cast<float>(M_PI_2) : -static_cast<float>(M_PI_2);
+        const EulerAngles<O> e(random.Uniform(-pi, pi), beta, random.Uniform(-pi, pi));
+        const Matrix4 m = e.ToMatrix();
+        const EulerAngles<O> fromMatrix = EulerAngles<O>::FromMatrix(m);
+        const EulerAngles<O> fromQuaternion = EulerAngles<O>::FromQuaternion(e.ToQuaternion());
+        Check(fromMatrix.alpha == 0 && fromMatrix.beta == beta, "FromMatrix gimbal lock branch", name, 0, 0);
+        Check(fromQuaternion.alpha == 0 && fromQuaternion.beta == beta, "FromQuaternion gimbal lock branch", name, 0, 0);
+        matrixError = std::fmax(matrixError, MaxDifference(fromMatrix.ToMatrix(), m));
+        quaternionError = std::fmax(quaternionError, MaxDifference(fromQuaternion.ToMatrix(), m));
+    }
+    Check(matrixError <= 4e-7, "ToMatrix -> FromMatrix at gimbal lock", name, matrixError, 4e-7);
+    Check(quaternionError <= 4e-7, "ToQuaternion -> FromQuaternion at gimbal lock", name, quaternionError, 4e-7);
+}
+
+// The count is not a multiple of 8, so the tail of the vector loop is covered as well.
+template <Euler::Order O>
+static void TestBatch(const char* name) {
+    const size_t count = 1003;
+    Random random(4242);
+    std::vector<Quaternion> q(count);
+    QuaternionStream stream(count);
+    for (size_t i = 0; i < count; i++) {
+        q[i] = EulerAngles<O>(random.Uniform(-pi, pi), random.Uniform(-1.5f, 1.5f), random.Uniform(-pi, pi)).ToQuaternion();
+        // Not normalized and of either sign, both are allowed.
+        if (i % 3 == 0) q[i] = q[i].Scale(i % 2 == 0 ? 1.75f : -0.5f);
+        stream.Set(i, q[i]);
+    }
+
+    std::vector<float> alpha(count), beta(count), gamma(count);
+    const SIMD::Level levels[] = { SIMD::Level::Scalar, SIMD::Level::SSE2, SIMD::Level::AVX2, SIMD::Level::FMA, SIMD::Level::AVX512 };
+    const SIMD::Level previous = SIMD::Current();
+    for (SIMD::Level level: levels) {
+        const std::string what = std::string("FromQuaternions batch vs scalar at ") + SIMD::LevelToString(SIMD::SetLevel(level));
+        for (int layout = 0; layout < 2; layout++) {
+            if (layout == 0) Euler::FromQuaternions(q.data(), O, alpha.data(), beta.data(), gamma.data(), count);
+            else Euler::FromQuaternions(stream, O, alpha.data(), beta.data(), gamma.data(), count);
+            double error = 0.0;
+            for (size_t i = 0; i < count; i++) {
+                const Euler e = Euler::FromQuaternion(q[i], O);
+                error = std::fmax(error, AngleDifference(alpha[i], e.alpha));
+                error = std::fmax(error, AngleDifference(beta[i], e.beta));
+                error = std::fmax(error, AngleDifference(gamma[i], e.gamma));
+            }
+            Check(error <= 1.8e-6, what + (layout == 0 ? " (AoS)" : " (stream)"), name, error, 1.8e-6);
+        }
+    }
+    SIMD::SetLevel(previous);
+}
+
+// Batch composition against the scalar one. The count is not a multiple of 8, the angles go beyond one turn.
+template <Euler::Order O>
+static void TestToBatch(const char* name) {
+    const size_t count = 1003;
+    Random random(99);
+    std::vector<float> alpha(count), beta(count), gamma(count);
+    for (size_t i = 0; i < count; i++) {
+        const float range = i % 10 == 0 ? 1000.0f : 2 * pi;
+        alpha[i] = random.Uniform(-range, range), beta[i] = random.Uniform(-range, range), gamma[i] = random.Uniform(-range, range);
+    }
+
+    std::vector<Matrix4> matrices(count);
+    std::vector<Quaternion> quaternions(count);
+    QuaternionStream stream(count);
+    const SIMD::Level levels[] = { SIMD::Level::Scalar, SIMD::Level::SSE2, SIMD::Level::AVX2, SIMD::Level::FMA, SIMD::Level::AVX512 };
+    const SIMD::Level previous = SIMD::Current();
+    for (SIMD::Level level: levels) {
+        const std::string at = std::string(" at ") + SIMD::LevelToString(SIMD::SetLevel(level));
+        Euler::ToMatrices(alpha.data(), beta.data(), gamma.data(), O, matrices.data(), count);
+        Euler::ToQuaternions(alpha.data(), beta.data(), gamma.data(), O, quaternions.data(), count);
+        Euler::ToQuaternions(alpha.data(), beta.data(), gamma.data(), O, stream, count);
+        double matrixError = 0.0, quaternionError = 0.0, streamError = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            const Euler e(alpha[i], beta[i], gamma[i], O);
+            matrixError = std::fmax(matrixError, MaxDifference(matrices[i], e.RotateXYZ()));
+            const Quaternion q = e.ToQuaternion();
+            quaternionError = std::fmax(quaternionError, std::fmax(std::fmax(std::fabs(quaternions[i].w - q.w), std::fabs(quaternions[i].x - q.x)),
+                                                                   std::fmax(std::fabs(quaternions[i].y - q.y), std::fabs(quaternions[i].z - q.z))));
+            streamError = std::fmax(streamError, std::fmax(std::fmax(std::fabs(stream.w[i] - q.w), std::fabs(stream.x[i] - q.x)),
+                                                           std::fmax(std::fabs(stream.y[i] - q.y), std::fabs(stream.z[i] - q.z))));
+        }
+        Check(matrixError <= 1e-6, "ToMatrices vs RotateXYZ" + at, name, matrixError, 1e-6);
+        Check(quaternionError <= 1e-6, "ToQuaternions vs ToQuaternion" + at, name, quaternionError, 1e-6);
+        Check(streamError <= 1e-6, "ToQuaternions into a stream vs ToQuaternion" + at, name, streamError, 1e-6);
+    }
+    SIMD::SetLevel(previous);
+}
+
+template <Euler::Order O>
+static void TestOrder() {
+    const std::string name = Euler::OrderToString(O);
+    TestReference(O);
+    TestToBatch<O>(name.c_str());
+    TestRoundTrip<O>(name.c_str());
+    TestGimbalLock<O>(name.c_str());
+    TestBatch<O>(name.c_str());
+}
+
+int main() {
+    TestOrder<Euler::Order::XYZ>();
+    TestOrder<Euler::Order::XZY>();
+    TestOrder<Euler::Order::YXZ>();
+    TestOrder<Euler::Order::YZX>();
+    TestOrder<Euler::Order::ZXY>();
+    TestOrder<Euler::Order::ZYX>();
+    if (failures != 0) {
+        std::cerr << failures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All Euler checks passed." << std::endl;
+    return 0;
+}